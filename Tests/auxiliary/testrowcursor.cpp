@@ -0,0 +1,175 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testrowcursor.h"
+
+#include "ksrowcursor.h"
+
+#include <QFile>
+#include <QTemporaryFile>
+#include <QTest>
+
+QString TestRowCursor::WriteFile(const QByteArray &contents)
+{
+    QTemporaryFile temp_file;
+    temp_file.setAutoRemove(false);
+    if (!temp_file.open())
+        return QString();
+    temp_file.write(contents);
+    temp_file.close();
+    file_names_.append(temp_file.fileName());
+    return temp_file.fileName();
+}
+
+void TestRowCursor::cleanupTestCase()
+{
+    for (const QString &file_name : file_names_)
+        QFile::remove(file_name);
+}
+
+void TestRowCursor::CSVHeaderAndFields()
+{
+    const QString file_name = WriteFile("\xEF\xBB\xBF"
+                                        "name,mag, type ,remarks\r\n"
+                                        "# comment line\n"
+                                        "\n"
+                                        "M 31, 3.44 ,Galaxy,\"Andromeda, \"\"the\"\" nebula\"\n"
+                                        "M 42,4.0,,\"unterminated\n"
+                                        "NGC 7000,4,Nebula,North America");
+
+    KSRowCursor cursor(file_name, '#');
+    QVERIFY(cursor.IsOpen());
+    QVERIFY(cursor.ReadHeader());
+    QCOMPARE(cursor.Header(), QStringList({ "name", "mag", "type", "remarks" }));
+
+    const int name    = cursor.Column("name");
+    const int mag     = cursor.Column("mag");
+    const int type    = cursor.Column("type");
+    const int remarks = cursor.Column("remarks");
+    QCOMPARE(cursor.Column("missing"), -1);
+
+    QVERIFY(cursor.Next());
+    QCOMPARE(cursor.FieldCount(), 4);
+    QCOMPARE(cursor.ToString(name), QString("M 31"));
+    QVERIFY(cursor.View(name) == QLatin1String("M 31"));
+    QCOMPARE(cursor.ToDouble(mag), 3.44);
+    QCOMPARE(cursor.ToString(type), QString("Galaxy"));
+    QCOMPARE(cursor.ToString(remarks), QString("Andromeda, \"the\" nebula"));
+
+    // The row with an unterminated quote is skipped
+    QVERIFY(cursor.Next());
+    QCOMPARE(cursor.ToString(name), QString("NGC 7000"));
+    QCOMPARE(cursor.ToInt(mag), 4);
+    QCOMPARE(cursor.ToString(remarks), QString("North America"));
+    QVERIFY(cursor.IsEmpty(7));
+    QCOMPARE(cursor.ToString(7), QString());
+
+    QVERIFY(!cursor.Next());
+    QVERIFY(!cursor.Next());
+}
+
+void TestRowCursor::CSVNumbers()
+{
+    const QString file_name = WriteFile("-3.141;2.5e-3;1E5;0.1;123456789012345678901234;;abc;-2147483648;2147483648\n");
+
+    KSRowCursor cursor(file_name, '#', ';');
+    QVERIFY(cursor.Next());
+    QCOMPARE(cursor.FieldCount(), 9);
+
+    bool ok = false;
+    QCOMPARE(cursor.ToDouble(0, &ok), -3.141);
+    QVERIFY(ok);
+    QCOMPARE(cursor.ToDouble(1), 2.5e-3);
+    QCOMPARE(cursor.ToDouble(2), 1e5);
+    QCOMPARE(cursor.ToDouble(3), QByteArray("0.1").toDouble());
+    QCOMPARE(cursor.ToDouble(4, &ok), 123456789012345678901234.0);
+    QVERIFY(ok);
+
+    // Empty and invalid numbers read as 0
+    QCOMPARE(cursor.ToDouble(5, &ok), 0.0);
+    QVERIFY(!ok);
+    QCOMPARE(cursor.ToDouble(6, &ok), 0.0);
+    QVERIFY(!ok);
+    QCOMPARE(cursor.ToInt(6, &ok), 0);
+    QVERIFY(!ok);
+
+    QCOMPARE(cursor.ToInt(7, &ok), -2147483647 - 1);
+    QVERIFY(ok);
+    QCOMPARE(cursor.ToInt(8, &ok), 0);
+    QVERIFY(!ok);
+}
+
+void TestRowCursor::CSVSplit()
+{
+    QByteArray contents("index,square\n");
+    for (int i = 0; i < 1000; ++i)
+        contents += QByteArray::number(i) + ',' + QByteArray::number(i * i) + '\n';
+    const QString file_name = WriteFile(contents);
+
+    KSRowCursor cursor(file_name, '#');
+    QVERIFY(cursor.ReadHeader());
+
+    const QList<KSRowCursor> parts = cursor.Split(7);
+    QVERIFY(!parts.isEmpty());
+    QVERIFY(parts.size() <= 7);
+
+    // Reading the parts in order gives every row once, in file order
+    int expected = 0;
+    for (KSRowCursor part : parts)
+    {
+        QCOMPARE(part.Column("square"), 1);
+        while (part.Next())
+        {
+            QCOMPARE(part.ToInt(0), expected);
+            QCOMPARE(part.ToInt(1), expected * expected);
+            ++expected;
+        }
+    }
+    QCOMPARE(expected, 1000);
+}
+
+void TestRowCursor::FixedWidthFields()
+{
+    const QString file_name = WriteFile("# header\n"
+                                        "ab  12  3.5  rest of line\n"
+                                        "short\n"
+                                        "cd  -7  -1.25\n");
+
+    KSRowCursor cursor(file_name, '#', QList<int>({ 4, 4, 5 }));
+    QVERIFY(cursor.Next());
+    QCOMPARE(cursor.FieldCount(), 4);
+    QCOMPARE(cursor.ToString(0), QString("ab"));
+    QCOMPARE(cursor.ToInt(1), 12);
+    QCOMPARE(cursor.ToDouble(2), 3.5);
+    QCOMPARE(cursor.ToString(3), QString("rest of line"));
+
+    // The line shorter than the widths is skipped
+    QVERIFY(cursor.Next());
+    QCOMPARE(cursor.ToString(0), QString("cd"));
+    QCOMPARE(cursor.ToInt(1), -7);
+    QCOMPARE(cursor.ToDouble(2), -1.25);
+    QVERIFY(cursor.IsEmpty(3));
+
+    QVERIFY(!cursor.Next());
+}
+
+void TestRowCursor::ReadMissingFile()
+{
+    const QString file_name = WriteFile("");
+    KSRowCursor empty(file_name, '#');
+    QVERIFY(empty.IsOpen());
+    QVERIFY(!empty.ReadHeader());
+    QVERIFY(empty.Split(4).isEmpty());
+
+    QFile::remove(file_name);
+
+    KSRowCursor missing(file_name, '#');
+    QVERIFY(!missing.IsOpen());
+    QVERIFY(!missing.Next());
+    QCOMPARE(missing.FieldCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestRowCursor)
@@ -0,0 +1,32 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+
+class TestRowCursor : public QObject
+{
+    Q_OBJECT
+  public:
+    TestRowCursor() = default;
+    ~TestRowCursor() override = default;
+
+  private slots:
+    void cleanupTestCase();
+    void CSVHeaderAndFields();
+    void CSVNumbers();
+    void CSVSplit();
+    void FixedWidthFields();
+    void ReadMissingFile();
+
+  private:
+    /** Write @p contents to a temporary file that is removed with the test */
+    QString WriteFile(const QByteArray &contents);
+
+    QStringList file_names_;
+};
@@ -11,6 +11,9 @@
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
 #include <QtGlobal>
+#include <QThreadPool>
+#include <cmath>
+#include <random>
 
 Q_DECLARE_METATYPE(FITSMode);
 
@@ -138,6 +141,130 @@ void TestFitsData::testBahtinovFocusHFR()
 #endif
 }
 
+namespace
+{
+void appendCard(QByteArray *fits, const QString &key, const QString &value)
+{
+    fits->append(QString("%1= %2").arg(key, -8).arg(value, 20).leftJustified(80, ' ').toLatin1());
+}
+
+// A 16-bit FITS image of gaussian stars on a noisy background, with stars across the tile borders.
+QByteArray syntheticField(int width, int height)
+{
+    std::mt19937 random(4535);
+    std::normal_distribution<double> noise(1000, 10);
+    QVector<double> pixels(width * height);
+    for (auto &pixel : pixels)
+        pixel = noise(random);
+
+    std::uniform_real_distribution<double> position(20, qMin(width, height) - 20);
+    std::uniform_real_distribution<double> offset(-3, 3);
+    std::uniform_real_distribution<double> peak(2000, 20000);
+    QVector<QPointF> centers;
+    for (int i = 0; i < 300; i++)
+        centers.append(QPointF(position(random) * width / qMin(width, height), position(random) * height / qMin(width,
+                               height)));
+    for (int i = 0; i < 40; i++)
+    {
+        centers.append(QPointF(width / 2 + offset(random), position(random) * height / qMin(width, height)));
+        centers.append(QPointF(position(random) * width / qMin(width, height), height / 2 + offset(random)));
+    }
+
+    constexpr double sigma = 1.5;
+    for (const auto &center : centers)
+    {
+        const double amplitude = peak(random);
+        for (int y = qMax(0, int(center.y()) - 10); y < qMin(height, int(center.y()) + 11); y++)
+            for (int x = qMax(0, int(center.x()) - 10); x < qMin(width, int(center.x()) + 11); x++)
+            {
+                const double r2 = (x - center.x()) * (x - center.x()) + (y - center.y()) * (y - center.y());
+                pixels[y * width + x] += amplitude * exp(-r2 / (2 * sigma * sigma));
+            }
+    }
+
+    QByteArray fits;
+    appendCard(&fits, "SIMPLE", "T");
+    appendCard(&fits, "BITPIX", "16");
+    appendCard(&fits, "NAXIS", "2");
+    appendCard(&fits, "NAXIS1", QString::number(width));
+    appendCard(&fits, "NAXIS2", QString::number(height));
+    appendCard(&fits, "BZERO", "32768");
+    appendCard(&fits, "BSCALE", "1");
+    fits.append(QByteArray("END").leftJustified(80, ' '));
+    fits.append(QByteArray((2880 - fits.size() % 2880) % 2880, ' '));
+    for (const double pixel : pixels)
+    {
+        const quint16 stored = static_cast<quint16>(qBound(0.0, pixel, 65535.0)) ^ 0x8000;
+        fits.append(static_cast<char>(stored >> 8));
+        fits.append(static_cast<char>(stored & 0xff));
+    }
+    fits.append(QByteArray((2880 - fits.size() % 2880) % 2880, '\0'));
+    return fits;
+}
+
+QVector<Edge> detectStars(const QByteArray &fits, bool tiled, QVector<StarRegion> *regions)
+{
+    Options::setStellarSolverTiles(tiled);
+    FITSData d(FITS_FOCUS);
+    if (!d.loadFromBuffer(fits, "fits", "tiles.fits"))
+        return QVector<Edge>();
+    d.findStars(ALGORITHM_SEP).waitForFinished();
+    QVector<Edge> stars;
+    for (const auto &star : d.getStarCenters())
+        stars.append(*star);
+    *regions = d.getStarRegions();
+    return stars;
+}
+}
+
+void TestFitsData::testTiledExtraction()
+{
+    // Tiles are only used without StellarSolver partitioning, on large images, with several threads
+    const bool partition = Options::stellarSolverPartition();
+    const bool tiles = Options::stellarSolverTiles();
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    Options::setStellarSolverPartition(false);
+    QThreadPool::globalInstance()->setMaxThreadCount(4);
+
+    const QByteArray fits = syntheticField(4096, 4096);
+    QVector<StarRegion> singleRegions, tiledRegions;
+    const QVector<Edge> single = detectStars(fits, false, &singleRegions);
+    const QVector<Edge> tiled = detectStars(fits, true, &tiledRegions);
+
+    Options::setStellarSolverPartition(partition);
+    Options::setStellarSolverTiles(tiles);
+    QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+    // The tiled extraction finds the same stars, once each
+    QVERIFY(single.size() > 300);
+    QCOMPARE(tiled.size(), single.size());
+    for (const auto &star : single)
+    {
+        int matches = 0;
+        for (const auto &other : tiled)
+        {
+            if (std::hypot(star.x - other.x, star.y - other.y) > 0.5)
+                continue;
+            matches++;
+            QVERIFY2(std::hypot(star.x - other.x, star.y - other.y) < 0.05,
+                     qPrintable(QString("Star at %1,%2 moved to %3,%4").arg(star.x).arg(star.y).arg(other.x).arg(other.y)));
+            QVERIFY(std::fabs(star.HFR - other.HFR) < 0.05);
+        }
+        QVERIFY2(matches == 1, qPrintable(QString("Star at %1,%2 found %3 times").arg(star.x).arg(star.y).arg(matches)));
+    }
+
+    // Each tile reports the statistics of its stars
+    QVERIFY(singleRegions.isEmpty());
+    QCOMPARE(tiledRegions.size(), 4);
+    int regionStars = 0;
+    for (const auto &region : tiledRegions)
+    {
+        regionStars += region.stars;
+        QVERIFY(region.HFR > 0 && region.HFR <= single.first().HFR);
+    }
+    QCOMPARE(regionStars, tiled.size());
+}
+
 void TestFitsData::initGenericDataFixture()
 {
 #if QT_VERSION < 0x050900
@@ -52,6 +52,8 @@ class TestFitsData : public QObject
         void testBahtinovFocusHFR_data();
         void testBahtinovFocusHFR();
 
+        void testTiledExtraction();
+
         void testParallelSolvers();
     private:
         void startGuideDetect(const QString &filename);
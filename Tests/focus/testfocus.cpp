@@ -30,6 +30,7 @@ class TestFocus : public QObject
         void L1PHyperbolaTest();
         void L1PParabolaTest();
         void L1PQuadraticTest();
+        void L1PNextPositionTest();
 };
 
 #include "testfocus.moc"
@@ -859,4 +860,46 @@ void TestFocus::L1PQuadraticTest()
     QCOMPARE(focuser->doneReason(), "Solution found.");
 }
 
+void TestFocus::L1PNextPositionTest()
+{
+    // The positions of the first pass of the fixed step walks do not depend on the measurements,
+    // so the focuser knows where the next measurement will send it.
+    const QVector<double> values = { 5.01, 4.0067, 2.981, 2.03, 0.996, 0.9, 1.1, 2.03, 2.987, 4.006, 5 };
+
+    for (const auto walk : { Ekos::Focus::FOCUS_WALK_FIXED_STEPS, Ekos::Focus::FOCUS_WALK_CFZ_SHUFFLE })
+    {
+        auto params = makeL1PHyperbolaParams();
+        params.focusWalk = walk;
+        std::unique_ptr<FocusAlgorithmInterface> focuser(MakeLinearFocuser(params));
+        int currentPosition = focuser->initialPosition();
+
+        int known = 0;
+        for (int i = 0; i < values.size(); i++)
+        {
+            const int nextPosition = focuser->nextPositionIfKnown();
+            const int position = focuser->newMeasurement(currentPosition, values[i], 1);
+            if (nextPosition != -1)
+            {
+                QCOMPARE(nextPosition, position);
+                known++;
+            }
+            currentPosition = position;
+        }
+        // Only the measurement ending the first pass leads to an unknown position
+        QCOMPARE(known, values.size() - 1);
+        QCOMPARE(focuser->nextPositionIfKnown(), -1);
+    }
+
+    // The classic walk decides the step size from the measurements
+    auto params = makeL1PHyperbolaParams();
+    std::unique_ptr<FocusAlgorithmInterface> focuser(MakeLinearFocuser(params));
+    QCOMPARE(focuser->nextPositionIfKnown(), -1);
+
+    // As does Linear
+    params = makeParams();
+    params.focusWalk = Ekos::Focus::FOCUS_WALK_FIXED_STEPS;
+    focuser.reset(MakeLinearFocuser(params));
+    QCOMPARE(focuser->nextPositionIfKnown(), -1);
+}
+
 QTEST_GUILESS_MAIN(TestFocus)
@@ -0,0 +1,410 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidereplay.h"
+
+#include "ekos/guide/guideview.h"
+#include "ekos/guide/internalguide/guidelog.h"
+#include "fitsviewer/fitsdata.h"
+#include "Options.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFuture>
+#include <QRect>
+#include <QVector3D>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+// Duration of the simulated calibration pulses, in milliseconds.
+constexpr int CALIBRATION_PULSE = 5000;
+// Synthetic stars are kept this far from the edges of the frame, in pixels.
+constexpr double STAR_MARGIN = 40;
+constexpr int FITS_BLOCK = 2880;
+constexpr int FITS_CARD = 80;
+
+void appendCard(QByteArray *fits, const QString &key, const QString &value)
+{
+    fits->append(QString("%1= %2").arg(key, -8).arg(value, 20).leftJustified(FITS_CARD, ' ').toLatin1());
+}
+
+void padBlock(QByteArray *fits, char fill)
+{
+    const int remainder = fits->size() % FITS_BLOCK;
+    if (remainder > 0)
+        fits->append(QByteArray(FITS_BLOCK - remainder, fill));
+}
+}  // namespace
+
+void GuideReplay::StageTime::add(double ms)
+{
+    if (ms < 0)
+        return;
+    count++;
+    sum += ms;
+    max = std::max(max, ms);
+}
+
+QString GuideReplay::Report::toString() const
+{
+    QString text = QString("%1 frames, %2 lost, drift RMS RA %3\" DEC %4\" total %5\"")
+                   .arg(frames).arg(lostFrames)
+                   .arg(raRms, 0, 'f', 2).arg(decRms, 0, 'f', 2).arg(totalRms, 0, 'f', 2);
+    if (guidedRms >= 0)
+        text += QString(", pointing RMS guided %1\" unguided %2\"")
+                .arg(guidedRms, 0, 'f', 2).arg(unguidedRms, 0, 'f', 2);
+    text += QString(", detect %1/%2 ms, drift %3/%4 ms, pulse %5/%6 ms (mean/max)")
+            .arg(detect.mean(), 0, 'f', 1).arg(detect.max, 0, 'f', 1)
+            .arg(drift.mean(), 0, 'f', 1).arg(drift.max, 0, 'f', 1)
+            .arg(pulse.mean(), 0, 'f', 1).arg(pulse.max, 0, 'f', 1);
+    if (latencyFrames > 0)
+        text += QString(", expected latency %1 s over %2 frames").arg(expectedLatency, 0, 'f', 3).arg(latencyFrames);
+    return text;
+}
+
+GuideReplay::GuideReplay() : GuideReplay(Settings())
+{
+}
+
+GuideReplay::GuideReplay(const Settings &settings) : m_Settings(settings)
+{
+    m_View.reset(new GuideView());
+}
+
+GuideReplay::~GuideReplay()
+{
+}
+
+QByteArray GuideReplay::makeFits(int width, int height, const QVector<quint16> &pixels)
+{
+    QByteArray fits;
+    fits.reserve(FITS_BLOCK + width * height * 2 + FITS_BLOCK);
+    appendCard(&fits, "SIMPLE", "T");
+    appendCard(&fits, "BITPIX", "16");
+    appendCard(&fits, "NAXIS", "2");
+    appendCard(&fits, "NAXIS1", QString::number(width));
+    appendCard(&fits, "NAXIS2", QString::number(height));
+    appendCard(&fits, "BZERO", "32768");
+    appendCard(&fits, "BSCALE", "1");
+    fits.append(QByteArray("END").leftJustified(FITS_CARD, ' '));
+    padBlock(&fits, ' ');
+
+    // Signed big endian values, offset by BZERO.
+    for (const quint16 pixel : pixels)
+    {
+        const quint16 stored = pixel ^ 0x8000;
+        fits.append(static_cast<char>(stored >> 8));
+        fits.append(static_cast<char>(stored & 0xff));
+    }
+    padBlock(&fits, '\0');
+    return fits;
+}
+
+void GuideReplay::start(int width, int height, bool restoreCalibration)
+{
+    m_Math.reset(new cgmath());
+    m_Math->setAlgorithmIndex(m_Settings.algorithm);
+
+    // The guide math runs on the simulated timeline.
+    setTime(0);
+    m_Math->getStageTimer().setClock([this]()
+    {
+        return now();
+    });
+    m_Math->getGPG().setClock([this]()
+    {
+        return std::chrono::system_clock::time_point(
+                   std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(now())));
+    });
+
+    Calibration *calibration = m_Math->getMutableCalibration();
+    if (!restoreCalibration ||
+            !calibration->restore(ISD::Mount::PIER_UNKNOWN, Options::reverseDecOnPierSideChange(), 1, 1))
+    {
+        // The calibration the simulated mount would give: RA pulses move the stars along x, DEC pulses along y.
+        const dms zero(0.0);
+        calibration->setParameters(m_Settings.pixelSize, m_Settings.pixelSize, m_Settings.focalLength, 1, 1,
+                                   ISD::Mount::PIER_EAST, zero, zero);
+        bool swapDec = false;
+        calibration->calculate2D(0, 0, m_Settings.raRate * CALIBRATION_PULSE, 0,
+                                 0, 0, 0, m_Settings.decRate * CALIBRATION_PULSE,
+                                 &swapDec, CALIBRATION_PULSE, CALIBRATION_PULSE);
+    }
+    // These pass the calibration on to the multistar guide stars.
+    m_Math->setGuiderParameters(m_Settings.pixelSize, m_Settings.pixelSize, 0, m_Settings.focalLength);
+    m_Math->setVideoParameters(width, height, 1, 1);
+    m_Math->start();
+
+    m_FirstFrame = true;
+    m_RaSquares = m_DecSquares = 0;
+    m_Measured = 0;
+
+    if (m_Log != nullptr)
+    {
+        GuideLog::GuideInfo info;
+        info.pixelScale = m_Math->getCalibration().xArcsecondsPerPixel();
+        info.focalLength = m_Settings.focalLength;
+        info.xrate = m_Settings.raRate * 1000;
+        info.yrate = m_Settings.decRate * 1000;
+        m_Log->startGuiding(info);
+    }
+}
+
+void GuideReplay::setTime(double seconds)
+{
+    m_Time = static_cast<qint64>(seconds * 1e9);
+    m_SinceTime.start();
+}
+
+qint64 GuideReplay::now() const
+{
+    return m_Time + m_SinceTime.nsecsElapsed();
+}
+
+const cproc_out_params *GuideReplay::processFrame(QSharedPointer<FITSData> &frame, double exposureStart,
+        Report *report)
+{
+    report->frames++;
+
+    // The exposure is requested, then the frame arrives after it ends and is downloaded.
+    GuideStageTimer &timer = m_Math->getStageTimer();
+    setTime(exposureStart);
+    timer.exposureStarted(m_Settings.exposure);
+    setTime(exposureStart + m_Settings.exposure + m_Settings.download);
+
+    // Select the guide star, then target it, as InternalGuider::selectAutoStar() and
+    // the first frame of InternalGuider::processGuiding() do.
+    if (m_FirstFrame)
+    {
+        const QVector3D star = m_Math->selectGuideStar(frame);
+        if (star.x() < 0 || star.y() < 0)
+        {
+            report->lostFrames++;
+            return nullptr;
+        }
+        const int size = m_Settings.trackingBoxSize;
+        m_View->setTrackingBox(QRect(static_cast<int>(star.x()) - size / 2, static_cast<int>(star.y()) - size / 2,
+                                     size, size));
+
+        const GuiderUtils::Vector position = m_Math->findLocalStarPosition(frame, m_View, true);
+        if (position.x == -1 || position.y == -1)
+        {
+            report->lostFrames++;
+            return nullptr;
+        }
+        m_Math->setTargetPosition(position.x, position.y);
+        m_FirstFrame = false;
+    }
+
+    timer.start();
+
+    const Seconds interval(m_Settings.exposure + m_Settings.delay + timer.expectedLatency());
+    m_Math->performProcessing(Ekos::GUIDE_GUIDING, frame, m_View, std::make_pair(interval, interval), m_Log);
+    timer.mark(GuideStageTimer::DRIFT_COMPUTED);
+    if (m_Math->isStarLost())
+    {
+        report->lostFrames++;
+        return nullptr;
+    }
+
+    const cproc_out_params *out = m_Math->getOutputParameters();
+    m_RaSquares += out->delta[GUIDE_RA] * out->delta[GUIDE_RA];
+    m_DecSquares += out->delta[GUIDE_DEC] * out->delta[GUIDE_DEC];
+    m_Measured++;
+    return out;
+}
+
+void GuideReplay::pulsesSent(Report *report)
+{
+    GuideStageTimer &timer = m_Math->getStageTimer();
+    timer.mark(GuideStageTimer::PULSE_SENT);
+
+    const double detected = timer.elapsedMs(GuideStageTimer::STAR_DETECTED);
+    const double computed = timer.elapsedMs(GuideStageTimer::DRIFT_COMPUTED);
+    if (detected < 0 || computed < 0)
+        return;
+    report->detect.add(detected);
+    report->drift.add(computed - detected);
+    report->pulse.add(timer.elapsedMs(GuideStageTimer::PULSE_SENT) - computed);
+}
+
+void GuideReplay::finish(Report *report)
+{
+    if (m_Measured > 0)
+    {
+        report->raRms = std::sqrt(m_RaSquares / m_Measured);
+        report->decRms = std::sqrt(m_DecSquares / m_Measured);
+        report->totalRms = std::sqrt((m_RaSquares + m_DecSquares) / m_Measured);
+    }
+
+    if (!m_Math)
+        return;
+
+    const GuideStageTimer &timer = m_Math->getStageTimer();
+    report->latencyFrames = timer.statisticsCount();
+    report->expectedLatency = timer.expectedLatency();
+    if (m_Log != nullptr)
+    {
+        if (timer.statisticsCount() > 0)
+            m_Log->latencyInfo(timer.statistics());
+        m_Log->endGuiding();
+    }
+}
+
+QSharedPointer<FITSData> GuideReplay::renderFrame(const SyntheticField &field, double offsetX, double offsetY)
+{
+    QVector<double> image(field.width * field.height, field.background);
+
+    const int radius = static_cast<int>(std::ceil(4 * field.starSigma));
+    const double twoSigmaSquared = 2 * field.starSigma * field.starSigma;
+    for (const auto &star : m_Stars)
+    {
+        const double x = star.x + offsetX;
+        const double y = star.y + offsetY;
+        const int xMin = std::max(0, static_cast<int>(x) - radius);
+        const int xMax = std::min(field.width - 1, static_cast<int>(x) + radius);
+        const int yMin = std::max(0, static_cast<int>(y) - radius);
+        const int yMax = std::min(field.height - 1, static_cast<int>(y) + radius);
+        for (int row = yMin; row <= yMax; ++row)
+        {
+            for (int column = xMin; column <= xMax; ++column)
+            {
+                const double dx = column - x;
+                const double dy = row - y;
+                image[row * field.width + column] += star.peak * std::exp(-(dx * dx + dy * dy) / twoSigmaSquared);
+            }
+        }
+    }
+
+    // Read noise, and the shot noise of the background.
+    std::normal_distribution<double> noise(0, std::sqrt(field.readNoise * field.readNoise + field.background));
+    QVector<quint16> pixels(image.size());
+    for (int i = 0; i < image.size(); ++i)
+        pixels[i] = static_cast<quint16>(std::max(0.0, std::min(65535.0, std::round(image[i] + noise(m_Random)))));
+
+    QSharedPointer<FITSData> frame(new FITSData());
+    if (!frame->loadFromBuffer(makeFits(field.width, field.height, pixels), "fits", "guide_replay.fits"))
+        qWarning() << "Guide replay: unable to load a synthetic frame";
+    return frame;
+}
+
+GuideReplay::Report GuideReplay::runSynthetic(const SyntheticField &field)
+{
+    m_Random.seed(field.seed);
+    std::uniform_real_distribution<double> xPosition(STAR_MARGIN, field.width - STAR_MARGIN);
+    std::uniform_real_distribution<double> yPosition(STAR_MARGIN, field.height - STAR_MARGIN);
+    std::uniform_real_distribution<double> peak(field.minPeak, field.maxPeak);
+    m_Stars.clear();
+    for (int i = 0; i < field.numStars; ++i)
+    {
+        Star star;
+        star.x = xPosition(m_Random);
+        star.y = yPosition(m_Random);
+        star.peak = peak(m_Random);
+        m_Stars.append(star);
+    }
+
+    start(field.width, field.height, false);
+
+    Report report;
+    std::normal_distribution<double> seeing(0, field.seeing);
+    // Position of the stars moved by the pulses, and the start position, in pixels.
+    double correctionX = 0, correctionY = 0;
+    double originX = 0, originY = 0;
+    double guidedSquares = 0, unguidedSquares = 0;
+    int samples = 0;
+    double time = 0;
+    for (int i = 0; i < m_Settings.frames; ++i)
+    {
+        // The mount error at the middle of the exposure.
+        const double middle = time + m_Settings.exposure / 2;
+        const double errorX = field.driftX * middle
+                              + field.periodicAmplitude * std::sin(2 * M_PI * middle / field.periodicPeriod);
+        const double errorY = field.driftY * middle;
+
+        QSharedPointer<FITSData> frame = renderFrame(field, errorX + correctionX + seeing(m_Random),
+                                         errorY + correctionY + seeing(m_Random));
+        const bool guiding = !m_FirstFrame;
+        const cproc_out_params *out = processFrame(frame, time, &report);
+
+        if (!m_FirstFrame)
+        {
+            if (!guiding)
+            {
+                originX = errorX;
+                originY = errorY;
+            }
+            guidedSquares += std::pow(errorX + correctionX - originX, 2) + std::pow(errorY + correctionY - originY, 2);
+            unguidedSquares += std::pow(errorX - originX, 2) + std::pow(errorY - originY, 2);
+            samples++;
+        }
+
+        // The simulated mount moves by the pulses before the next exposure.
+        if (out != nullptr)
+        {
+            const double raMove = out->pulse_length[GUIDE_RA] * m_Settings.raRate;
+            const double decMove = out->pulse_length[GUIDE_DEC] * m_Settings.decRate;
+            if (out->pulse_dir[GUIDE_RA] == RA_INC_DIR)
+                correctionX += raMove;
+            else if (out->pulse_dir[GUIDE_RA] == RA_DEC_DIR)
+                correctionX -= raMove;
+            if (out->pulse_dir[GUIDE_DEC] == DEC_INC_DIR)
+                correctionY += decMove;
+            else if (out->pulse_dir[GUIDE_DEC] == DEC_DEC_DIR)
+                correctionY -= decMove;
+            pulsesSent(&report);
+        }
+        time += m_Settings.exposure + m_Settings.delay;
+    }
+
+    finish(&report);
+    if (samples > 0)
+    {
+        const double arcsecondsPerPixel = m_Math->getCalibration().xArcsecondsPerPixel();
+        report.guidedRms = std::sqrt(guidedSquares / samples) * arcsecondsPerPixel;
+        report.unguidedRms = std::sqrt(unguidedSquares / samples) * arcsecondsPerPixel;
+    }
+    return report;
+}
+
+GuideReplay::Report GuideReplay::runFolder(const QString &folder)
+{
+    Report report;
+    const QDir dir(folder);
+    const QStringList files = dir.entryList(QStringList() << "*.fits" << "*.fit" << "*.fits.fz",
+                                            QDir::Files, QDir::Name);
+    bool started = false;
+    double time = 0;
+    for (const auto &name : files)
+    {
+        QSharedPointer<FITSData> frame(new FITSData());
+        QFuture<bool> loaded = frame->loadFromFile(dir.filePath(name));
+        loaded.waitForFinished();
+        if (!loaded.result())
+        {
+            qWarning() << "Guide replay: unable to load" << dir.filePath(name);
+            continue;
+        }
+
+        if (!started)
+        {
+            start(frame->width(), frame->height(), true);
+            started = true;
+        }
+        // The frames already contain the corrections of the session, the pulses are only computed.
+        if (processFrame(frame, time, &report) != nullptr)
+            pulsesSent(&report);
+        time += m_Settings.exposure + m_Settings.delay;
+    }
+
+    if (started)
+        finish(&report);
+    return report;
+}
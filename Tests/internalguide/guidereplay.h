@@ -0,0 +1,168 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "ekos/guide/internalguide/gmath.h"
+
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QString>
+
+#include <memory>
+#include <random>
+
+class FITSData;
+class GuideLog;
+class GuideView;
+
+// Replays guide frames through the guide math used by the internal guider: star detection
+// (single star or SEP multistar with star correspondence), drift computation and the
+// pulse computation (proportional/integral or GPG), frame after frame as when guiding.
+//
+// Frames are either synthetic star fields, rendered from a simulated mount whose pointing
+// drifts and oscillates and which moves by the pulses sent, or the FITS files of a folder,
+// e.g. the guide frames saved during a session, in which case the pulses are not applied.
+// A replay reports the time of each processing stage and the RMS of the guiding error.
+//
+// The clocks of the stage timer and of GPG follow a simulated timeline: each exposure starts
+// at its simulated time and its frame arrives download seconds after it ends. From there the
+// clocks advance in real time while the frame is processed, so that the measurement age, the
+// latency statistics and the GPG timestamps are those of a session with these timings.
+class GuideReplay
+{
+    public:
+        // Optics and loop timing.
+        struct Settings
+        {
+            int frames { 100 };
+            double exposure { 2.0 };        // seconds
+            double delay { 0.5 };           // seconds between the end of a frame and the next exposure
+            double download { 0.2 };        // seconds from the end of an exposure to its frame, within delay
+            double pixelSize { 3.8e-3 };    // mm
+            double focalLength { 400 };     // mm
+            double raRate { 0.004 };        // pixels moved per millisecond of RA pulse
+            double decRate { 0.004 };       // pixels moved per millisecond of DEC pulse
+            int algorithm { SEP_MULTISTAR };
+            int trackingBoxSize { 64 };     // pixels
+        };
+
+        // A synthetic star field and the errors of the simulated mount.
+        struct SyntheticField
+        {
+            int width { 640 };
+            int height { 480 };
+            int numStars { 20 };
+            unsigned int seed { 1 };
+            double starSigma { 1.5 };       // pixels, of the Gaussian star profile
+            double minPeak { 3000 };        // ADU above the background
+            double maxPeak { 30000 };
+            double background { 1000 };     // ADU
+            double readNoise { 20 };        // ADU
+            double seeing { 0.3 };          // pixels, RMS of the frame to frame star motion
+            double driftX { 0.05 };         // pixels per second
+            double driftY { -0.03 };
+            double periodicAmplitude { 1.5 }; // pixels, along x
+            double periodicPeriod { 120 };  // seconds
+        };
+
+        struct StageTime
+        {
+            int count { 0 };
+            double sum { 0 };
+            double max { 0 };
+
+            void add(double ms);
+            double mean() const
+            {
+                return count > 0 ? sum / count : 0;
+            }
+        };
+
+        struct Report
+        {
+            int frames { 0 };
+            int lostFrames { 0 };
+            // RMS of the drift measured by the guider, in arcseconds.
+            double raRms { 0 };
+            double decRms { 0 };
+            double totalRms { 0 };
+            // RMS of the actual pointing error relative to the first frame, in arcseconds,
+            // with and without the guide pulses. Only known for synthetic fields, -1 otherwise.
+            double guidedRms { -1 };
+            double unguidedRms { -1 };
+            // Processing time of each frame, in milliseconds.
+            StageTime detect, drift, pulse;
+            // Frames in the latency statistics of the stage timer, and the expected latency
+            // from the end of an exposure to its pulses, in seconds.
+            int latencyFrames { 0 };
+            double expectedLatency { 0 };
+
+            QString toString() const;
+        };
+
+        GuideReplay();
+        explicit GuideReplay(const Settings &settings);
+        ~GuideReplay();
+
+        // Guide data and the latency statistics are written to log, which must be enabled.
+        void setGuideLog(GuideLog *log)
+        {
+            m_Log = log;
+        }
+
+        Report runSynthetic(const SyntheticField &field);
+
+        // Replays the FITS files of folder in file name order. The calibration saved in the
+        // options is used if there is one, otherwise RA along x and DEC along y is assumed.
+        Report runFolder(const QString &folder);
+
+        // Encodes a 16 bit image, row by row, as a FITS file.
+        static QByteArray makeFits(int width, int height, const QVector<quint16> &pixels);
+
+    private:
+        // Sets up the guide math for a new replay of width x height frames.
+        void start(int width, int height, bool restoreCalibration);
+
+        // Sets the simulated time, in seconds since the start of the replay.
+        void setTime(double seconds);
+        // Nanoseconds of the simulated timeline, the clock of the guide math.
+        qint64 now() const;
+
+        // Runs one frame, whose exposure started at exposureStart seconds, through the guide loop.
+        // Returns the output of the guide math, or nullptr if the guide star was not found.
+        const cproc_out_params *processFrame(QSharedPointer<FITSData> &frame, double exposureStart, Report *report);
+
+        // Called once the pulses of a processed frame are sent, records the stage times.
+        void pulsesSent(Report *report);
+
+        QSharedPointer<FITSData> renderFrame(const SyntheticField &field, double offsetX, double offsetY);
+
+        void finish(Report *report);
+
+        Settings m_Settings;
+        std::unique_ptr<cgmath> m_Math;
+        QSharedPointer<GuideView> m_View;
+        GuideLog *m_Log { nullptr };
+        bool m_FirstFrame { true };
+
+        // The simulated time last set, in nanoseconds, and the real time since.
+        qint64 m_Time { 0 };
+        QElapsedTimer m_SinceTime;
+
+        // Synthetic field state.
+        struct Star
+        {
+            double x, y, peak;
+        };
+        QVector<Star> m_Stars;
+        std::mt19937 m_Random;
+
+        // Sums of squares for the RMS of the measured drift.
+        double m_RaSquares { 0 };
+        double m_DecSquares { 0 };
+        int m_Measured { 0 };
+};
@@ -0,0 +1,129 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidereplay.h"
+
+#include "fitsviewer/fitsdata.h"
+#include "Options.h"
+
+#include <QTest>
+
+#include <QObject>
+
+// Replays guide frames through the internal guider's guide math.
+// Set KSTARS_GUIDE_REPLAY_DIR to a folder of guide frames to also replay them, and
+// KSTARS_GUIDE_REPLAY_MAX_MS to fail when the mean processing time of a frame exceeds it.
+
+class TestGuideReplay : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestGuideReplay();
+
+        /** @short Destructor */
+        ~TestGuideReplay() override = default;
+
+    private slots:
+        void initTestCase();
+        void fitsTest();
+        void syntheticTest();
+        void syntheticGPGTest();
+        void folderTest();
+};
+
+#include "testguidereplay.moc"
+
+namespace
+{
+void checkLatency(const GuideReplay::Report &report)
+{
+    bool ok = false;
+    const double maxMs = qEnvironmentVariable("KSTARS_GUIDE_REPLAY_MAX_MS").toDouble(&ok);
+    if (!ok)
+        return;
+    const double frameMs = report.detect.mean() + report.drift.mean() + report.pulse.mean();
+    QVERIFY2(frameMs <= maxMs, QString("Frame processing took %1 ms").arg(frameMs).toLatin1());
+}
+}
+
+TestGuideReplay::TestGuideReplay() : QObject()
+{
+}
+
+void TestGuideReplay::initTestCase()
+{
+    Options::setMinDetectionsSEPMultistar(5);
+    Options::setMaxMultistarReferenceStars(10);
+}
+
+void TestGuideReplay::fitsTest()
+{
+    constexpr int width = 30, height = 20;
+    QVector<quint16> pixels(width * height);
+    for (int i = 0; i < pixels.size(); ++i)
+        pixels[i] = i * 100;
+
+    FITSData data;
+    QVERIFY(data.loadFromBuffer(GuideReplay::makeFits(width, height, pixels), "fits", "test.fits"));
+    QCOMPARE(static_cast<int>(data.width()), width);
+    QCOMPARE(static_cast<int>(data.height()), height);
+    QCOMPARE(data.getMin(), 0.0);
+    QCOMPARE(data.getMax(), (width * height - 1) * 100.0);
+}
+
+void TestGuideReplay::syntheticTest()
+{
+    Options::setGPGEnabled(false);
+    GuideReplay replay;
+    const GuideReplay::Report report = replay.runSynthetic(GuideReplay::SyntheticField());
+    qInfo() << "Synthetic replay:" << report.toString();
+
+    QCOMPARE(report.frames, 100);
+    QCOMPARE(report.lostFrames, 0);
+    QCOMPARE(report.detect.count, 100);
+    // Guiding takes out most of the drift and periodic error.
+    QVERIFY(report.unguidedRms > 0);
+    QVERIFY(report.guidedRms < report.unguidedRms / 2);
+    QVERIFY(report.totalRms > 0);
+    // Every guided frame is timed from its simulated exposure.
+    QCOMPARE(report.latencyFrames, report.frames - report.lostFrames);
+    QVERIFY(report.expectedLatency >= GuideReplay::Settings().download);
+    checkLatency(report);
+}
+
+void TestGuideReplay::syntheticGPGTest()
+{
+    Options::setGPGEnabled(true);
+    GuideReplay replay;
+    const GuideReplay::Report report = replay.runSynthetic(GuideReplay::SyntheticField());
+    Options::setGPGEnabled(false);
+    qInfo() << "Synthetic GPG replay:" << report.toString();
+
+    // GPG timestamps the measurements on the simulated timeline, which spans two periods of the periodic error.
+    QCOMPARE(report.lostFrames, 0);
+    QVERIFY(report.guidedRms < report.unguidedRms / 2);
+    QCOMPARE(report.latencyFrames, report.frames);
+    checkLatency(report);
+}
+
+void TestGuideReplay::folderTest()
+{
+    const QString folder = qEnvironmentVariable("KSTARS_GUIDE_REPLAY_DIR");
+    if (folder.isEmpty())
+        QSKIP("KSTARS_GUIDE_REPLAY_DIR is not set, skipping the replay of recorded frames.");
+
+    GuideReplay replay;
+    const GuideReplay::Report report = replay.runFolder(folder);
+    qInfo() << "Replay of" << folder << ":" << report.toString();
+
+    QVERIFY(report.frames > 0);
+    QVERIFY(report.lostFrames < report.frames);
+    checkLatency(report);
+}
+
+QTEST_MAIN(TestGuideReplay)
@@ -6,13 +6,17 @@
 
 #include "../indi/indiproperty.h"
 #include "ekos/guide/internalguide/guidestars.h"
+#include "guidereplay.h"
 
 #include <QTest>
 
 #include <QObject>
 
-// The high-level methods, selectGuideStar() and findGuideStar() are not yet tested.
-// Neither are the SEP-related EvaluateSEPStars, findTopStars, findAllSEPStars().
+#include <cmath>
+#include <random>
+
+// The high-level methods, selectGuideStar() and findGuideStar() are only tested through
+// windowTest(). Neither are the SEP-related EvaluateSEPStars and findAllSEPStars().
 
 class TestGuideStars : public QObject
 {
@@ -28,6 +32,7 @@ class TestGuideStars : public QObject
     private slots:
         void basicTest();
         void calibrationTest();
+        void windowTest();
 };
 
 #include "testguidestars.moc"
@@ -606,4 +611,93 @@ void TestGuideStars::calibrationTest()
     CompareFloat(cal.raPulseMillisecondsPerArcsecond() * cal.xArcsecondsPerPixel(), raPulseRate);
 }
 
+namespace
+{
+// A star of a synthetic guide frame.
+struct FieldStar
+{
+    double x, y, peak;
+};
+
+// Renders stars with Gaussian profiles over a noisy background, shifted by dx, dy pixels.
+QSharedPointer<FITSData> renderField(const QVector<FieldStar> &stars, double dx, double dy, std::mt19937 &random)
+{
+    constexpr int width = 640, height = 480;
+    constexpr double sigma = 1.5, background = 1000;
+    std::normal_distribution<double> noise(0, std::sqrt(400 + background));
+
+    QVector<quint16> pixels(width * height);
+    for (int row = 0; row < height; ++row)
+    {
+        for (int column = 0; column < width; ++column)
+        {
+            double value = background + noise(random);
+            for (const auto &star : stars)
+            {
+                const double r2 = (column - star.x - dx) * (column - star.x - dx) + (row - star.y - dy) * (row - star.y - dy);
+                if (r2 < 100)
+                    value += star.peak * std::exp(-r2 / (2 * sigma * sigma));
+            }
+            pixels[row * width + column] = static_cast<quint16>(std::max(0.0, std::min(65535.0, std::round(value))));
+        }
+    }
+
+    QSharedPointer<FITSData> frame(new FITSData());
+    if (!frame->loadFromBuffer(GuideReplay::makeFits(width, height, pixels), "fits", "guide_stars.fits"))
+        return QSharedPointer<FITSData>();
+    return frame;
+}
+}  // namespace
+
+// Detecting the reference stars in windows around their expected positions must find
+// the same stars as a detection over the full frame.
+void TestGuideStars::windowTest()
+{
+    Options::setMinDetectionsSEPMultistar(5);
+    Options::setMaxMultistarReferenceStars(10);
+    Options::setGuideOptionsProfile(0);
+    const bool useWindows = Options::guideMultistarWindows();
+    Options::setGuideMultistarWindows(true);
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> jitter(-10, 10);
+    std::uniform_real_distribution<double> peak(5000, 20000);
+    QVector<FieldStar> stars;
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 3; ++j)
+            stars.append({80 + 120.0 * i + jitter(random), 80 + 140.0 * j + jitter(random), peak(random)});
+
+    GuideStars g;
+    QSharedPointer<GuideView> guideView;
+    const QVector3D guideStar = g.selectGuideStar(renderField(stars, 0, 0, random));
+    QVERIFY(guideStar.x() >= 0);
+    QVERIFY(g.getNumReferences() >= 5);
+    const QRect trackingBox(guideStar.x() - 16, guideStar.y() - 16, 32, 32);
+
+    // The first frame is searched over the full frame, and gives the guide star position
+    // around which the reference stars of the next frame are searched.
+    QVERIFY(g.findGuideStar(renderField(stars, 1.2, -0.7, random), trackingBox, guideView, false).x >= 0);
+
+    const QSharedPointer<FITSData> frame = renderField(stars, 2.1, -1.3, random);
+    const double maxHFR = Options::guideMaxHFR() + 2.0;
+    QVERIFY(g.findStarsInWindows(frame, trackingBox, maxHFR, 0.5));
+    const QList<Edge> windowed = g.detectedStars;
+    QList<Edge> full;
+    g.findTopStars(frame, 250, &full, maxHFR);
+
+    QVector<int> windowedMap, fullMap;
+    g.starCorrespondence.find(windowed, 10, &windowedMap, false);
+    g.starCorrespondence.find(full, 10, &fullMap, false);
+    for (int reference = 0; reference < g.getNumReferences(); ++reference)
+    {
+        const int w = windowedMap.indexOf(reference);
+        const int f = fullMap.indexOf(reference);
+        QVERIFY2(w >= 0 && f >= 0, qPrintable(QString("Reference %1 found in windows %2 full frame %3")
+                                              .arg(reference).arg(w >= 0).arg(f >= 0)));
+        QVERIFY(std::hypot(windowed[w].x - full[f].x, windowed[w].y - full[f].y) < 0.3);
+    }
+
+    Options::setGuideMultistarWindows(useWindows);
+}
+
 QTEST_GUILESS_MAIN(TestGuideStars)
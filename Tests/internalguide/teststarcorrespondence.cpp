@@ -24,8 +24,53 @@ class TestStarCorrespondence : public QObject
 
     private slots:
         void basicTest();
+        void manyStarsTest();
 };
 
+// Checks correspondence in a crowded field, where every star has neighbours
+// just outside the matching distance.
+void TestStarCorrespondence::manyStarsTest()
+{
+    constexpr double maxDistanceToStar = 5.0;
+    constexpr int columns = 60, rows = 40;
+    constexpr int guideStar = (rows / 2) * columns + columns / 2;
+
+    srand(7);
+    QList<Edge> stars;
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c)
+            stars.append(makeEdge(20 + c * 20 + (rand() % 100) / 25.0, 20 + r * 20 + (rand() % 100) / 25.0));
+
+    StarCorrespondence c(stars, guideStar);
+    c.setImageSize(1280, 860);
+    QVector<int> output;
+
+    // Shift the field, and reverse the order of the detected stars.
+    QList<Edge> stars2;
+    for (int i = stars.size() - 1; i >= 0; --i)
+        stars2.append(makeEdge(stars[i].x + 2.5, stars[i].y - 1.5));
+    const int last = stars.size() - 1;
+
+    // Run twice, the second find reuses the buffers of the first.
+    for (int run = 0; run < 2; ++run)
+    {
+        Edge gStar = c.find(stars2, maxDistanceToStar, &output, false);
+        QVERIFY(gStar.x == stars2[last - guideStar].x);
+        QVERIFY(gStar.y == stars2[last - guideStar].y);
+        QCOMPARE(output.size(), stars2.size());
+        for (int i = 0; i < stars2.size(); ++i)
+            QCOMPARE(output[i], last - i);
+    }
+
+    // Fewer detected stars than references, the map still has one entry per detected star.
+    stars2.erase(stars2.begin(), stars2.begin() + 100);
+    Edge gStar = c.find(stars2, maxDistanceToStar, &output, false);
+    QVERIFY(gStar.x == stars2[last - 100 - guideStar].x);
+    QCOMPARE(output.size(), stars2.size());
+    for (int i = 0; i < stars2.size(); ++i)
+        QCOMPARE(output[i], last - 100 - i);
+}
+
 #include "teststarcorrespondence.moc"
 
 TestStarCorrespondence::TestStarCorrespondence() : QObject()
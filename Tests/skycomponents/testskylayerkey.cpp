@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the view part of the cached sky layer key.
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "skymapcomposite.h"
+#include "projections/projector.h"
+#include "Options.h"
+
+class TestSkyLayerKey : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSkyLayerKey();
+
+        /** @short Destructor */
+        ~TestSkyLayerKey() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void clockTickTest_data();
+        void clockTickTest();
+
+    private:
+        bool m_ShowHorizontalGrid { false };
+        bool m_ShowLocalMeridian { false };
+};
+
+// This include must go after the class declaration.
+#include "testskylayerkey.moc"
+
+TestSkyLayerKey::TestSkyLayerKey() : QObject()
+{
+}
+
+void TestSkyLayerKey::initTestCase()
+{
+    m_ShowHorizontalGrid = Options::showHorizontalGrid();
+    m_ShowLocalMeridian = Options::showLocalMeridian();
+    Options::setShowLocalMeridian(false);
+}
+
+void TestSkyLayerKey::cleanupTestCase()
+{
+    Options::setShowHorizontalGrid(m_ShowHorizontalGrid);
+    Options::setShowLocalMeridian(m_ShowLocalMeridian);
+}
+
+void TestSkyLayerKey::clockTickTest_data()
+{
+    QTest::addColumn<bool>("USE_ALTAZ");
+    QTest::addColumn<bool>("FILL_GROUND");
+    QTest::addColumn<bool>("HORIZONTAL_GRID");
+    QTest::addColumn<bool>("CACHED");
+
+    QTest::newRow("Equatorial") << false << false << false << true;
+    QTest::newRow("Equatorial with ground") << false << true << false << false;
+    QTest::newRow("Equatorial with horizontal grid") << false << false << true << false;
+    QTest::newRow("Horizontal") << true << false << false << false;
+    QTest::newRow("Horizontal with ground") << true << true << false << false;
+}
+
+// Two consecutive ticks of the clock at 1x: the sidereal time moves by a second, the focus
+// keeps its RA and Dec but gets new horizontal coordinates, and the update ID is incremented.
+void TestSkyLayerKey::clockTickTest()
+{
+    QFETCH(bool, USE_ALTAZ);
+    QFETCH(bool, FILL_GROUND);
+    QFETCH(bool, HORIZONTAL_GRID);
+    QFETCH(bool, CACHED);
+
+    Options::setShowHorizontalGrid(HORIZONTAL_GRID);
+
+    const dms latitude(48.0);
+    SkyPoint focus(dms(83.8), dms(-5.4));
+
+    ViewParams view;
+    view.width = 1280;
+    view.height = 720;
+    view.zoomFactor = 1000;
+    view.useAltAz = USE_ALTAZ;
+    view.fillGround = FILL_GROUND;
+    view.focus = &focus;
+
+    dms lst(120.0);
+    focus.EquatorialToHorizontal(&lst, &latitude);
+    const QByteArray first = SkyMapComposite::viewKey(Projector::Lambert, view, 10);
+
+    lst.setD(lst.Degrees() + 1.00273790935 * 15.0 / 3600.0);
+    focus.EquatorialToHorizontal(&lst, &latitude);
+    const QByteArray second = SkyMapComposite::viewKey(Projector::Lambert, view, 11);
+
+    QCOMPARE(first == second, CACHED);
+
+    // The view itself still changes the key.
+    view.zoomFactor = 2000;
+    QVERIFY(SkyMapComposite::viewKey(Projector::Lambert, view, 11) != second);
+}
+
+QTEST_GUILESS_MAIN(TestSkyLayerKey)
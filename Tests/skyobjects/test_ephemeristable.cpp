@@ -0,0 +1,151 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_ephemeristable.h"
+
+#include "skyobjects/ephemeristable.h"
+#include "skyobjects/ksmoon.h"
+#include "skyobjects/ksplanet.h"
+#include "skyobjects/kssun.h"
+#include "ksnumbers.h"
+#include "ksutils.h"
+#include "Options.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace
+{
+// 2024-01-01 12:00 UT
+constexpr double START_JD = 2460311.0;
+constexpr double DAYS     = 30.0;
+// Times between the samples of the table
+constexpr double PROBE_STEP = 0.37;
+constexpr double ARCSEC     = 1.0 / 3600.0;
+
+/** @return the separation of two positions in degrees, for separations of a few arcseconds */
+double separation(double ra1, double dec1, double ra2, double dec2)
+{
+    const double dRa = KSUtils::reduceAngle(ra1 - ra2, -180.0, 180.0) * std::cos(dec1 * M_PI / 180.0);
+    return std::hypot(dRa, dec1 - dec2);
+}
+
+std::unique_ptr<KSPlanetBase> makeBody(const QString &name)
+{
+    if (name == "Sun")
+        return std::make_unique<KSSun>();
+    if (name == "Moon")
+        return std::make_unique<KSMoon>();
+    if (name == "Mars")
+        return std::make_unique<KSPlanet>(KSPlanetBase::MARS);
+    return std::make_unique<KSPlanet>(KSPlanetBase::JUPITER);
+}
+
+std::unique_ptr<KSPlanet> makeEarth()
+{
+    return std::make_unique<KSPlanet>("Earth", QString(), QColor("white"), 12756.28);
+}
+}
+
+TestEphemerisTable::TestEphemerisTable() : QObject()
+{
+    useRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(false);
+}
+
+TestEphemerisTable::~TestEphemerisTable()
+{
+    Options::setUseRelativistic(useRelativistic);
+}
+
+void TestEphemerisTable::initTestCase()
+{
+    // The orbital data is installed with KStars
+    if (!makeEarth()->loadData() || !KSMoon().loadData())
+        QSKIP("VSOP87 or lunar data files are not installed");
+}
+
+void TestEphemerisTable::cleanup()
+{
+    EphemerisTable::setActive(nullptr);
+}
+
+void TestEphemerisTable::interpolateTest_data()
+{
+    QTest::addColumn<QString>("name");
+
+    QTest::newRow("Sun") << "Sun";
+    QTest::newRow("Moon") << "Moon";
+    QTest::newRow("Mars") << "Mars";
+    QTest::newRow("Jupiter") << "Jupiter";
+}
+
+void TestEphemerisTable::interpolateTest()
+{
+    QFETCH(QString, name);
+
+    auto earth = makeEarth();
+    auto body  = makeBody(name);
+    const auto table = EphemerisTable::build({ body.get() }, earth.get(), START_JD, START_JD + DAYS, 1.0);
+    QCOMPARE(table->size(), 2);
+
+    // Positions computed without the table
+    auto referenceEarth = makeEarth();
+    auto reference      = makeBody(name);
+
+    double worst = 0;
+    for (double jd = START_JD; jd <= START_JD + DAYS; jd += PROBE_STEP)
+    {
+        KSNumbers num(jd);
+        referenceEarth->findGeocentricState(&num);
+        const KSPlanetBase::GeocentricState expected = reference->findGeocentricState(&num, referenceEarth.get());
+
+        KSPlanetBase::GeocentricState state;
+        QVERIFY(table->interpolate(body.get(), jd, &state));
+
+        worst = std::max(worst, separation(state.ra, state.dec, expected.ra, expected.dec));
+        worst = std::max(worst, separation(state.ra0, state.dec0, expected.ra0, expected.dec0));
+        worst = std::max(worst, separation(state.ecLong, state.ecLat, expected.ecLong, expected.ecLat));
+        QVERIFY(std::fabs(state.rearth - expected.rearth) < 1e-6 * expected.rearth);
+    }
+
+    qDebug() << name << "worst interpolation error" << worst * 3600 << "arcsec";
+    QVERIFY2(worst < ARCSEC, qPrintable(QString("%1 is off by %2 arcsec").arg(name).arg(worst * 3600)));
+
+    // Outside of the table, nothing is interpolated
+    KSPlanetBase::GeocentricState state;
+    QVERIFY(!table->interpolate(body.get(), START_JD - 1, &state));
+    QVERIFY(!table->interpolate(body.get(), START_JD + DAYS + 1, &state));
+    QVERIFY(!table->interpolate(reference.get(), START_JD, &state));
+}
+
+void TestEphemerisTable::findPositionTest()
+{
+    auto earth = makeEarth();
+    KSPlanet mars(KSPlanetBase::MARS);
+    EphemerisTable::setActive(EphemerisTable::build({ &mars }, earth.get(), START_JD, START_JD + DAYS, 1.0));
+
+    // Copies of the bodies are not in the table, they are computed
+    auto referenceEarth = makeEarth();
+    std::unique_ptr<KSPlanet> reference(mars.clone());
+
+    for (double jd = START_JD; jd <= START_JD + DAYS; jd += PROBE_STEP)
+    {
+        KSNumbers num(jd);
+        earth->findPosition(&num);
+        mars.findPosition(&num, nullptr, nullptr, earth.get());
+        referenceEarth->findPosition(&num);
+        reference->findPosition(&num, nullptr, nullptr, referenceEarth.get());
+
+        const double error = separation(mars.ra().Degrees(), mars.dec().Degrees(), reference->ra().Degrees(),
+                                        reference->dec().Degrees());
+        QVERIFY2(error < ARCSEC, qPrintable(QString("Mars is off by %1 arcsec at JD %2").arg(error * 3600).arg(jd, 0, 'f', 2)));
+        QVERIFY(std::fabs(mars.phase().Degrees() - reference->phase().Degrees()) < 0.01);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestEphemerisTable)
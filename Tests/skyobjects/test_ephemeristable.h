@@ -0,0 +1,33 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+#include <QDebug>
+
+/**
+ * @class TestEphemerisTable
+ * @short Tests the interpolated positions of the EphemerisTable against the computed positions
+ */
+class TestEphemerisTable : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestEphemerisTable();
+        ~TestEphemerisTable() override;
+
+    private slots:
+        void initTestCase();
+        void cleanup();
+        void interpolateTest_data();
+        void interpolateTest();
+        void findPositionTest();
+
+    private:
+        bool useRelativistic {false};
+};
@@ -0,0 +1,105 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_vsopcache.h"
+
+#include "skyobjects/ksplanet.h"
+#include "skyobjects/vsopcache.h"
+#include "ksnumbers.h"
+#include "ksutils.h"
+#include "Options.h"
+
+#include <QStandardPaths>
+
+#include <cmath>
+
+namespace
+{
+// 1950 to 2050, across several blocks of the cache
+constexpr double START_JD = 2433282.5;
+constexpr double END_JD   = 2469807.5;
+constexpr double STEP     = 97.3;
+constexpr double TOLERANCE = 0.001 / 3600.0;
+
+KSPlanet::GeocentricState position(KSPlanet *planet, KSPlanet *earth, double jd)
+{
+    KSNumbers num(jd);
+    earth->findGeocentricState(&num);
+    return planet->findGeocentricState(&num, earth);
+}
+}
+
+TestVSOPCache::TestVSOPCache() : QObject()
+{
+    useRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(false);
+}
+
+TestVSOPCache::~TestVSOPCache()
+{
+    Options::setUseRelativistic(useRelativistic);
+}
+
+void TestVSOPCache::initTestCase()
+{
+    // Keep the fitted blocks out of the cache of the user
+    QStandardPaths::setTestModeEnabled(true);
+
+    if (!KSPlanet("Earth").loadData())
+        QSKIP("VSOP87 data files are not installed");
+}
+
+void TestVSOPCache::cleanup()
+{
+    VSOPCache::Instance()->setEnabled(true);
+}
+
+void TestVSOPCache::geocentricPositionTest_data()
+{
+    QTest::addColumn<int>("planet");
+
+    QTest::newRow("Mercury") << static_cast<int>(KSPlanetBase::MERCURY);
+    QTest::newRow("Mars") << static_cast<int>(KSPlanetBase::MARS);
+    QTest::newRow("Jupiter") << static_cast<int>(KSPlanetBase::JUPITER);
+    QTest::newRow("Neptune") << static_cast<int>(KSPlanetBase::NEPTUNE);
+}
+
+void TestVSOPCache::geocentricPositionTest()
+{
+    QFETCH(int, planet);
+
+    KSPlanet earth("Earth");
+    KSPlanet body(planet);
+
+    QVector<KSPlanetBase::GeocentricState> direct;
+    VSOPCache::Instance()->setEnabled(false);
+    for (double jd = START_JD; jd < END_JD; jd += STEP)
+        direct.append(position(&body, &earth, jd));
+
+    VSOPCache::Instance()->setEnabled(true);
+    VSOPCache::Instance()->clear();
+    // The first pass fits or reads the blocks, the second one uses the blocks held in memory
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int i = 0;
+        for (double jd = START_JD; jd < END_JD; jd += STEP, i++)
+        {
+            const KSPlanetBase::GeocentricState cached = position(&body, &earth, jd);
+            const KSPlanetBase::GeocentricState &expected = direct.at(i);
+
+            const double dRa = KSUtils::reduceAngle(cached.ra - expected.ra, -180.0, 180.0) *
+                               std::cos(expected.dec * M_PI / 180.0);
+            QVERIFY2(std::fabs(dRa) < TOLERANCE && std::fabs(cached.dec - expected.dec) < TOLERANCE,
+                     qPrintable(QString("%1 is off by %2, %3 arcsec at JD %4").arg(body.name())
+                                .arg(dRa * 3600).arg((cached.dec - expected.dec) * 3600).arg(jd, 0, 'f', 1)));
+            QVERIFY(std::fabs(cached.helRsun - expected.helRsun) < 1e-8);
+            QVERIFY(std::fabs(cached.rearth - expected.rearth) < 1e-8);
+        }
+    }
+    VSOPCache::Instance()->clear();
+}
+
+QTEST_GUILESS_MAIN(TestVSOPCache)
@@ -0,0 +1,32 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+#include <QDebug>
+
+/**
+ * @class TestVSOPCache
+ * @short Tests the planet positions served by the VSOPCache against the summed VSOP87 series
+ */
+class TestVSOPCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestVSOPCache();
+        ~TestVSOPCache() override;
+
+    private slots:
+        void initTestCase();
+        void cleanup();
+        void geocentricPositionTest_data();
+        void geocentricPositionTest();
+
+    private:
+        bool useRelativistic {false};
+};
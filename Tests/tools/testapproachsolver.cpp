@@ -0,0 +1,193 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the ApproachSolver class and the solvers derived from it.
+ */
+
+#include <QObject>
+#include <QTest>
+#include <cmath>
+
+#include "approachsolver.h"
+#include "eclipsetool/lunareclipsehandler.h"
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "Options.h"
+
+class TestApproachSolver : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestApproachSolver();
+
+        /** @short Destructor */
+        ~TestApproachSolver() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void addApproachesTest();
+        void concurrentSearchTest();
+        void moonPhaseTest();
+        void lunarEclipseTest();
+
+    private:
+        bool m_UseRelativistic { false };
+        bool m_HaveData { false };
+};
+
+// This include must go after the class declaration.
+#include "testapproachsolver.moc"
+
+namespace
+{
+constexpr double MINUTE = 1.0 / (24.0 * 60.0);
+
+/**
+ * A solver for a separation oscillating with two periods, its minima are a fraction of a
+ * day apart and are found by all the chunks of a concurrent search.
+ */
+class WaveSolver : public ApproachSolver
+{
+    public:
+        using ApproachSolver::addApproaches;
+        using ApproachSolver::scan;
+
+        static constexpr double STEP = 0.02;
+
+        WaveSolver()
+        {
+            setMaxSeparation(dms(10.0));
+        }
+
+    protected:
+        ApproachSolver *clone() const override
+        {
+            WaveSolver *copy = new WaveSolver();
+            copySettingsTo(copy);
+            return copy;
+        }
+
+        double findInitialStep(long double, long double) override
+        {
+            return STEP;
+        }
+
+        void updatePositions(long double jd) override
+        {
+            m_JD = static_cast<double>(jd);
+        }
+
+        dms findDistance() override
+        {
+            return dms(3.0 + std::cos(2 * M_PI * m_JD / 1.3) + 0.5 * std::cos(2 * M_PI * m_JD / 0.37));
+        }
+
+    private:
+        double m_JD { 0 };
+};
+
+QMap<long double, dms> approaches(std::initializer_list<long double> times)
+{
+    QMap<long double, dms> result;
+    for (long double jd : times)
+        result.insert(jd, dms(1.0));
+    return result;
+}
+}  // namespace
+
+TestApproachSolver::TestApproachSolver() : QObject()
+{
+}
+
+void TestApproachSolver::initTestCase()
+{
+    m_UseRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(false);
+
+    // The orbital data is installed with KStars
+    m_HaveData = KSPlanet("Earth").loadData() && KSMoon().loadData();
+}
+
+void TestApproachSolver::cleanupTestCase()
+{
+    Options::setUseRelativistic(m_UseRelativistic);
+}
+
+void TestApproachSolver::addApproachesTest()
+{
+    QMap<long double, dms> found = approaches({ 10.0 });
+
+    // The same approach refined by the next chunk is added once, close approaches are all kept
+    WaveSolver::addApproaches(&found, approaches({ 10.0 + MINUTE, 10.0 + WaveSolver::STEP / 2, 12.0 }));
+    QCOMPARE(found.keys(), approaches({ 10.0, 10.0 + WaveSolver::STEP / 2, 12.0 }).keys());
+
+    WaveSolver::addApproaches(&found, approaches({ 12.0 - MINUTE, 12.5 }));
+    QCOMPARE(found.size(), 4);
+    QVERIFY(found.contains(12.5));
+}
+
+void TestApproachSolver::concurrentSearchTest()
+{
+    WaveSolver solver;
+    const long double start = 2460000.0, stop = start + 40;
+
+    const QMap<long double, dms> serial = solver.scan(start, stop, WaveSolver::STEP, false);
+    const QMap<long double, dms> concurrent = solver.findClosestApproach(start, stop);
+
+    QVERIFY(serial.size() > 10);
+    QCOMPARE(concurrent.size(), serial.size());
+    auto it = concurrent.constBegin();
+    for (auto expected = serial.constBegin(); expected != serial.constEnd(); ++expected, ++it)
+        QVERIFY2(std::fabs(static_cast<double>(it.key() - expected.key())) < 2 * MINUTE,
+                 qPrintable(QString("Approach at JD %1 instead of %2").arg(static_cast<double>(it.key()), 0, 'f', 4)
+                            .arg(static_cast<double>(expected.key()), 0, 'f', 4)));
+}
+
+void TestApproachSolver::moonPhaseTest()
+{
+    if (!m_HaveData)
+        QSKIP("VSOP87 or lunar data files are not installed");
+
+    // Full moon of 2024-01-25 17:54 UT, computed as worker copies do, with their own Earth.
+    // The shared Sun and Earth of KStarsData are not available here.
+    KSNumbers num(2460335.246);
+    KSPlanet earth("Earth");
+    KSSun sun;
+    KSMoon moon;
+    earth.findPosition(&num);
+    sun.findPosition(&num, nullptr, nullptr, &earth);
+    moon.findPosition(&num, nullptr, nullptr, &earth);
+    QVERIFY(moon.illum() > 0.99);
+
+    // The phase found from the Earth through the base class matches the one found from the Sun
+    KSPlanetBase *base = &moon;
+    base->findPhase(&earth);
+    const double fromEarth = moon.phase().Degrees();
+    moon.findPhase(&sun);
+    QVERIFY(std::fabs(fromEarth - moon.phase().Degrees()) < 0.01);
+}
+
+void TestApproachSolver::lunarEclipseTest()
+{
+    if (!m_HaveData)
+        QSKIP("VSOP87 or lunar data files are not installed");
+
+    // Total lunar eclipse of 2025-03-14, greatest at 06:58 UT
+    GeoLocation geo(dms(13.4), dms(52.5), "Berlin", "", "Germany", 1);
+    LunarEclipseHandler handler;
+    handler.setGeoLocation(&geo);
+
+    const EclipseHandler::EclipseVector eclipses = handler.computeEclipses(2460736.0, 2460766.0);
+    QCOMPARE(eclipses.size(), 1);
+    QVERIFY(std::fabs(static_cast<double>(eclipses[0]->getJD()) - 2460748.791) < 0.02);
+    QCOMPARE(eclipses[0]->getType(), EclipseEvent::FULL);
+}
+
+QTEST_GUILESS_MAIN(TestApproachSolver)
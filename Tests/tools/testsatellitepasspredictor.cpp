@@ -0,0 +1,162 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the SatellitePassPredictor class.
+ */
+
+#include <QObject>
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+
+#include "satellitepasspredictor.h"
+#include "geolocation.h"
+#include "Options.h"
+
+class TestSatellitePassPredictor : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSatellitePassPredictor();
+
+        /** @short Destructor */
+        ~TestSatellitePassPredictor() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void passesTest();
+        void crossingAtRiseTest();
+
+    private:
+        bool m_UseRelativistic { false };
+};
+
+// This include must go after the class declaration.
+#include "testsatellitepasspredictor.moc"
+
+namespace
+{
+// ISS elements, epoch 2024-01-01 12:00 UT.
+const QString NAME("ISS (ZARYA)");
+const QString LINE1("1 25544U 98067A   24001.50000000  .00016717  00000-0  30270-3 0  9001");
+const QString LINE2("2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.50125391432639");
+constexpr double EPOCH_JD = 2460311.0;
+constexpr double SECOND = 1.0 / 86400.0;
+
+// Berlin
+GeoLocation berlin()
+{
+    return GeoLocation(dms(13.4), dms(52.5), "Berlin", "", "Germany", 1);
+}
+
+double altitudeAt(Satellite *sat, GeoLocation *geo, double jd)
+{
+    sat->updatePos(Satellite::environment(jd, geo));
+    return sat->alt().Degrees();
+}
+}  // namespace
+
+TestSatellitePassPredictor::TestSatellitePassPredictor() : QObject()
+{
+}
+
+void TestSatellitePassPredictor::initTestCase()
+{
+    m_UseRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(false);
+}
+
+void TestSatellitePassPredictor::cleanupTestCase()
+{
+    Options::setUseRelativistic(m_UseRelativistic);
+}
+
+void TestSatellitePassPredictor::passesTest()
+{
+    GeoLocation geo = berlin();
+    Satellite iss(NAME, LINE1, LINE2);
+    SatellitePassPredictor predictor(&geo);
+    predictor.setSatellites(QList<Satellite *>() << &iss);
+
+    const auto passes = predictor.findPasses(EPOCH_JD, EPOCH_JD + 1, 0);
+
+    // The ISS passes over Berlin several times a day.
+    QVERIFY(passes.size() >= 3);
+
+    // Each pass is checked against the direct propagation of the elements.
+    Satellite reference(NAME, LINE1, LINE2);
+    for (const auto &pass : passes)
+    {
+        QCOMPARE(pass.name, iss.name());
+        QVERIFY(pass.riseJD < pass.culminationJD && pass.culminationJD < pass.setJD);
+        // Low earth orbit passes last a few minutes.
+        QVERIFY(pass.setJD - pass.riseJD < 15 * 60 * SECOND);
+
+        if (pass.riseJD > EPOCH_JD)
+        {
+            QVERIFY(altitudeAt(&reference, &geo, pass.riseJD - SECOND) < 0);
+            QVERIFY(altitudeAt(&reference, &geo, pass.riseJD + SECOND) > 0);
+        }
+        if (pass.setJD < EPOCH_JD + 1)
+        {
+            QVERIFY(altitudeAt(&reference, &geo, pass.setJD - SECOND) > 0);
+            QVERIFY(altitudeAt(&reference, &geo, pass.setJD + SECOND) < 0);
+        }
+
+        const double culmination = altitudeAt(&reference, &geo, pass.culminationJD);
+        QVERIFY(std::fabs(culmination - pass.maxAltitude) < 0.01);
+        QVERIFY(altitudeAt(&reference, &geo, pass.culminationJD - 10 * SECOND) < culmination);
+        QVERIFY(altitudeAt(&reference, &geo, pass.culminationJD + 10 * SECOND) < culmination);
+    }
+
+    // Every pass higher than the coarse step can miss is found.
+    for (double jd = EPOCH_JD; jd < EPOCH_JD + 1; jd += 10 * SECOND)
+    {
+        if (altitudeAt(&reference, &geo, jd) < 10)
+            continue;
+        const bool found = std::any_of(passes.begin(), passes.end(), [jd](const SatellitePassPredictor::Pass & pass)
+        {
+            return pass.riseJD <= jd && jd <= pass.setJD;
+        });
+        QVERIFY2(found, qPrintable(QString("No pass found at JD %1").arg(jd, 0, 'f', 6)));
+    }
+}
+
+void TestSatellitePassPredictor::crossingAtRiseTest()
+{
+    GeoLocation geo = berlin();
+    Satellite iss(NAME, LINE1, LINE2);
+    SatellitePassPredictor predictor(&geo);
+    predictor.setSatellites(QList<Satellite *>() << &iss);
+
+    const auto passes = predictor.findPasses(EPOCH_JD, EPOCH_JD + 1, 0);
+    QVERIFY(!passes.isEmpty());
+    const auto pass = std::find_if(passes.begin(), passes.end(), [](const SatellitePassPredictor::Pass & pass)
+    {
+        return pass.riseJD > EPOCH_JD;
+    });
+    QVERIFY(pass != passes.end());
+
+    // A field centered where the satellite rises: it is in the field at the rise, then only moves away.
+    Satellite reference(NAME, LINE1, LINE2);
+    reference.updatePos(Satellite::environment(pass->riseJD, &geo));
+    SkyPoint center(reference.ra(), reference.dec());
+    const SkyPoint target = center.catalogueCoord(EPOCH_JD);
+
+    const auto crossings = predictor.findCrossings(target, 0.5, EPOCH_JD, pass->setJD);
+    QVERIFY(!crossings.isEmpty());
+    const auto &crossing = crossings.last();
+    QVERIFY(std::fabs(crossing.ingressJD - pass->riseJD) < 2 * SECOND);
+    QVERIFY(std::fabs(crossing.closestJD - pass->riseJD) < 2 * SECOND);
+    QVERIFY(crossing.egressJD > crossing.closestJD);
+    QVERIFY(crossing.separation < 0.1);
+}
+
+QTEST_GUILESS_MAIN(TestSatellitePassPredictor)
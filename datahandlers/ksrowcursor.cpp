@@ -0,0 +1,383 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksrowcursor.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+
+#include <cstring>
+#include <limits>
+
+struct KSRowCursor::Mapping
+{
+    QFile file;
+    const char *data { nullptr };
+    qint64 size { 0 };
+};
+
+namespace
+{
+inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+void Trim(const char *&begin, const char *&end)
+{
+    while (begin < end && IsBlank(*begin))
+        ++begin;
+    while (end > begin && IsBlank(end[-1]))
+        --end;
+}
+}
+
+KSRowCursor::KSRowCursor(const QString &filename, const char comment_char, const char delimiter)
+    : comment_char_(comment_char), delimiter_(delimiter)
+{
+    Open(filename);
+}
+
+KSRowCursor::KSRowCursor(const QString &filename, const char comment_char, const QList<int> &widths)
+    : comment_char_(comment_char), width_sequence_(widths)
+{
+    for (const int width : width_sequence_)
+        total_min_length_ += width;
+    Open(filename);
+}
+
+void KSRowCursor::Open(const QString &filename)
+{
+    auto mapping = std::make_shared<Mapping>();
+    mapping->file.setFileName(filename);
+    if (!mapping->file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Unable to open file: " << filename;
+        return;
+    }
+
+    // An empty file can not be mapped, it simply has no rows
+    mapping->size = mapping->file.size();
+    if (mapping->size > 0)
+    {
+        mapping->data = reinterpret_cast<const char *>(mapping->file.map(0, mapping->size));
+        if (mapping->data == nullptr)
+        {
+            qWarning() << "Unable to map file: " << filename << mapping->file.errorString();
+            return;
+        }
+    }
+
+    pos_ = mapping->data;
+    end_ = mapping->data + mapping->size;
+    // Skip the UTF-8 byte order mark
+    if (end_ - pos_ >= 3 && std::memcmp(pos_, "\xEF\xBB\xBF", 3) == 0)
+        pos_ += 3;
+
+    mapping_ = std::move(mapping);
+}
+
+bool KSRowCursor::ReadHeader()
+{
+    header_.clear();
+    if (!Next())
+        return false;
+
+    for (int i = 0; i < fields_.size(); ++i)
+        header_.append(ToString(i));
+    return true;
+}
+
+bool KSRowCursor::Next()
+{
+    while (pos_ < end_)
+    {
+        const char *line = pos_;
+        const char *eol  = static_cast<const char *>(std::memchr(line, '\n', end_ - line));
+        const char *stop = eol ? eol : end_;
+        pos_             = eol ? eol + 1 : end_;
+
+        if (stop > line && stop[-1] == '\r')
+            --stop;
+        if (stop == line || *line == comment_char_)
+            continue;
+
+        const bool read_success =
+            width_sequence_.isEmpty() ? SplitDelimited(line, stop) : SplitFixedWidth(line, stop);
+        if (read_success)
+            return true;
+    }
+
+    fields_.clear();
+    return false;
+}
+
+bool KSRowCursor::SplitDelimited(const char *line, const char *stop)
+{
+    fields_.clear();
+
+    const char *p = line;
+    for (;;)
+    {
+        while (p < stop && *p != delimiter_ && IsBlank(*p))
+            ++p;
+
+        Field field;
+        const char *next = p;
+        if (p < stop && *p == '"')
+        {
+            const char *quote = p + 1;
+            field.begin       = quote;
+            for (;;)
+            {
+                quote = static_cast<const char *>(std::memchr(quote, '"', stop - quote));
+                if (quote == nullptr)
+                    return false;
+                if (quote + 1 < stop && quote[1] == '"')
+                {
+                    field.escaped = true;
+                    quote += 2;
+                    continue;
+                }
+                break;
+            }
+            field.end = quote;
+            next      = quote + 1;
+        }
+
+        // Anything between a closing quote and the delimiter is ignored
+        const char *delimiter = static_cast<const char *>(std::memchr(next, delimiter_, stop - next));
+        if (field.begin == nullptr)
+        {
+            field.begin = p;
+            field.end   = delimiter ? delimiter : stop;
+            while (field.end > field.begin && IsBlank(field.end[-1]))
+                --field.end;
+        }
+        fields_.append(field);
+
+        if (delimiter == nullptr)
+            return true;
+        p = delimiter + 1;
+    }
+}
+
+bool KSRowCursor::SplitFixedWidth(const char *line, const char *stop)
+{
+    if (stop - line < total_min_length_)
+        return false;
+
+    fields_.clear();
+
+    Field field;
+    field.end = line;
+    for (const int width : width_sequence_)
+    {
+        field.begin = field.end;
+        field.end   = field.begin + width;
+        fields_.append(field);
+    }
+    field.begin = field.end;
+    field.end   = stop;
+    fields_.append(field);
+
+    for (Field &item : fields_)
+        Trim(item.begin, item.end);
+    return true;
+}
+
+bool KSRowCursor::IsEmpty(int column) const
+{
+    return column < 0 || column >= fields_.size() || fields_[column].begin == fields_[column].end;
+}
+
+QLatin1String KSRowCursor::View(int column) const
+{
+    if (column < 0 || column >= fields_.size())
+        return QLatin1String();
+
+    const Field &field = fields_[column];
+    return QLatin1String(field.begin, static_cast<int>(field.end - field.begin));
+}
+
+QString KSRowCursor::ToString(int column) const
+{
+    if (column < 0 || column >= fields_.size())
+        return QString();
+
+    const Field &field = fields_[column];
+    QString value      = QString::fromUtf8(field.begin, static_cast<int>(field.end - field.begin));
+    if (field.escaped)
+        value.replace(QLatin1String("\"\""), QLatin1String("\""));
+    return value;
+}
+
+double KSRowCursor::ToDouble(int column, bool *ok) const
+{
+    double value = 0;
+    const bool success =
+        column >= 0 && column < fields_.size() && ParseDouble(fields_[column].begin, fields_[column].end, value);
+    if (!success)
+        value = 0;
+    if (ok)
+        *ok = success;
+    return value;
+}
+
+int KSRowCursor::ToInt(int column, bool *ok) const
+{
+    int value = 0;
+    const bool success =
+        column >= 0 && column < fields_.size() && ParseInt(fields_[column].begin, fields_[column].end, value);
+    if (!success)
+        value = 0;
+    if (ok)
+        *ok = success;
+    return value;
+}
+
+bool KSRowCursor::ParseDouble(const char *begin, const char *end, double &value)
+{
+    // Powers of ten that are exact in double precision
+    static const double powers[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                                   };
+
+    Trim(begin, end);
+    if (begin == end)
+        return false;
+
+    const char *p = begin;
+    bool negative = false;
+    if (*p == '+' || *p == '-')
+        negative = *p++ == '-';
+
+    // Up to 19 significant digits, more do not fit the mantissa and go to the slow path
+    quint64 mantissa = 0;
+    int digits       = 0;
+    int exponent     = 0;
+    bool any_digit   = false;
+    for (; p < end && IsDigit(*p); ++p)
+    {
+        any_digit = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0;
+        }
+        else
+            ++exponent;
+    }
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && IsDigit(*p); ++p)
+        {
+            any_digit = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+                --exponent;
+            }
+        }
+    }
+    if (any_digit && p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negative_exponent = false;
+        if (p < end && (*p == '+' || *p == '-'))
+            negative_exponent = *p++ == '-';
+        if (p == end || !IsDigit(*p))
+            return false;
+
+        int e = 0;
+        for (; p < end && IsDigit(*p); ++p)
+        {
+            if (e < 100000)
+                e = e * 10 + (*p - '0');
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    // Both the mantissa and the power of ten are exact, so one rounding gives the
+    // correctly rounded value
+    if (any_digit && p == end && mantissa <= (Q_UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        const double magnitude = static_cast<double>(mantissa);
+        value = exponent < 0 ? magnitude / powers[-exponent] : magnitude * powers[exponent];
+        if (negative)
+            value = -value;
+        return true;
+    }
+
+    // Long mantissas, large exponents, inf and nan are rare, convert a copy
+    bool ok = false;
+    value   = QByteArray(begin, static_cast<int>(end - begin)).toDouble(&ok);
+    return ok;
+}
+
+bool KSRowCursor::ParseInt(const char *begin, const char *end, int &value)
+{
+    Trim(begin, end);
+
+    const char *p = begin;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+        negative = *p++ == '-';
+    if (p == end)
+        return false;
+
+    const qint64 limit = static_cast<qint64>(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+    qint64 result      = 0;
+    for (; p < end; ++p)
+    {
+        if (!IsDigit(*p))
+            return false;
+        result = result * 10 + (*p - '0');
+        if (result > limit)
+            return false;
+    }
+
+    value = static_cast<int>(negative ? -result : result);
+    return true;
+}
+
+QList<KSRowCursor> KSRowCursor::Split(int count) const
+{
+    QList<KSRowCursor> parts;
+    if (pos_ >= end_)
+        return parts;
+
+    count             = qMax(count, 1);
+    const qint64 size = end_ - pos_;
+    const char *begin = pos_;
+    for (int i = 1; i <= count && begin < end_; ++i)
+    {
+        // Parts end after the first line break past their share of the bytes
+        const char *stop = end_;
+        if (i < count)
+        {
+            const char *target = qMax(begin, pos_ + size * i / count);
+            const char *eol    = static_cast<const char *>(std::memchr(target, '\n', end_ - target));
+            stop               = eol ? eol + 1 : end_;
+        }
+
+        KSRowCursor part(*this);
+        part.pos_ = begin;
+        part.end_ = stop;
+        part.fields_.clear();
+        parts.append(part);
+
+        begin = stop;
+    }
+    return parts;
+}
@@ -0,0 +1,154 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QLatin1String>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVarLengthArray>
+
+#include <memory>
+
+/**
+ * @brief Row cursor over a memory-mapped CSV or fixed width text file.
+ *
+ * Unlike KSParser, no QHash or QVariant is built per row: Next() only records where
+ * the fields of the current row are in the mapped file, and the typed accessors convert
+ * a field when it is asked for. Numbers are parsed directly from the mapped bytes.
+ * Column indexes should be looked up once with Column() after ReadHeader().
+ *
+ * Usage:
+ * 1) KSRowCursor cursor(filename, '#');
+ * 2) cursor.ReadHeader();
+ *    const int mag = cursor.Column("mag");
+ * 3) while (cursor.Next()) {
+ *      double value = cursor.ToDouble(mag);
+ *      ...
+ *    }
+ *
+ * Large files can be read in parallel with Split(), each part being read by its own
+ * thread.
+ *
+ * Behavior:
+ * 1) Empty lines and lines starting with the comment character are skipped
+ * 2) Unquoted fields are trimmed of surrounding blanks, quoted fields are kept as they are.
+ *    A doubled quote inside a quoted field stands for one quote. Quoted fields can not span
+ *    several lines.
+ * 3) CSV rows with an unterminated quote, and fixed width rows shorter than the sum of
+ *    the widths, are skipped
+ * 4) Empty or invalid numbers are read as 0, and ok is set to false
+ * 5) Fixed widths are in bytes, the last field is taken till the end of the line
+ **/
+class KSRowCursor
+{
+  public:
+    /**
+     * @brief Open a CSV file.
+     *
+     * @param filename Full Path (Dir + Filename) of source file
+     * @param comment_char Character signifying a comment line
+     * @param delimiter separate on which character. default ','
+     **/
+    KSRowCursor(const QString &filename, const char comment_char, const char delimiter = ',');
+
+    /**
+     * @brief Open a fixed width file.
+     *
+     * @param filename Full Path (Dir + Filename) of source file
+     * @param comment_char Character signifying a comment line
+     * @param widths width of each field but the last one, in bytes
+     **/
+    KSRowCursor(const QString &filename, const char comment_char, const QList<int> &widths);
+
+    /** @return True if the file could be opened */
+    bool IsOpen() const { return mapping_ != nullptr; }
+
+    /**
+     * @brief Read the next row as the header of the file.
+     * Column names are the fields of this row.
+     *
+     * @return False if there is no row left
+     **/
+    bool ReadHeader();
+
+    /** @return Names of the columns read by ReadHeader() */
+    const QStringList &Header() const { return header_; }
+
+    /** @return Index of the column named @p name, or -1 if there is no such column */
+    int Column(const QString &name) const { return header_.indexOf(name); }
+
+    /**
+     * @brief Move to the next row.
+     *
+     * @return False if there is no row left
+     **/
+    bool Next();
+
+    /** @return Number of fields of the current row */
+    int FieldCount() const { return fields_.size(); }
+
+    /** @return True if @p column is missing from the current row or empty */
+    bool IsEmpty(int column) const;
+
+    /**
+     * @brief Field at @p column, without copying.
+     * The view is only valid until the next call to Next(). Doubled quotes are not
+     * unescaped, and non-ASCII text should be read with ToString().
+     **/
+    QLatin1String View(int column) const;
+
+    /** @return Field at @p column, empty if missing */
+    QString ToString(int column) const;
+
+    /** @return Field at @p column converted to double */
+    double ToDouble(int column, bool *ok = nullptr) const;
+
+    /** @return Field at @p column converted to int */
+    int ToInt(int column, bool *ok = nullptr) const;
+
+    /**
+     * @brief Split the rows left to read into at most @p count cursors.
+     * Each cursor reads a contiguous range of whole lines and shares the mapped file and
+     * the header of this one. Read the parts in order to get the rows in file order.
+     *
+     * @return The cursors, empty if there is nothing left to read
+     **/
+    QList<KSRowCursor> Split(int count) const;
+
+  private:
+    struct Mapping;
+
+    struct Field
+    {
+        const char *begin { nullptr };
+        const char *end { nullptr };
+        /// Field is quoted and contains doubled quotes
+        bool escaped { false };
+    };
+
+    void Open(const QString &filename);
+
+    bool SplitDelimited(const char *line, const char *stop);
+    bool SplitFixedWidth(const char *line, const char *stop);
+
+    static bool ParseDouble(const char *begin, const char *end, double &value);
+    static bool ParseInt(const char *begin, const char *end, int &value);
+
+    std::shared_ptr<const Mapping> mapping_;
+    const char *pos_ { nullptr };
+    const char *end_ { nullptr };
+
+    char comment_char_ { 0 };
+    char delimiter_ { 0 };
+    QList<int> width_sequence_;
+    int total_min_length_ { 0 };
+
+    QStringList header_;
+    /// Reused from row to row, it only grows with the widest row
+    QVarLengthArray<Field, 32> fields_;
+};
@@ -0,0 +1,254 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "chartrenderer.h"
+
+#ifndef KSTARS_LITE
+#include "chartrendereradaptor.h"
+
+#include <QDBusConnection>
+#endif
+
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "simclock.h"
+#include "skyrendercontext.h"
+#include "skyobjects/skyobject.h"
+
+#include <KLocalizedString>
+
+#include <QFile>
+#include <QFuture>
+#include <QQueue>
+#include <QSignalBlocker>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <kstars_debug.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+/** Parse an ISO 8601 time, times without an offset are UTC */
+QDateTime parseUTC(const QString &utc)
+{
+    QDateTime dt = QDateTime::fromString(utc.trimmed(), Qt::ISODate);
+    if (dt.timeSpec() == Qt::LocalTime)
+        dt.setTimeSpec(Qt::UTC);
+    else
+        dt = dt.toUTC();
+    return dt;
+}
+
+/** Find the apparent coordinates of @p target at the current simulation time */
+bool resolveTarget(const QString &target, SkyPoint &center)
+{
+    KStarsData *data = KStarsData::Instance();
+
+    if (const SkyObject *object = data->objectNamed(target))
+    {
+        // Objects are only updated when drawn, update a copy now
+        std::unique_ptr<SkyObject> copy(object->clone());
+        copy->updateCoords(data->updateNum(), true, data->geo()->lat(), data->lst(), false);
+        center = *copy;
+        return true;
+    }
+
+    const QStringList fields = target.simplified().split(' ');
+    bool raOk = false, decOk = false;
+    double ra = 0, dec = 0;
+    if (fields.size() == 2)
+    {
+        ra  = fields[0].toDouble(&raOk);
+        dec = fields[1].toDouble(&decOk);
+    }
+    if (!raOk || !decOk)
+        return false;
+
+    center = SkyPoint(dms(ra), dms(dec));
+    center.apparentCoord(static_cast<long double>(J2000), data->updateNum()->julianDay());
+    return true;
+}
+}
+
+ChartRenderer *ChartRenderer::Instance()
+{
+    static ChartRenderer *instance = new ChartRenderer();
+    return instance;
+}
+
+ChartRenderer::ChartRenderer()
+{
+#ifndef KSTARS_LITE
+    new ChartRendererAdaptor(this);
+    QDBusConnection::sessionBus().registerObject("/KStars/ChartRenderer", this);
+#endif
+}
+
+QVector<ChartRenderer::Request> ChartRenderer::readRequests(const QString &fileName, QString *error)
+{
+    QVector<Request> requests;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        if (error)
+            *error = i18n("Unable to read chart requests from %1: %2", fileName, file.errorString());
+        return requests;
+    }
+
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd())
+    {
+        const QString line = in.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        const QStringList fields = line.split(',');
+        Request request;
+        bool ok = fields.size() == 4;
+        if (ok)
+        {
+            request.target      = fields[0].trimmed();
+            request.fieldOfView = fields[1].toDouble(&ok);
+            request.fileName    = fields[3].trimmed();
+            ok &= !request.target.isEmpty() && !request.fileName.isEmpty() && request.fieldOfView > 0;
+        }
+        if (ok && !fields[2].trimmed().isEmpty())
+        {
+            request.utc = parseUTC(fields[2]);
+            ok = request.utc.isValid();
+        }
+
+        if (!ok)
+        {
+            if (error)
+                *error = i18n("Invalid chart request at line %1 of %2", lineNumber, fileName);
+            return QVector<Request>();
+        }
+
+        requests.append(request);
+    }
+
+    return requests;
+}
+
+int ChartRenderer::render(QVector<Request> requests, const QSize &size)
+{
+    KStarsData *data = KStarsData::Instance();
+    if (data == nullptr || requests.isEmpty())
+        return 0;
+
+    const KStarsDateTime startUT = data->ut();
+    const bool clockActive = data->clock()->isActive();
+    if (clockActive)
+        data->clock()->stop();
+
+    // Update the sky once per distinct time
+    for (auto &request : requests)
+    {
+        if (request.utc.isNull())
+            request.utc = startUT;
+    }
+    std::stable_sort(requests.begin(), requests.end(), [](const Request & a, const Request & b)
+    {
+        return a.utc < b.utc;
+    });
+
+    // Bounds the number of images waiting to be written
+    const int maxPending = 2 * QThreadPool::globalInstance()->maxThreadCount();
+    QQueue<QFuture<bool>> pending;
+    int written = 0;
+
+    SkyRenderContext context(size);
+    {
+        // Do not repaint the sky map at each time change
+        const QSignalBlocker blocker(data);
+
+        QDateTime currentUT;
+        for (const auto &request : requests)
+        {
+            if (request.utc != currentUT)
+            {
+                currentUT = request.utc;
+                data->changeDateTime(KStarsDateTime(currentUT));
+                data->updateTime(data->geo(), false);
+                data->syncUpdateIDs();
+            }
+
+            SkyPoint center;
+            if (!resolveTarget(request.target, center))
+            {
+                qCWarning(KSTARS) << "Chart target not found:" << request.target;
+                continue;
+            }
+
+            context.setCenter(center);
+            context.setFieldOfView(request.fieldOfView);
+            if (!context.render())
+                break;
+
+            const QImage image     = context.takeImage();
+            const QString fileName = request.fileName;
+            pending.enqueue(QtConcurrent::run([image, fileName]()
+            {
+                const bool saved = image.save(fileName);
+                if (!saved)
+                    qCWarning(KSTARS) << "Unable to save chart" << fileName;
+                return saved;
+            }));
+
+            while (pending.size() >= maxPending)
+                written += pending.dequeue().result() ? 1 : 0;
+        }
+    }
+
+    while (!pending.isEmpty())
+        written += pending.dequeue().result() ? 1 : 0;
+
+    data->changeDateTime(startUT);
+    data->updateTime(data->geo(), false);
+    if (clockActive)
+        data->clock()->start();
+
+    qCInfo(KSTARS) << "Rendered" << written << "of" << requests.size() << "charts";
+    return written;
+}
+
+int ChartRenderer::renderCharts(const QString &requestFile, int width, int height)
+{
+    QString error;
+    const QVector<Request> requests = readRequests(requestFile, &error);
+    if (!error.isEmpty())
+    {
+        qCWarning(KSTARS) << error;
+        return -1;
+    }
+
+    return render(requests, QSize(width, height));
+}
+
+bool ChartRenderer::renderChart(const QString &target, double fieldOfView, const QString &utc,
+                                const QString &fileName, int width, int height)
+{
+    Request request;
+    request.target      = target;
+    request.fieldOfView = fieldOfView;
+    request.fileName    = fileName;
+    if (!utc.isEmpty())
+    {
+        request.utc = parseUTC(utc);
+        if (!request.utc.isValid())
+            return false;
+    }
+
+    return render({ request }, QSize(width, height)) == 1;
+}
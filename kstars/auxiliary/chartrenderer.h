@@ -0,0 +1,85 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class ChartRenderer
+ * @short Renders batches of finder charts without going through the sky map widget.
+ *
+ * Each chart is described by a target, a field of view, a time and an output file. Charts are
+ * drawn by a SkyRenderContext, sorted by time so that the sky is updated once per distinct time.
+ * Drawing is done on the GUI thread because the sky components are shared with the sky map, while
+ * encoding and writing the images runs concurrently on the global thread pool.
+ *
+ * Batches are requested over D-Bus on /KStars/ChartRenderer, or from the command line with --charts.
+ * A request file has one chart per line, "target,fov,utc,file", where target is an object name or
+ * "RA Dec" J2000 coordinates in degrees, fov is in degrees and utc is an ISO date and time, empty for
+ * the current time. Empty lines and lines starting with # are ignored.
+ */
+class ChartRenderer : public QObject
+{
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.kde.kstars.ChartRenderer")
+
+    public:
+        struct Request
+        {
+            QString target;
+            double fieldOfView { 1.0 };
+            /// Null for the current time
+            QDateTime utc;
+            QString fileName;
+        };
+
+        /** @return the D-Bus facing instance, created on first use */
+        static ChartRenderer *Instance();
+
+        /**
+         * @short Read chart requests from @p fileName.
+         * @param error set to a description of the first invalid line, if any
+         * @return the requests, empty if the file cannot be read or is invalid
+         */
+        static QVector<Request> readRequests(const QString &fileName, QString *error = nullptr);
+
+        /**
+         * @short Render all @p requests as images of @p size.
+         * The simulation clock is paused during the batch and restored afterwards.
+         * @return number of charts written
+         */
+        int render(QVector<Request> requests, const QSize &size);
+
+        /**
+         * DBUS interface function. Render all charts listed in a request file.
+         * @param requestFile path of the request file
+         * @param width width of the charts in pixels
+         * @param height height of the charts in pixels
+         * @return number of charts written, or -1 if the request file is invalid
+         */
+        Q_SCRIPTABLE int renderCharts(const QString &requestFile, int width, int height);
+
+        /**
+         * DBUS interface function. Render a single chart.
+         * @param target object name, or "RA Dec" J2000 coordinates in degrees
+         * @param fieldOfView field of view across the larger dimension, in degrees
+         * @param utc ISO date and time, empty for the current time
+         * @param fileName path of the image to write, its extension selects the format
+         * @param width width of the chart in pixels
+         * @param height height of the chart in pixels
+         * @return true if the chart was written
+         */
+        Q_SCRIPTABLE bool renderChart(const QString &target, double fieldOfView, const QString &utc,
+                                      const QString &fileName, int width, int height);
+
+    private:
+        ChartRenderer();
+};
@@ -0,0 +1,265 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksprofiler.h"
+
+#ifndef KSTARS_LITE
+#include "profileradaptor.h"
+
+#include <QDBusConnection>
+#endif
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QXmlStreamWriter>
+
+#include <kstars_debug.h>
+
+#include <algorithm>
+#include <limits>
+
+std::atomic<bool> KSProfiler::s_Enabled { qEnvironmentVariableIsSet("KSTARS_PROFILE") };
+
+namespace
+{
+// Bounds the memory used by the trace, about 40 bytes per event
+constexpr int MAX_TRACE_EVENTS = 1000000;
+
+struct Timing
+{
+    qint64 count { 0 };
+    qint64 total { 0 };
+    qint64 min { std::numeric_limits<qint64>::max() };
+    qint64 max { 0 };
+
+    void add(qint64 nsecs)
+    {
+        count++;
+        total += nsecs;
+        min = std::min(min, nsecs);
+        max = std::max(max, nsecs);
+    }
+};
+
+struct TraceEvent
+{
+    QByteArray name;
+    qint64 start;
+    qint64 duration;
+    int thread;
+};
+
+struct ProfileData
+{
+    QMutex mutex;
+    QHash<QByteArray, Timing> timings;
+    QHash<QByteArray, qint64> counters;
+    QVector<TraceEvent> trace;
+    qint64 droppedEvents { 0 };
+    // Small thread numbers read better in trace viewers than thread handles
+    QHash<Qt::HANDLE, int> threads;
+};
+
+ProfileData &profileData()
+{
+    static ProfileData data;
+    return data;
+}
+
+QByteArray literalName(const char *name)
+{
+    return QByteArray::fromRawData(name, static_cast<int>(qstrlen(name)));
+}
+
+void recordTiming(const QByteArray &name, qint64 start, qint64 end)
+{
+    ProfileData &data = profileData();
+    const Qt::HANDLE thread = QThread::currentThreadId();
+
+    QMutexLocker locker(&data.mutex);
+    data.timings[name].add(end - start);
+
+    if (data.trace.size() < MAX_TRACE_EVENTS)
+    {
+        auto it = data.threads.find(thread);
+        if (it == data.threads.end())
+            it = data.threads.insert(thread, data.threads.size() + 1);
+        data.trace.append({ name, start, end - start, it.value() });
+    }
+    else
+        data.droppedEvents++;
+}
+
+double toMilliseconds(qint64 nsecs)
+{
+    return nsecs / 1e6;
+}
+}
+
+KSProfiler *KSProfiler::Instance()
+{
+    static KSProfiler *instance = new KSProfiler();
+    return instance;
+}
+
+KSProfiler::KSProfiler()
+{
+#ifndef KSTARS_LITE
+    new ProfilerAdaptor(this);
+    QDBusConnection::sessionBus().registerObject("/KStars/Profiler", this);
+#endif
+    if (isEnabled())
+        qCInfo(KSTARS) << "Profiling is enabled";
+}
+
+qint64 KSProfiler::now()
+{
+    static QElapsedTimer clock = []()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed();
+}
+
+void KSProfiler::record(const char *name, qint64 start, qint64 end)
+{
+    recordTiming(literalName(name), start, end);
+}
+
+void KSProfiler::addCount(const char *name, qint64 value)
+{
+    ProfileData &data = profileData();
+    QMutexLocker locker(&data.mutex);
+    data.counters[literalName(name)] += value;
+}
+
+void KSProfiler::addDuration(const char *name, qint64 nsecs)
+{
+    ProfileData &data = profileData();
+    QMutexLocker locker(&data.mutex);
+    data.timings[literalName(name)].add(nsecs);
+}
+
+void KSProfiler::Stages::close()
+{
+    if (m_Start < 0)
+        return;
+
+    const qint64 end = now();
+    recordTiming(QByteArray(m_Group) + '/' + m_Stage, m_Start, end);
+    m_Start = -1;
+}
+
+void KSProfiler::setEnabled(bool enabled)
+{
+    s_Enabled.store(enabled, std::memory_order_relaxed);
+    qCInfo(KSTARS) << "Profiling is" << (enabled ? "enabled" : "disabled");
+}
+
+bool KSProfiler::enabled() const
+{
+    return isEnabled();
+}
+
+void KSProfiler::reset()
+{
+    ProfileData &data = profileData();
+    QMutexLocker locker(&data.mutex);
+    data.timings.clear();
+    data.counters.clear();
+    data.trace.clear();
+    data.droppedEvents = 0;
+}
+
+QString KSProfiler::report() const
+{
+    QMap<QByteArray, Timing> timings;
+    QMap<QByteArray, qint64> counters;
+    qint64 events = 0, dropped = 0;
+    {
+        ProfileData &data = profileData();
+        QMutexLocker locker(&data.mutex);
+        for (auto it = data.timings.cbegin(); it != data.timings.cend(); ++it)
+            timings.insert(it.key(), it.value());
+        for (auto it = data.counters.cbegin(); it != data.counters.cend(); ++it)
+            counters.insert(it.key(), it.value());
+        events  = data.trace.size();
+        dropped = data.droppedEvents;
+    }
+
+    QString output;
+    QXmlStreamWriter stream(&output);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+    stream.writeStartElement("profile");
+    stream.writeAttribute("enabled", isEnabled() ? "true" : "false");
+    stream.writeAttribute("traceEvents", QString::number(events));
+    stream.writeAttribute("droppedEvents", QString::number(dropped));
+
+    for (auto it = timings.cbegin(); it != timings.cend(); ++it)
+    {
+        const Timing &timing = it.value();
+        stream.writeStartElement("timer");
+        stream.writeAttribute("name", QString::fromLatin1(it.key()));
+        stream.writeAttribute("count", QString::number(timing.count));
+        stream.writeAttribute("total_ms", QString::number(toMilliseconds(timing.total), 'f', 3));
+        stream.writeAttribute("mean_ms", QString::number(toMilliseconds(timing.total) / timing.count, 'f', 3));
+        stream.writeAttribute("min_ms", QString::number(toMilliseconds(timing.min), 'f', 3));
+        stream.writeAttribute("max_ms", QString::number(toMilliseconds(timing.max), 'f', 3));
+        stream.writeEndElement(); // timer
+    }
+
+    for (auto it = counters.cbegin(); it != counters.cend(); ++it)
+    {
+        stream.writeStartElement("counter");
+        stream.writeAttribute("name", QString::fromLatin1(it.key()));
+        stream.writeAttribute("value", QString::number(it.value()));
+        stream.writeEndElement(); // counter
+    }
+
+    stream.writeEndElement(); // profile
+    stream.writeEndDocument();
+    return output;
+}
+
+bool KSProfiler::writeTrace(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qCWarning(KSTARS) << "Failed to write profiler trace to" << fileName << file.errorString();
+        return false;
+    }
+
+    ProfileData &data = profileData();
+    QMutexLocker locker(&data.mutex);
+
+    // Chrome trace event format, complete events with microsecond timestamps
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (int i = 0; i < data.trace.size(); i++)
+    {
+        const TraceEvent &event = data.trace[i];
+        out << (i ? ",\n" : "\n")
+            << "{\"name\":\"" << event.name << "\",\"cat\":\"kstars\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << QString::number(event.start / 1e3, 'f', 3)
+            << ",\"dur\":" << QString::number(event.duration / 1e3, 'f', 3) << "}";
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    qCInfo(KSTARS) << "Wrote" << data.trace.size() << "profiler trace events to" << fileName;
+    return file.error() == QFile::NoError;
+}
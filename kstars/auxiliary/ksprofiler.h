@@ -0,0 +1,146 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+/**
+ * @class KSProfiler
+ * @short Lightweight timers and counters for startup, update and draw phases.
+ *
+ * The profiler is always compiled in. While it is disabled, a scoped timer or a counter
+ * costs a single relaxed atomic load. It is enabled at startup by setting the KSTARS_PROFILE
+ * environment variable, or at any time over D-Bus on /KStars/Profiler.
+ *
+ * Timers are accumulated per name (count, total, min, max). While enabled, each timed
+ * scope is also kept as a trace event which can be saved as Chrome trace JSON and
+ * opened in chrome://tracing or Perfetto. Cache hit rates are reported as pairs of
+ * counters, e.g. "labels/hits" and "labels/misses".
+ *
+ * Names must be string literals or otherwise outlive the profiler. Recording is thread safe.
+ */
+class KSProfiler : public QObject
+{
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.kde.kstars.Profiler")
+
+    public:
+        /**
+         * @class Scope
+         * @short Times the enclosing scope under the given name.
+         */
+        class Scope
+        {
+            public:
+                explicit Scope(const char *name) : m_Name(name), m_Start(isEnabled() ? now() : -1) {}
+                ~Scope()
+                {
+                    if (m_Start >= 0)
+                        record(m_Name, m_Start, now());
+                }
+
+            private:
+                Q_DISABLE_COPY(Scope)
+                const char *m_Name;
+                qint64 m_Start;
+        };
+
+        /**
+         * @class Stages
+         * @short Times consecutive stages of a sequence, e.g. the layers of a draw cycle.
+         * Each call to enter() closes the current stage and opens the next one, which is
+         * recorded as "group/stage". The last stage is closed by the destructor.
+         */
+        class Stages
+        {
+            public:
+                explicit Stages(const char *group) : m_Group(group) {}
+                ~Stages()
+                {
+                    close();
+                }
+
+                void enter(const char *stage)
+                {
+                    close();
+                    if (isEnabled())
+                    {
+                        m_Stage = stage;
+                        m_Start = now();
+                    }
+                }
+
+            private:
+                Q_DISABLE_COPY(Stages)
+                void close();
+
+                const char *m_Group;
+                const char *m_Stage { nullptr };
+                qint64 m_Start { -1 };
+        };
+
+        /** @return the D-Bus facing instance, created on first use. Call it first from the GUI thread. */
+        static KSProfiler *Instance();
+
+        /** @return true if timers and counters are being recorded */
+        static bool isEnabled()
+        {
+            return s_Enabled.load(std::memory_order_relaxed);
+        }
+
+        /** @short Add @p value to the counter @p name */
+        static void count(const char *name, qint64 value = 1)
+        {
+            if (isEnabled())
+                addCount(name, value);
+        }
+
+        /** @short Add a duration measured elsewhere, in nanoseconds, to the timer @p name */
+        static void addTime(const char *name, qint64 nsecs)
+        {
+            if (isEnabled())
+                addDuration(name, nsecs);
+        }
+
+        /** @return monotonic time in nanoseconds */
+        static qint64 now();
+
+        /** DBUS interface function. Start or stop recording. */
+        Q_SCRIPTABLE Q_NOREPLY void setEnabled(bool enabled);
+
+        /** DBUS interface function. @return true if recording. */
+        Q_SCRIPTABLE bool enabled() const;
+
+        /** DBUS interface function. Drop all recorded timers, counters and trace events. */
+        Q_SCRIPTABLE Q_NOREPLY void reset();
+
+        /**
+         * DBUS interface function. @return an XML document with all timers (in milliseconds) and counters,
+         * sorted by name.
+         */
+        Q_SCRIPTABLE QString report() const;
+
+        /**
+         * DBUS interface function. Save the recorded trace events as Chrome trace JSON.
+         * @param fileName path of the JSON file to write
+         * @return true if the file was written
+         */
+        Q_SCRIPTABLE bool writeTrace(const QString &fileName) const;
+
+    private:
+        KSProfiler();
+
+        static void record(const char *name, qint64 start, qint64 end);
+        static void addCount(const char *name, qint64 value);
+        static void addDuration(const char *name, qint64 nsecs);
+
+        static std::atomic<bool> s_Enabled;
+};
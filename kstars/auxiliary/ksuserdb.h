@@ -164,7 +164,7 @@ class KSUserDB
         /** @brief Deletes all image overlay rows from the database **/
         bool DeleteAllImageOverlays();
 
-        /** @brief Adds a new image overlay row into the database **/
+        /** @brief Adds a new image overlay row into the database, or updates the row of the same file **/
         bool AddImageOverlay(const ImageOverlay &overlay);
 
         /** @brief Gets all the image overlay rows from the database **/
@@ -0,0 +1,144 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skyrendercontext.h"
+
+#include "kstarsdata.h"
+#include "ksutils.h"
+#include "Options.h"
+#include "skymap.h"
+#include "skyqpainter.h"
+#include "projections/azimuthalequidistantprojector.h"
+#include "projections/equirectangularprojector.h"
+#include "projections/gnomonicprojector.h"
+#include "projections/lambertprojector.h"
+#include "projections/orthographicprojector.h"
+#include "projections/stereographicprojector.h"
+#include "skycomponents/skymapcomposite.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <kstars_debug.h>
+
+namespace
+{
+Projector *createProjector(const ViewParams &p)
+{
+    switch (Options::projection())
+    {
+        case Projector::Gnomonic:
+            return new GnomonicProjector(p);
+        case Projector::Stereographic:
+            return new StereographicProjector(p);
+        case Projector::Orthographic:
+            return new OrthographicProjector(p);
+        case Projector::AzimuthalEquidistant:
+            return new AzimuthalEquidistantProjector(p);
+        case Projector::Equirectangular:
+            return new EquirectangularProjector(p);
+        case Projector::Lambert:
+        default:
+            return new LambertProjector(p);
+    }
+}
+
+/** Sets the options read by the sky components while drawing, and restores them afterwards */
+class ChartOptions
+{
+    public:
+        explicit ChartOptions(double zoomFactor)
+            : m_ZoomFactor(Options::zoomFactor()), m_UseAltAz(Options::useAltAz()), m_ShowGround(Options::showGround())
+        {
+            Options::setZoomFactor(zoomFactor);
+            Options::setUseAltAz(false);
+            Options::setShowGround(false);
+        }
+        ~ChartOptions()
+        {
+            Options::setZoomFactor(m_ZoomFactor);
+            Options::setUseAltAz(m_UseAltAz);
+            Options::setShowGround(m_ShowGround);
+        }
+
+    private:
+        double m_ZoomFactor;
+        bool m_UseAltAz;
+        bool m_ShowGround;
+};
+}
+
+SkyRenderContext::SkyRenderContext(const QSize &size) : m_Size(size)
+{
+}
+
+SkyRenderContext::~SkyRenderContext() = default;
+
+double SkyRenderContext::zoomFactor() const
+{
+    const double zoom = qMax(m_Size.width(), m_Size.height()) / (m_FieldOfView * dms::DegToRad);
+    return KSUtils::clamp(zoom, MINZOOM, MAXZOOM);
+}
+
+ViewParams SkyRenderContext::viewParams()
+{
+    ViewParams p;
+    p.focus         = &m_Center;
+    p.width         = m_Size.width();
+    p.height        = m_Size.height();
+    p.zoomFactor    = zoomFactor();
+    p.useAltAz      = false;
+    p.useRefraction = false;
+    p.fillGround    = false;
+    p.rotationAngle = dms(0);
+    return p;
+}
+
+bool SkyRenderContext::render()
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    SkyMap *map      = SkyMap::Instance();
+    KStarsData *data = KStarsData::Instance();
+    if (map == nullptr || data == nullptr || data->skyComposite() == nullptr || m_Size.isEmpty())
+    {
+        qCWarning(KSTARS) << "Sky is not available for offscreen rendering";
+        return false;
+    }
+
+    // Labels and the horizontal coordinates of a few components still use the focus alt/az
+    m_Center.EquatorialToHorizontal(data->lst(), data->geo()->lat());
+
+    const ViewParams p = viewParams();
+    if (m_Projector && m_Projector->type() == static_cast<Projector::Projection>(Options::projection()))
+        m_Projector->setViewParams(p);
+    else
+        m_Projector.reset(createProjector(p));
+
+    m_Image = QImage(m_Size, QImage::Format_ARGB32_Premultiplied);
+
+    ChartOptions options(p.zoomFactor);
+    Projector *mapProjector = map->swapProjector(m_Projector.get());
+
+    SkyQPainter painter(&m_Image);
+    painter.begin();
+    // Same as image export, vector stars look better and time is not critical
+    painter.setVectorStars(true);
+    painter.setRenderHint(QPainter::Antialiasing, Options::useAntialias());
+    painter.drawSkyBackground();
+    data->skyComposite()->draw(&painter);
+    painter.end();
+
+    map->swapProjector(mapProjector);
+    return true;
+}
+
+QImage SkyRenderContext::takeImage()
+{
+    QImage image;
+    image.swap(m_Image);
+    return image;
+}
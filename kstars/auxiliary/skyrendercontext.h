@@ -0,0 +1,94 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "skyobjects/skypoint.h"
+
+#include <QImage>
+#include <QSize>
+
+#include <memory>
+
+class Projector;
+class ViewParams;
+
+/**
+ * @class SkyRenderContext
+ * @short Headless rendering of a view of the sky into an image.
+ *
+ * A render context has its own size, center, field of view and projector, and draws into
+ * its own QImage without touching the SkyMap widget. Several contexts may exist at the same
+ * time. Charts are drawn in equatorial coordinates with north up and no ground, using the
+ * current projection, color scheme and display options.
+ *
+ * The sky components are shared with the sky map and are not reentrant, so render() must be
+ * called from the GUI thread. The time of the chart is the current simulation time.
+ * The resulting image may be handed over to another thread.
+ */
+class SkyRenderContext
+{
+    public:
+        explicit SkyRenderContext(const QSize &size = QSize(800, 800));
+        ~SkyRenderContext();
+
+        /** @short Set the size of the image in pixels */
+        void setSize(const QSize &size)
+        {
+            m_Size = size;
+        }
+        QSize size() const
+        {
+            return m_Size;
+        }
+
+        /** @short Center the view on @p center. Its apparent coordinates (RA, Dec) are used. */
+        void setCenter(const SkyPoint &center)
+        {
+            m_Center = center;
+        }
+        const SkyPoint &center() const
+        {
+            return m_Center;
+        }
+
+        /** @short Set the field of view across the larger dimension of the image, in degrees */
+        void setFieldOfView(double degrees)
+        {
+            m_FieldOfView = degrees;
+        }
+        double fieldOfView() const
+        {
+            return m_FieldOfView;
+        }
+
+        /** @return the zoom factor of the view, in pixels per radian */
+        double zoomFactor() const;
+
+        /**
+         * @short Draw the sky into the image of the context.
+         * @return false if the sky map or the sky components are not available
+         */
+        bool render();
+
+        /** @return the last rendered image */
+        const QImage &image() const
+        {
+            return m_Image;
+        }
+
+        /** @return the last rendered image, leaving the context without an image */
+        QImage takeImage();
+
+    private:
+        ViewParams viewParams();
+
+        QSize m_Size;
+        SkyPoint m_Center;
+        double m_FieldOfView { 1.0 };
+        QImage m_Image;
+        std::unique_ptr<Projector> m_Projector;
+};
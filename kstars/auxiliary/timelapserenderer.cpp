@@ -0,0 +1,187 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "timelapserenderer.h"
+
+#ifndef KSTARS_LITE
+#include "timelapseadaptor.h"
+
+#include <QDBusConnection>
+#endif
+
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "Options.h"
+#include "simclock.h"
+#include "skymap.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skycomponents/solarsystemcomposite.h"
+#include "skycomponents/solarsystemsinglecomponent.h"
+#include "skyobjects/ephemeristable.h"
+#include "skyobjects/ksplanet.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QImage>
+#include <QQueue>
+#include <QSignalBlocker>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <kstars_debug.h>
+
+#include <cmath>
+
+namespace
+{
+/** Parse an ISO 8601 time, times without an offset are UTC */
+QDateTime parseUTC(const QString &utc)
+{
+    QDateTime dt = QDateTime::fromString(utc.trimmed(), Qt::ISODate);
+    if (dt.timeSpec() == Qt::LocalTime)
+        dt.setTimeSpec(Qt::UTC);
+    else
+        dt = dt.toUTC();
+    return dt;
+}
+
+/** Keep the focus of the sky map on the tracked object, or on the same horizontal or equatorial point */
+void updateFocus(SkyMap *map, KStarsData *data)
+{
+    if (Options::isTracking() && map->focusObject())
+    {
+        map->focusObject()->updateCoordsNow(data->updateNum());
+        map->setFocus(map->focusObject());
+    }
+    else if (Options::useAltAz())
+        map->focus()->HorizontalToEquatorial(data->lst(), data->geo()->lat());
+    else
+        map->focus()->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+}
+}
+
+TimeLapseRenderer *TimeLapseRenderer::Instance()
+{
+    static TimeLapseRenderer *instance = new TimeLapseRenderer();
+    return instance;
+}
+
+TimeLapseRenderer::TimeLapseRenderer()
+{
+#ifndef KSTARS_LITE
+    new TimeLapseAdaptor(this);
+    QDBusConnection::sessionBus().registerObject("/KStars/TimeLapse", this);
+#endif
+}
+
+int TimeLapseRenderer::render(const KStarsDateTime &start, const KStarsDateTime &end, double stepSeconds,
+                              const QString &directory, const QSize &size)
+{
+    KStarsData *data = KStarsData::Instance();
+    SkyMap *map      = SkyMap::Instance();
+    if (data == nullptr || map == nullptr || data->skyComposite() == nullptr)
+        return -1;
+
+    if (!start.isValid() || !end.isValid() || end < start || stepSeconds <= 0)
+    {
+        qCWarning(KSTARS) << "Invalid time-lapse range" << start << end << stepSeconds;
+        return -1;
+    }
+
+    if (!QDir().mkpath(directory))
+    {
+        qCWarning(KSTARS) << "Unable to create time-lapse directory" << directory;
+        return -1;
+    }
+
+    const double stepDays = stepSeconds / 86400.0;
+    const int frames      = static_cast<int>(std::floor((end.djd() - start.djd()) / stepDays)) + 1;
+    const QSize mapSize   = map->size();
+    const QSize frameSize = size.isEmpty() ? mapSize : size;
+    if (mapSize.isEmpty())
+        return -1;
+
+    const KStarsDateTime startUT = data->ut();
+    const bool clockActive       = data->clock()->isActive();
+    if (clockActive)
+        data->clock()->stop();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QList<KSPlanetBase *> bodies;
+    for (SolarSystemSingleComponent *component : data->skyComposite()->solarSystemComposite()->planets())
+        bodies.append(component->planet());
+    KSPlanet *earth = data->skyComposite()->earth();
+    EphemerisTable::setActive(EphemerisTable::build(bodies, earth, start.djd(), end.djd(), stepDays));
+
+    qCInfo(KSTARS) << "Tabulated solar system for" << frames << "frames in" << timer.elapsed() << "ms";
+
+    // Bounds the number of frames waiting to be written
+    const int maxPending = 2 * QThreadPool::globalInstance()->maxThreadCount();
+    QQueue<QFuture<bool>> pending;
+    int written = 0;
+
+    {
+        // Neither repaint the sky map nor update the sky at each time change, frames are drawn here
+        const QSignalBlocker dataBlocker(data);
+        const QSignalBlocker clockBlocker(data->clock());
+
+        data->setFullTimeUpdate();
+        for (int i = 0; i < frames; i++)
+        {
+            data->clock()->setUTC(KStarsDateTime(start.djd() + i * static_cast<long double>(stepDays)));
+            data->updateTime(data->geo(), false);
+            data->syncUpdateIDs();
+
+            updateFocus(map, data);
+            map->setupProjector();
+
+            QImage image(mapSize, QImage::Format_ARGB32_Premultiplied);
+            map->exportSkyImage(&image);
+
+            const QString fileName = QDir(directory).filePath(QString("frame_%1.png").arg(i, 5, 10, QChar('0')));
+            pending.enqueue(QtConcurrent::run([image, frameSize, fileName]()
+            {
+                const QImage frame = image.size() == frameSize ? image :
+                                     image.scaled(frameSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                const bool saved = frame.save(fileName);
+                if (!saved)
+                    qCWarning(KSTARS) << "Unable to save time-lapse frame" << fileName;
+                return saved;
+            }));
+
+            while (pending.size() >= maxPending)
+                written += pending.dequeue().result() ? 1 : 0;
+        }
+    }
+
+    while (!pending.isEmpty())
+        written += pending.dequeue().result() ? 1 : 0;
+
+    EphemerisTable::setActive(nullptr);
+
+    data->changeDateTime(startUT);
+    data->updateTime(data->geo(), false);
+    if (clockActive)
+        data->clock()->start();
+    map->forceUpdate();
+
+    qCInfo(KSTARS) << "Rendered" << written << "of" << frames << "time-lapse frames in" << timer.elapsed() << "ms";
+    return written;
+}
+
+int TimeLapseRenderer::renderTimeLapse(const QString &startUTC, const QString &endUTC, double stepSeconds,
+                                       const QString &directory, int width, int height)
+{
+    const QDateTime start = parseUTC(startUTC);
+    const QDateTime end   = parseUTC(endUTC);
+    if (!start.isValid() || !end.isValid())
+        return -1;
+
+    return render(KStarsDateTime(start), KStarsDateTime(end), stepSeconds, directory, QSize(width, height));
+}
@@ -0,0 +1,61 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QSize>
+#include <QString>
+
+class KStarsDateTime;
+
+/**
+ * @class TimeLapseRenderer
+ * @short Renders the sky map as an image sequence over a time range.
+ *
+ * Before drawing, the positions of the Sun, the Moon and the major planets are tabulated over the
+ * whole range on the global thread pool (see EphemerisTable), so that each frame only interpolates
+ * them. Frames are drawn like an exported sky image, with the current view, projection and
+ * display options, following the focus object when tracking. They are written to
+ * "frame_00000.png", "frame_00001.png"... in the output directory, ready to be encoded by an
+ * external tool such as ffmpeg.
+ *
+ * Time-lapses are requested over D-Bus on /KStars/TimeLapse.
+ */
+class TimeLapseRenderer : public QObject
+{
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.kde.kstars.TimeLapse")
+
+    public:
+        /** @return the D-Bus facing instance, created on first use */
+        static TimeLapseRenderer *Instance();
+
+        /**
+         * @short Render frames from @p start to @p end, every @p stepSeconds of simulation time.
+         * The simulation clock is paused during the time-lapse and restored afterwards.
+         * @param size size of the frames, the sky map size if empty
+         * @return number of frames written, or -1 if the parameters are invalid
+         */
+        int render(const KStarsDateTime &start, const KStarsDateTime &end, double stepSeconds,
+                   const QString &directory, const QSize &size = QSize());
+
+        /**
+         * DBUS interface function. Render a time-lapse.
+         * @param startUTC ISO date and time of the first frame
+         * @param endUTC ISO date and time of the last frame
+         * @param stepSeconds simulation time between frames, in seconds
+         * @param directory directory where the frames are written, created if needed
+         * @param width width of the frames in pixels, 0 for the sky map width
+         * @param height height of the frames in pixels, 0 for the sky map height
+         * @return number of frames written, or -1 if the parameters are invalid
+         */
+        Q_SCRIPTABLE int renderTimeLapse(const QString &startUTC, const QString &endUTC, double stepSeconds,
+                                         const QString &directory, int width, int height);
+
+    private:
+        TimeLapseRenderer();
+};
@@ -0,0 +1,64 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "updatescheduler.h"
+
+#include "Options.h"
+#include "dms.h"
+
+#include <QtGlobal>
+
+namespace
+{
+constexpr double ArcsecPerRadian = 3600.0 / dms::DegToRad;
+constexpr double OneMinute       = 1.0 / 1440.0;
+}
+
+double UpdateScheduler::maxRate(ObjectClass objectClass)
+{
+    switch (objectClass)
+    {
+        case FixedObjects:
+            // Aberration 0.36", precession 0.14" and nutation 0.1" per day at most, with a margin
+            return 1.0;
+        case SolarSystemBodies:
+            // Mercury and close asteroids, up to about 3 degrees per day
+            return 3 * 3600.0;
+        case Moons:
+            // The Moon including its diurnal parallax, about 20 degrees per day
+            return 20 * 3600.0;
+        case HorizontalCoordinates:
+            // One sidereal rotation per sidereal day
+            return 360.9856 * 3600.0;
+    }
+    return 0;
+}
+
+double UpdateScheduler::interval(ObjectClass objectClass, double zoomFactor, double tolerance)
+{
+    if (zoomFactor <= 0)
+        return 0;
+
+    const double arcsecPerPixel = ArcsecPerRadian / zoomFactor;
+    const double days           = tolerance * arcsecPerPixel / maxRate(objectClass);
+
+    switch (objectClass)
+    {
+        case FixedObjects:
+            if (Options::alwaysRecomputeCoordinates())
+                return 0;
+            // The update number is renewed with the catalogs, positions found from it on demand
+            // such as those of D-Bus object queries must not get older than a day
+            return qBound(OneMinute, days, 1.0);
+        case SolarSystemBodies:
+            return qBound(OneMinute, days, 1.0);
+        case Moons:
+            return qBound(OneMinute, days, 0.1);
+        case HorizontalCoordinates:
+            return days;
+    }
+    return days;
+}
@@ -0,0 +1,48 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+/**
+ * @class UpdateScheduler
+ * @short Decides how often each class of sky objects is recomputed as time advances.
+ *
+ * Each class of objects has an upper bound of the apparent motion of its objects. The update
+ * interval of a class is the simulation time it takes for that motion to reach a fraction of a
+ * pixel at the current zoom factor. Classes are recomputed by KStarsData::updateTime() only once
+ * their interval has elapsed, so at low zoom the catalogs are precessed once per simulated day
+ * as before, while at high zoom they follow the sky closely.
+ *
+ * The focused object is updated on its own by the sky map when tracking, so the solar system
+ * bodies are never recomputed more than once per simulated minute.
+ */
+class UpdateScheduler
+{
+    public:
+        enum ObjectClass
+        {
+            /// Stars and deep sky objects: precession, nutation and aberration
+            FixedObjects,
+            /// Sun, planets, asteroids and comets
+            SolarSystemBodies,
+            /// The Moon and the moons of the planets
+            Moons,
+            /// Horizontal coordinates of all objects, following the rotation of the Earth
+            HorizontalCoordinates
+        };
+
+        /** Largest apparent position error allowed between updates, in pixels */
+        static constexpr double Tolerance = 0.5;
+
+        /** @return an upper bound of the apparent motion of objects of @p objectClass, in arcseconds per day */
+        static double maxRate(ObjectClass objectClass);
+
+        /**
+         * @return the time in days during which the apparent position of objects of @p objectClass
+         * moves by less than @p tolerance pixels at @p zoomFactor, in pixels per radian
+         */
+        static double interval(ObjectClass objectClass, double zoomFactor, double tolerance = Tolerance);
+};
@@ -35,6 +35,7 @@
 #include "ekos/auxiliary/profilesettings.h"
 #include "ekos/auxiliary/opticaltrainmanager.h"
 #include "ekos/auxiliary/opticaltrainsettings.h"
+#include "ekos/auxiliary/solverservice.h"
 #include "ksnotification.h"
 #include "kspaths.h"
 #include "fov.h"
@@ -213,15 +214,11 @@ Align::Align(const QSharedPointer<ProfileInfo> &activeProfile) : m_ActiveProfile
     for (auto &button : qButtons)
         button->setAutoDefault(false);
 
-    savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                    QStandardPaths::AppLocalDataLocation)).filePath("SavedAlignProfiles.ini");
-    if(QFile(savedOptionsProfiles).exists())
-        m_StellarSolverProfiles = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        m_StellarSolverProfiles = getDefaultAlignOptionsProfiles();
+    m_StellarSolverProfiles = getOptionsProfiles(AlignProfiles);
 
     m_StellarSolver.reset(new StellarSolver());
     connect(m_StellarSolver.get(), &StellarSolver::logOutput, this, &Align::appendLogText);
+    SolverService::Instance()->addForegroundSolver(m_StellarSolver.get());
 
     setupPolarAlignmentAssistant();
     setupManualRotator();
@@ -1794,6 +1791,9 @@ void Align::startSolving()
         m_StellarSolver->setProperty("SolverType", Options::solverType());
         connect(m_StellarSolver.get(), &StellarSolver::ready, this, &Align::solverComplete);
         m_StellarSolver->setIndexFolderPaths(Options::astrometryIndexFolderList());
+        // Index files of the last solved field, set below when solving near it
+        m_StellarSolver->setIndexFilePaths(QStringList());
+        m_UsedIndexHint = false;
 
         auto params = m_StellarSolverProfiles.at(Options::solveOptionsProfile());
         params.partition = Options::stellarSolverPartition();
@@ -1890,7 +1890,17 @@ void Align::startSolving()
                 m_StellarSolver->setProperty("UseScale", false);
             //Setting the initial search location settings
             if(useImagePosition)
+            {
                 m_StellarSolver->setSearchPositionInDegrees(m_TelescopeCoord.ra().Degrees(), m_TelescopeCoord.dec().Degrees());
+
+                const QStringList indexFiles = SolverService::Instance()->indexFilesNear(m_TelescopeCoord.ra().Degrees(),
+                                               m_TelescopeCoord.dec().Degrees(), expectedPixelScale());
+                if (!indexFiles.isEmpty())
+                {
+                    m_StellarSolver->setIndexFilePaths(indexFiles);
+                    m_UsedIndexHint = true;
+                }
+            }
             else
                 m_StellarSolver->setProperty("UsePosition", false);
         }
@@ -1933,11 +1943,47 @@ void Align::startSolving()
     emit newStatus(state);
 }
 
+double Align::expectedPixelScale() const
+{
+    if (Options::astrometryUseImageScale() && !Options::astrometryAutoUpdateImageScale())
+    {
+        // Middle of the search range set by the user
+        const double scale = (Options::astrometryImageScaleLow() + Options::astrometryImageScaleHigh()) / 2;
+        const double width = m_ImageData ? m_ImageData->width() : 0;
+        switch (Options::astrometryImageScaleUnits())
+        {
+            case SSolver::ARCSEC_PER_PIX:
+                return scale;
+            case SSolver::ARCMIN_WIDTH:
+                return width > 0 ? scale * 60 / width : 0;
+            case SSolver::DEG_WIDTH:
+                return width > 0 ? scale * 3600 / width : 0;
+            default:
+                return 0;
+        }
+    }
+
+    return m_FOVPixelScale;
+}
+
 void Align::solverComplete()
 {
     disconnect(m_StellarSolver.get(), &StellarSolver::ready, this, &Align::solverComplete);
     if(!m_StellarSolver->solvingDone() || m_StellarSolver->failed())
     {
+        if (m_UsedIndexHint)
+        {
+            SolverService::Instance()->clearHint();
+
+            // The field may have moved out of the hinted index files, try once more with all of them
+            appendLogText(i18n("Solver failed with the index files of the last solution, retrying with all index files."));
+            m_UsedIndexHint = false;
+            m_StellarSolver->setIndexFilePaths(QStringList());
+            connect(m_StellarSolver.get(), &StellarSolver::ready, this, &Align::solverComplete);
+            m_StellarSolver->start();
+            return;
+        }
+
         // If processed, we retruned. Otherwise, it is a fail
         if (CHECK_PAH(processSolverFailure()))
             return;
@@ -1947,6 +1993,8 @@ void Align::solverComplete()
     else
     {
         FITSImage::Solution solution = m_StellarSolver->getSolution();
+        SolverService::Instance()->solveSucceeded(solution, m_StellarSolver->getSolutionIndexNumber(),
+                m_StellarSolver->getSolutionHealpix());
         const bool eastToTheRight = solution.parity == FITSImage::POSITIVE ? false : true;
         solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, eastToTheRight);
     }
@@ -2367,6 +2415,8 @@ bool Align::checkIfRotationRequired()
 void Align::stop(Ekos::AlignState mode)
 {
     m_CaptureTimer.stop();
+    // A stopped solve is not retried without the index hint
+    m_UsedIndexHint = false;
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
         m_StellarSolver->abort();
     else if (solverModeButtonGroup->checkedId() == SOLVER_REMOTE && remoteParser)
@@ -3367,10 +3417,7 @@ void Align::setupOptions()
     page = dialog->addPage(optionsProfileEditor, i18n("Align Options Profiles Editor"));
     connect(optionsProfileEditor, &StellarSolverProfileEditor::optionsProfilesUpdated, this, [this]()
     {
-        if(QFile(savedOptionsProfiles).exists())
-            m_StellarSolverProfiles = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-        else
-            m_StellarSolverProfiles = getDefaultAlignOptionsProfiles();
+        m_StellarSolverProfiles = getOptionsProfiles(AlignProfiles);
         opsAlign->reloadOptionsProfiles();
     });
     page->setIcon(QIcon::fromTheme("configure"));
@@ -660,6 +660,11 @@ class Align : public QWidget, public Ui::Align
             */
         void calculateFOV();
 
+        /**
+            * @brief Image scale in arcsec per pixel expected for the next solve, 0 if unknown.
+            */
+        double expectedPixelScale() const;
+
         /**
          * @brief calculateEffectiveFocalLength Calculate Focal Length purely form astrometric data.
          */
@@ -691,7 +696,6 @@ class Align : public QWidget, public Ui::Align
         void resizeEvent(QResizeEvent *event) override;
 
         KPageWidgetItem *m_IndexFilesPage;
-        QString savedOptionsProfiles;
 
         /**
          * @brief React when a mount motion has been detected
@@ -753,6 +757,8 @@ class Align : public QWidget, public Ui::Align
         BlindState useBlindScale {BLIND_IDLE};
         /// Was solving with position off used?
         BlindState useBlindPosition {BLIND_IDLE};
+        /// Were the index files of the last solved field used?
+        bool m_UsedIndexHint { false };
 
         // FOV
         double m_CameraPixelWidth { -1 };
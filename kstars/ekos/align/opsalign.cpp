@@ -56,13 +56,7 @@ void OpsAlign::setFlipPolicy(const Ekos::OpsAlign::FlipPriority Priority)
 
 void OpsAlign::reloadOptionsProfiles()
 {
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                            QStandardPaths::AppLocalDataLocation)).filePath("SavedAlignProfiles.ini");
-
-    if(QFile(savedOptionsProfiles).exists())
-        optionsList = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        optionsList = getDefaultAlignOptionsProfiles();
+    optionsList = getOptionsProfiles(AlignProfiles);
     int currentIndex = kcfg_SolveOptionsProfile->currentIndex();
     kcfg_SolveOptionsProfile->clear();
     for(auto &param : optionsList)
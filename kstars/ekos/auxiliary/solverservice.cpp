@@ -0,0 +1,231 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "solverservice.h"
+
+#include "solverutils.h"
+#include "Options.h"
+
+#include <QtConcurrent>
+
+#include <ekos_align_debug.h>
+
+#include <cmath>
+
+namespace
+{
+// Hints are used within this distance of the solved field center, even for narrow fields
+constexpr double MIN_HINT_RADIUS = 1.0;
+// Hints are used for image scales within this fraction of the solved scale
+constexpr double HINT_SCALE_TOLERANCE = 0.2;
+constexpr qint64 PAGE_SIZE = 4096;
+
+/** @return angular distance between two positions, in degrees */
+double angularDistance(double ra1, double dec1, double ra2, double dec2)
+{
+    constexpr double toRadians = M_PI / 180.0;
+    const double sinDDec = std::sin((dec2 - dec1) * toRadians / 2);
+    const double sinDRa = std::sin((ra2 - ra1) * toRadians / 2);
+    const double a = sinDDec * sinDDec + std::cos(dec1 * toRadians) * std::cos(dec2 * toRadians) * sinDRa * sinDRa;
+    return 2 * std::asin(std::min(1.0, std::sqrt(a))) / toRadians;
+}
+}
+
+SolverService *SolverService::m_Instance = nullptr;
+
+SolverService *SolverService::Instance()
+{
+    if (m_Instance == nullptr)
+        m_Instance = new SolverService();
+    return m_Instance;
+}
+
+void SolverService::release()
+{
+    delete m_Instance;
+    m_Instance = nullptr;
+}
+
+SolverService::SolverService()
+{
+}
+
+SolverService::~SolverService()
+{
+    releaseResident();
+}
+
+QStringList SolverService::indexFilesNear(double raDegrees, double decDegrees, double pixscale) const
+{
+    if (!m_Hint.valid || Options::solverType() != SSolver::SOLVER_STELLARSOLVER)
+        return QStringList();
+
+    if (pixscale > 0 && m_Hint.pixscale > 0 && std::fabs(pixscale / m_Hint.pixscale - 1) > HINT_SCALE_TOLERANCE)
+        return QStringList();
+
+    if (angularDistance(raDegrees, decDegrees, m_Hint.ra, m_Hint.dec) > m_Hint.radius)
+        return QStringList();
+
+    return m_Hint.files;
+}
+
+void SolverService::solveSucceeded(const FITSImage::Solution &solution, int indexNumber, int healpix)
+{
+    // The fields of a batch are unrelated, and each new hint would remap the index files on the GUI thread
+    if (batchSolving())
+        return;
+
+    // Index numbers are only reported by the internal solver
+    if (Options::solverType() != SSolver::SOLVER_STELLARSOLVER || indexNumber < 0)
+    {
+        clearHint();
+        return;
+    }
+
+    const bool sameFiles = m_Hint.valid && m_Hint.indexNumber == indexNumber && m_Hint.healpix == healpix;
+
+    m_Hint.ra = solution.ra;
+    m_Hint.dec = solution.dec;
+    m_Hint.pixscale = solution.pixscale;
+    // Half the diagonal of the field
+    m_Hint.radius = std::max(MIN_HINT_RADIUS, std::hypot(solution.fieldWidth, solution.fieldHeight) / 120.0);
+    if (sameFiles)
+        return;
+
+    m_Hint.indexNumber = indexNumber;
+    m_Hint.healpix = healpix;
+    m_Hint.files = StellarSolver::getIndexFiles(Options::astrometryIndexFolderList(), indexNumber, healpix);
+    m_Hint.valid = !m_Hint.files.isEmpty();
+
+    qCDebug(KSTARS_EKOS_ALIGN) << "Solver index hint: index" << indexNumber << "healpix" << healpix << "files" << m_Hint.files;
+    makeResident(m_Hint.files);
+}
+
+void SolverService::clearHint()
+{
+    if (!m_Hint.valid)
+        return;
+
+    qCDebug(KSTARS_EKOS_ALIGN) << "Solver index hint cleared";
+    m_Hint = Hint();
+    releaseResident();
+}
+
+void SolverService::makeResident(const QStringList &files)
+{
+    releaseResident();
+
+    qint64 budget = static_cast<qint64>(Options::solverIndexResidentSize()) * 1024 * 1024;
+    QList<QPair<const uchar *, qint64>> maps;
+    for (const auto &filename : files)
+    {
+        std::unique_ptr<QFile> file(new QFile(filename));
+        if (file->size() > budget || !file->open(QIODevice::ReadOnly))
+            continue;
+
+        const uchar *data = file->map(0, file->size());
+        if (data == nullptr)
+            continue;
+
+        budget -= file->size();
+        maps.append(qMakePair(data, file->size()));
+        m_ResidentFiles.push_back(std::move(file));
+    }
+
+    if (maps.isEmpty())
+        return;
+
+    // Touch every page once to read the files into the page cache. The mappings do not pin
+    // the pages, the kernel may still evict them under memory pressure.
+    m_StopPrefetch = false;
+    m_Prefetch = QtConcurrent::run([this, maps]()
+    {
+        quint8 sum = 0;
+        for (const auto &map : maps)
+        {
+            for (qint64 offset = 0; offset < map.second && !m_StopPrefetch; offset += PAGE_SIZE)
+                sum += map.first[offset];
+        }
+        Q_UNUSED(sum)
+    });
+}
+
+void SolverService::releaseResident()
+{
+    m_StopPrefetch = true;
+    m_Prefetch.waitForFinished();
+    // Closing the files unmaps them
+    m_ResidentFiles.clear();
+}
+
+void SolverService::addForegroundSolver(StellarSolver *solver)
+{
+    if (solver == nullptr || m_ForegroundSolvers.contains(solver))
+        return;
+
+    m_ForegroundSolvers.append(solver);
+    connect(solver, &StellarSolver::finished, this, &SolverService::startNext, Qt::QueuedConnection);
+}
+
+void SolverService::setMaxRunning(int count)
+{
+    m_MaxRunning = std::max(1, count);
+    startNext();
+}
+
+void SolverService::enqueue(SolverUtils *solver)
+{
+    if (!isQueued(solver))
+        m_Queue.enqueue(solver);
+    startNext();
+}
+
+void SolverService::finished(SolverUtils *solver)
+{
+    m_Queue.removeAll(solver);
+    if (m_Running.removeAll(solver) > 0)
+    {
+        // Not from within the signal handlers of the solver that just finished
+        QMetaObject::invokeMethod(this, &SolverService::startNext, Qt::QueuedConnection);
+    }
+}
+
+bool SolverService::isQueued(const SolverUtils *solver) const
+{
+    for (const auto &queued : m_Queue)
+    {
+        if (queued == solver)
+            return true;
+    }
+    return false;
+}
+
+bool SolverService::foregroundBusy() const
+{
+    for (const auto &solver : m_ForegroundSolvers)
+    {
+        if (solver && solver->isRunning())
+            return true;
+    }
+    return false;
+}
+
+void SolverService::startNext()
+{
+    m_Running.removeAll(nullptr);
+    if (foregroundBusy())
+        return;
+
+    while (m_Running.size() < m_MaxRunning && !m_Queue.isEmpty())
+    {
+        QPointer<SolverUtils> solver = m_Queue.dequeue();
+        if (solver)
+        {
+            m_Running.append(solver);
+            solver->startQueued();
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <stellarsolver.h>
+
+#include <QFile>
+#include <QFuture>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class SolverUtils;
+
+/**
+ * @brief Plate solving state shared by Align, the polar alignment refresh, the scheduler and the image overlays.
+ *
+ * Index hint: after a successful solve with the internal solver, the index number and healpix that solved
+ * the field are remembered. Later solves near the same field, at the same scale, load only the index files
+ * of that healpix instead of every file of the index folders. A failed solve that used the hint drops it,
+ * and is retried once with all index files. Batches of solves neither use nor update the hint.
+ *
+ * Residency: the index files of the hint are memory-mapped and read once in the background, which brings
+ * them into the page cache before the next solve maps them. Pages are not pinned and may still be evicted.
+ *
+ * Queue: SolverUtils solves run one at a time, and wait for the foreground solvers, such as the one of
+ * Align, to be idle. Foreground solvers are never delayed. Batches of independent solves, such as the
+ * image overlays, may let several queued solves run at the same time.
+ */
+class SolverService : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static SolverService *Instance();
+        static void release();
+
+        /**
+         * @brief Index files to load for a solve near a position.
+         * @param raDegrees J2000 RA of the search position
+         * @param decDegrees J2000 DEC of the search position
+         * @param pixscale expected image scale in arcsec per pixel, 0 if unknown
+         * @return the index files of the hint, or an empty list to load all the index folders
+         */
+        QStringList indexFilesNear(double raDegrees, double decDegrees, double pixscale) const;
+
+        /**
+         * @brief Record a successful solve.
+         * @param solution solution of the solve
+         * @param indexNumber index number reported by the solver, -1 if unknown
+         * @param healpix healpix reported by the solver, -1 if unknown
+         */
+        void solveSucceeded(const FITSImage::Solution &solution, int indexNumber, int healpix);
+
+        /** @brief Forget the index hint, typically after a solve that used it failed. */
+        void clearHint();
+
+        /** @brief Queued solves wait while @p solver is running. */
+        void addForegroundSolver(StellarSolver *solver);
+
+        /** @brief Let up to @p count queued solves run at the same time, 1 to run them one at a time. */
+        void setMaxRunning(int count);
+
+    private:
+        friend class SolverUtils;
+
+        SolverService();
+        ~SolverService() override;
+
+        // Queue of SolverUtils solves, only used by SolverUtils.
+        void enqueue(SolverUtils *solver);
+        void finished(SolverUtils *solver);
+        bool isQueued(const SolverUtils *solver) const;
+        // Several queued solves may run at the same time, see setMaxRunning()
+        bool batchSolving() const
+        {
+            return m_MaxRunning > 1;
+        }
+        void startNext();
+        bool foregroundBusy() const;
+
+        // Memory-map the index files of the hint, up to the resident size budget
+        void makeResident(const QStringList &files);
+        void releaseResident();
+
+        static SolverService *m_Instance;
+
+        struct Hint
+        {
+            bool valid { false };
+            double ra { 0 };
+            double dec { 0 };
+            double pixscale { 0 };
+            // Distance from the solved field center within which the hint is used, in degrees
+            double radius { 0 };
+            int indexNumber { -1 };
+            int healpix { -1 };
+            QStringList files;
+        };
+        Hint m_Hint;
+
+        std::vector<std::unique_ptr<QFile>> m_ResidentFiles;
+        std::atomic<bool> m_StopPrefetch { false };
+        QFuture<void> m_Prefetch;
+
+        QQueue<QPointer<SolverUtils>> m_Queue;
+        QList<QPointer<SolverUtils>> m_Running;
+        int m_MaxRunning { 1 };
+        QList<QPointer<StellarSolver>> m_ForegroundSolvers;
+};
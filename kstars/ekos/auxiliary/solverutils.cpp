@@ -6,6 +6,7 @@
 
 #include "solverutils.h"
 
+#include "solverservice.h"
 #include "fitsviewer/fitsdata.h"
 #include "Options.h"
 #include <QRegularExpression>
@@ -23,6 +24,7 @@ SolverUtils::SolverUtils(const SSolver::Parameters &parameters, double timeoutSe
 
 SolverUtils::~SolverUtils()
 {
+    SolverService::Instance()->finished(this);
     disconnect(&m_Watcher, &QFutureWatcher<bool>::finished, this, &SolverUtils::executeSolver);
     disconnect(&m_SolverTimer, &QTimer::timeout, this, &SolverUtils::solverTimeout);
     if (m_StellarSolver.get())
@@ -52,11 +54,20 @@ void SolverUtils::setHealpix(int indexToUse, int healpixToUse)
 
 void SolverUtils::abort()
 {
+    // A queued solve was not started yet
+    if (SolverService::Instance()->isQueued(this))
+    {
+        SolverService::Instance()->finished(this);
+        return;
+    }
+    // An aborted solve is not retried without the index hint
+    m_UsedIndexHint = false;
     if (m_StellarSolver.get()) m_StellarSolver->abort();
 }
 
 bool SolverUtils::isRunning() const
 {
+    if (SolverService::Instance()->isQueued(this)) return true;
     if (!m_StellarSolver.get()) return false;
     return m_StellarSolver->isRunning();
 }
@@ -78,6 +89,7 @@ void SolverUtils::prepareSolver()
     m_StellarSolver->setProperty("SolverType", Options::solverType());
     connect(m_StellarSolver.get(), &StellarSolver::finished, this, &SolverUtils::solverDone, Qt::UniqueConnection);
 
+    m_UsedIndexHint = false;
     if (m_IndexToUse >= 0)
     {
         // The would only have an effect if Options::solverType() == SOLVER_STELLARSOLVER
@@ -86,7 +98,17 @@ void SolverUtils::prepareSolver()
         m_StellarSolver->setIndexFilePaths(indexFiles);
     }
     else
-        m_StellarSolver->setIndexFolderPaths(Options::astrometryIndexFolderList());
+    {
+        QStringList indexFiles;
+        if (m_UsePosition && m_UseIndexHint && !SolverService::Instance()->batchSolving())
+            indexFiles = SolverService::Instance()->indexFilesNear(m_raDegrees, m_decDegrees,
+                         m_UseScale ? (m_ScaleLowArcsecPerPixel + m_ScaleHighArcsecPerPixel) / 2 : 0);
+        m_UsedIndexHint = !indexFiles.isEmpty();
+        if (m_UsedIndexHint)
+            m_StellarSolver->setIndexFilePaths(indexFiles);
+        else
+            m_StellarSolver->setIndexFolderPaths(Options::astrometryIndexFolderList());
+    }
 
     // External program paths
     ExternalProgramPaths externalPaths;
@@ -145,16 +167,27 @@ void SolverUtils::prepareSolver()
 }
 
 void SolverUtils::runSolver(const QSharedPointer<FITSData> &data)
+{
+    m_ImageData = data;
+    SolverService::Instance()->enqueue(this);
+}
+
+void SolverUtils::startQueued()
+{
+    // Somehow m_SolverTimer's elapsed time can be greater than the interval,
+    // so using this to get more exact times.
+    m_StartTime = QDateTime::currentMSecsSinceEpoch();
+    m_UseIndexHint = true;
+    startSolver();
+}
+
+void SolverUtils::startSolver()
 {
     // Limit the time the solver can run.
     m_SolverTimer.setSingleShot(true);
     m_SolverTimer.setInterval(m_TimeoutMilliseconds);
     m_SolverTimer.start();
-    // Somehow m_SolverTimer's elapsed time can be greater than the interval,
-    // so using this to get more exact times.
-    m_StartTime = QDateTime::currentMSecsSinceEpoch();
 
-    m_ImageData = data;
     prepareSolver();
     m_StellarSolver->start();
 }
@@ -175,15 +208,34 @@ SolverUtils &SolverUtils::usePosition(bool useIt, double raDegrees, double decDe
     return *this;
 }
 
+void SolverUtils::retryWithoutHint()
+{
+    // The field may have moved out of the hinted index files, try once more with all of them
+    SolverService::Instance()->clearHint();
+    m_UseIndexHint = false;
+    startSolver();
+}
+
 void SolverUtils::solverDone()
 {
-    const double elapsed = (QDateTime::currentMSecsSinceEpoch() - m_StartTime) / 1000.0;
     m_SolverTimer.stop();
 
     FITSImage::Solution solution;
     bool success = m_StellarSolver->solvingDone() && !m_StellarSolver->failed();
     if (success)
+    {
         solution = m_StellarSolver->getSolution();
+        SolverService::Instance()->solveSucceeded(solution, m_StellarSolver->getSolutionIndexNumber(),
+                m_StellarSolver->getSolutionHealpix());
+    }
+    else if (m_UsedIndexHint)
+    {
+        retryWithoutHint();
+        return;
+    }
+
+    const double elapsed = (QDateTime::currentMSecsSinceEpoch() - m_StartTime) / 1000.0;
+    SolverService::Instance()->finished(this);
     emit done(false, success, solution, elapsed);
 
     if (!m_TemporaryFilename.isEmpty())
@@ -196,7 +248,17 @@ void SolverUtils::solverTimeout()
     m_SolverTimer.stop();
 
     disconnect(m_StellarSolver.get(), &StellarSolver::finished, this, &SolverUtils::solverDone);
+    const bool usedIndexHint = m_UsedIndexHint;
     abort();
+    if (usedIndexHint)
+    {
+        // The aborted solver may still report that it finished, retry with a new one
+        m_StellarSolver.release()->deleteLater();
+        m_StellarSolver.reset(new StellarSolver());
+        retryWithoutHint();
+        return;
+    }
+    SolverService::Instance()->finished(this);
 
     FITSImage::Solution empty;
     emit done(true, false, empty, m_TimeoutMilliseconds / 1000.0);
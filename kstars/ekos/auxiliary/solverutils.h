@@ -25,6 +25,8 @@ class FITSData;
 // This is a wrapper to make calling the StellarSolver solver a bit simpler.
 // Must supply the imagedata and stellar solver parameters
 // and connect to the signals. Remote solving not supported.
+// Solves are queued by the SolverService, which also provides the index files
+// of the last solved field when solving near it.
 class SolverUtils : public QObject
 {
         Q_OBJECT
@@ -48,6 +50,12 @@ class SolverUtils : public QObject
         void newLog(const QString &logText);
 
     private:
+        friend class SolverService;
+        // Called by the SolverService when it is the turn of this solve.
+        void startQueued();
+
+        void startSolver();
+        void retryWithoutHint();
         void solverDone();
         void solverTimeout();
         void executeSolver();
@@ -70,6 +78,10 @@ class SolverUtils : public QObject
 
         int m_IndexToUse { -1 };
         int m_HealpixToUse { -1 };
+        // The index files were chosen from the SolverService hint
+        bool m_UsedIndexHint { false };
+        // False when retrying a solve that failed with the hint
+        bool m_UseIndexHint { true };
 
         bool m_UseScale { false };
         bool m_UsePosition { false };
@@ -7,9 +7,19 @@
 
 #include "stellarsolverprofile.h"
 
+#include "kspaths.h"
+
 #include <stellarsolver.h>
 #include <KLocalizedString>
 
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+
 namespace Ekos
 {
 
@@ -269,4 +279,144 @@ QList<Parameters> getDefaultHFROptionsProfiles()
     return profileList;
 }
 
+namespace
+{
+QString profilesFileName(ProfileGroup group)
+{
+    switch(group)
+    {
+        case AlignProfiles:
+            return "SavedAlignProfiles.ini";
+        case FocusProfiles:
+            return "SavedFocusProfiles.ini";
+        case GuideProfiles:
+            return "SavedGuideProfiles.ini";
+        case HFRProfiles:
+            return "SavedHFRProfiles.ini";
+    }
+    return QString();
+}
+
+QList<Parameters> defaultProfiles(ProfileGroup group)
+{
+    switch(group)
+    {
+        case AlignProfiles:
+            return getDefaultAlignOptionsProfiles();
+        case FocusProfiles:
+            return getDefaultFocusOptionsProfiles();
+        case GuideProfiles:
+            return getDefaultGuideOptionsProfiles();
+        case HFRProfiles:
+            return getDefaultHFROptionsProfiles();
+    }
+    return QList<Parameters>();
+}
+
+// Profiles of each group, read from disk on first use and kept until the saved
+// file is changed, by the profile editor or by hand.
+class ProfileCache
+{
+    public:
+        static ProfileCache &instance()
+        {
+            static ProfileCache cache;
+            return cache;
+        }
+
+        QList<Parameters> profiles(ProfileGroup group)
+        {
+            QMutexLocker locker(&m_Mutex);
+            auto it = m_Profiles.constFind(group);
+            if (it != m_Profiles.constEnd())
+                return it.value();
+
+            const QString path = getSavedOptionsProfilesPath(group);
+            const bool saved = QFileInfo::exists(path);
+            QList<Parameters> list;
+            if (saved)
+            {
+                list = StellarSolver::loadSavedOptionsProfiles(path);
+                watch(path);
+            }
+            else
+                list = defaultProfiles(group);
+
+            m_Profiles.insert(group, list);
+            m_Saved.insert(group, saved);
+            return list;
+        }
+
+        void invalidate(ProfileGroup group)
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Profiles.remove(group);
+        }
+
+    private:
+        ProfileCache()
+        {
+            // Never deleted, the watcher must outlive every user of the cache.
+            // It lives in the GUI thread, which has the event loop delivering its signals.
+            m_Watcher = new QFileSystemWatcher();
+            if (QCoreApplication::instance() != nullptr)
+                m_Watcher->moveToThread(QCoreApplication::instance()->thread());
+
+            // Profiles saved for the first time create their file in the watched directory.
+            // Other files come and go there too, only reload groups whose file appeared or vanished.
+            const QString directory = KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+            QObject::connect(m_Watcher, &QFileSystemWatcher::directoryChanged, m_Watcher, [this]()
+            {
+                QMutexLocker locker(&m_Mutex);
+                for (auto it = m_Saved.begin(); it != m_Saved.end(); ++it)
+                {
+                    if (QFileInfo::exists(getSavedOptionsProfilesPath(it.key())) != it.value())
+                        m_Profiles.remove(it.key());
+                }
+            });
+            QObject::connect(m_Watcher, &QFileSystemWatcher::fileChanged, m_Watcher, [this](const QString & path)
+            {
+                for (auto group : { AlignProfiles, FocusProfiles, GuideProfiles, HFRProfiles })
+                {
+                    if (getSavedOptionsProfilesPath(group) == path)
+                        invalidate(group);
+                }
+            });
+            watch(directory);
+        }
+
+        // The watcher can only be used from its own thread.
+        void watch(const QString &path)
+        {
+            QMetaObject::invokeMethod(m_Watcher, [this, path]()
+            {
+                // A file replaced when saved is no longer watched
+                if (!m_Watcher->files().contains(path) && !m_Watcher->directories().contains(path))
+                    m_Watcher->addPath(path);
+            }, Qt::QueuedConnection);
+        }
+
+        QMutex m_Mutex;
+        QMap<ProfileGroup, QList<Parameters>> m_Profiles;
+        // Whether the cached profiles were read from a saved file
+        QMap<ProfileGroup, bool> m_Saved;
+        QFileSystemWatcher *m_Watcher { nullptr };
+};
+}
+
+QString getSavedOptionsProfilesPath(ProfileGroup group)
+{
+    return QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(profilesFileName(group));
+}
+
+QList<Parameters> getOptionsProfiles(ProfileGroup group)
+{
+    return ProfileCache::instance().profiles(group);
+}
+
+void invalidateOptionsProfiles(ProfileGroup group)
+{
+    ProfileCache::instance().invalidate(group);
+}
+
 }
@@ -23,4 +23,16 @@ QList<SSolver::Parameters> getDefaultFocusOptionsProfiles();
 QList<SSolver::Parameters> getDefaultGuideOptionsProfiles();
 QList<SSolver::Parameters> getDefaultAlignOptionsProfiles();
 QList<SSolver::Parameters> getDefaultHFROptionsProfiles();
+
+/**
+ * @brief Options profiles of @p group, as saved with the profile editor, or the default ones.
+ * The saved file is only read again after it changes. Can be called from any thread.
+ */
+QList<SSolver::Parameters> getOptionsProfiles(ProfileGroup group);
+
+/** @return Path of the file the options profiles of @p group are saved to */
+QString getSavedOptionsProfilesPath(ProfileGroup group);
+
+/** @brief Read the options profiles of @p group from disk again on next use. */
+void invalidateOptionsProfiles(ProfileGroup group);
 }
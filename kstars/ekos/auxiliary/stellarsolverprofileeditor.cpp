@@ -434,6 +434,8 @@ void StellarSolverProfileEditor::saveProfiles()
         if( ! groupInList)
             settings.remove(group);
     }
+    settings.sync();
+    invalidateOptionsProfiles(selectedProfileGroup);
 }
 
 QList<SSolver::Parameters> StellarSolverProfileEditor::getDefaultProfiles()
@@ -13,6 +13,8 @@ constexpr int NUM_GAUSSIAN_PARAMS = 7;
 // There is a relationship with the tolerance parameters that follow.
 constexpr int MAX_ITERATIONS_CURVE = 5000;
 constexpr int MAX_ITERATIONS_STARS = 1000;
+// Maximum number of solver workspaces kept by a CurveFitting object
+constexpr int MAX_WORKSPACES = 32;
 // The next 3 parameters are used as tolerance for convergence
 // convergence is achieved if for each datapoint i
 //     dx_i < INEPSABS + (INEPSREL * x_i)
@@ -641,6 +643,55 @@ CurveFitting::CurveFitting(const QString &serialized)
     recreateFromQString(serialized);
 }
 
+CurveFitting::~CurveFitting()
+{
+    freeWorkspaces();
+}
+
+CurveFitting::Workspace *CurveFitting::getWorkspace(size_t n, size_t p)
+{
+    if (n == 0 || p == 0)
+        return nullptr;
+
+    auto it = m_Workspaces.find(qMakePair(n, p));
+    if (it != m_Workspaces.end())
+        return &it.value();
+
+    if (m_Workspaces.size() >= MAX_WORKSPACES)
+        freeWorkspaces();
+
+    // Allocated with the GSL default solver parameters
+    const gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
+    Workspace workspace;
+    workspace.w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, n, p);
+    workspace.guess = gsl_vector_alloc(p);
+    workspace.weights = gsl_vector_alloc(n);
+    if (workspace.w == nullptr || workspace.guess == nullptr || workspace.weights == nullptr)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("CurveFitting unable to allocate a workspace n=%1, p=%2").arg(n).arg(p);
+        if (workspace.w)
+            gsl_multifit_nlinear_free(workspace.w);
+        if (workspace.guess)
+            gsl_vector_free(workspace.guess);
+        if (workspace.weights)
+            gsl_vector_free(workspace.weights);
+        return nullptr;
+    }
+
+    return &m_Workspaces.insert(qMakePair(n, p), workspace).value();
+}
+
+void CurveFitting::freeWorkspaces()
+{
+    for (auto &workspace : m_Workspaces)
+    {
+        gsl_multifit_nlinear_free(workspace.w);
+        gsl_vector_free(workspace.guess);
+        gsl_vector_free(workspace.weights);
+    }
+    m_Workspaces.clear();
+}
+
 void CurveFitting::fitCurve(const FittingGoal goal, const QVector<int> &x_, const QVector<double> &y_,
                             const QVector<double> &weight_, const QVector<bool> &outliers_,
                             const CurveFit curveFit, const bool useWeights, const OptimisationDirection optDir)
@@ -784,7 +835,6 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
     QVector<double> vc;
     DataPointT dataPoints;
 
-    auto weights = gsl_vector_alloc(data_weights.size());
     // Fill in the data to which the curve will be fitted
     dataPoints.useWeights = useWeights;
     for (int i = 0; i < data_x.size(); i++)
@@ -794,11 +844,17 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
     auto const oldErrorHandler = gsl_set_error_handler_off();
 
     // Setup variables to be used by the solver
+    Workspace *workspace = getWorkspace(data_x.size(), NUM_HYPERBOLA_PARAMS);
+    if (workspace == nullptr)
+    {
+        gsl_set_error_handler(oldErrorHandler);
+        return vc;
+    }
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace *w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, data_x.size(),
-                                        NUM_HYPERBOLA_PARAMS);
+    gsl_multifit_nlinear_workspace *w = workspace->w;
     gsl_multifit_nlinear_fdf fdf;
-    gsl_vector *guess = gsl_vector_alloc(NUM_HYPERBOLA_PARAMS);
+    gsl_vector *guess = workspace->guess;
+    gsl_vector *weights = workspace->weights;
     int numIters;
     double xtol, gtol, ftol;
 
@@ -908,11 +964,6 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
-    gsl_vector_free(guess);
-    gsl_vector_free(weights);
-
     // Restore old GSL error handler
     gsl_set_error_handler(oldErrorHandler);
 
@@ -1105,7 +1156,6 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
     QVector<double> vc;
     DataPointT dataPoints;
 
-    auto weights = gsl_vector_alloc(data_weights.size());
     // Fill in the data to which the curve will be fitted
     dataPoints.useWeights = useWeights;
     for (int i = 0; i < data_x.size(); i++)
@@ -1115,11 +1165,17 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
     auto const oldErrorHandler = gsl_set_error_handler_off();
 
     // Setup variables to be used by the solver
+    Workspace *workspace = getWorkspace(data_x.size(), NUM_PARABOLA_PARAMS);
+    if (workspace == nullptr)
+    {
+        gsl_set_error_handler(oldErrorHandler);
+        return vc;
+    }
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data_x.size(),
-                                        NUM_PARABOLA_PARAMS);
+    gsl_multifit_nlinear_workspace* w = workspace->w;
     gsl_multifit_nlinear_fdf fdf;
-    gsl_vector * guess = gsl_vector_alloc(NUM_PARABOLA_PARAMS);
+    gsl_vector * guess = workspace->guess;
+    gsl_vector * weights = workspace->weights;
     int numIters;
     double xtol, gtol, ftol;
 
@@ -1226,11 +1282,6 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
-    gsl_vector_free(guess);
-    gsl_vector_free(weights);
-
     // Restore old GSL error handler
     gsl_set_error_handler(oldErrorHandler);
 
@@ -1378,9 +1429,14 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     auto const oldErrorHandler = gsl_set_error_handler_off();
 
     // Setup variables to be used by the solver
+    Workspace *workspace = getWorkspace(data.dps.size(), NUM_GAUSSIAN_PARAMS);
+    if (workspace == nullptr)
+    {
+        gsl_set_error_handler(oldErrorHandler);
+        return vc;
+    }
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data.dps.size(),
-                                        NUM_GAUSSIAN_PARAMS);
+    gsl_multifit_nlinear_workspace* w = workspace->w;
     gsl_multifit_nlinear_fdf fdf;
     int numIters;
     double xtol, gtol, ftol;
@@ -1393,10 +1449,8 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     fdf.p = NUM_GAUSSIAN_PARAMS;
     fdf.params = &data;
 
-    // Allocate the guess vector
-    gsl_vector * guess = gsl_vector_alloc(NUM_GAUSSIAN_PARAMS);
-    // Allocate weights vector
-    auto weights = gsl_vector_alloc(data.dps.size());
+    gsl_vector * guess = workspace->guess;
+    gsl_vector * weights = workspace->weights;
 
     // Setup a timer to see how long the solve takes
     QElapsedTimer timer;
@@ -1489,11 +1543,6 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
-    gsl_vector_free(guess);
-    gsl_vector_free(weights);
-
     // Restore old GSL error handler
     gsl_set_error_handler(oldErrorHandler);
 
@@ -1527,6 +1576,22 @@ void CurveFitting::gauMakeGuess(const int attempt, const StarParams &starParams,
         A = C = (costheta2 + sintheta2) / (2 * sigma2) * perturbation;
     }
 
+    // Stars of the same frame have similar shapes, so on the first attempt start from the shape of the
+    // previous star solved by this object, provided it is a proper (positive definite) Gaussian
+    if (attempt == 0 && !m_FirstSolverRun && m_LastCurveType == FOCUS_GAUSSIAN &&
+            m_LastCoefficients.size() == NUM_GAUSSIAN_PARAMS)
+    {
+        const double lastA = m_LastCoefficients[D_IDX];
+        const double lastB = m_LastCoefficients[E_IDX];
+        const double lastC = m_LastCoefficients[F_IDX];
+        if (lastA > 0.0 && lastC > 0.0 && lastA * lastC > lastB * lastB)
+        {
+            A = lastA;
+            B = lastB;
+            C = lastC;
+        }
+    }
+
     qCDebug(KSTARS_EKOS_FOCUS) <<
                                QString("LM Solver (Gaussian): Guess perturbation=%1, A=%2, B=%3, C=%4, D=%5, E=%6, F=%7, G=%8")
                                .arg(perturbation).arg(a).arg(x0).arg(y0).arg(A).arg(B).arg(C).arg(b);
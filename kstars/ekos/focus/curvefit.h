@@ -2,6 +2,8 @@
 
 #include "../../auxiliary/robuststatistics.h"
 
+#include <QMap>
+#include <QPair>
 #include <QVector>
 #include <qcustomplot.h>
 #include <gsl/gsl_vector.h>
@@ -102,6 +104,12 @@ class CurveFitting
         // Does not implement getting the original data points.
         CurveFitting(const QString &serialized);
 
+        // Frees the solver workspaces
+        ~CurveFitting();
+
+        CurveFitting(const CurveFitting &) = delete;
+        CurveFitting &operator=(const CurveFitting &) = delete;
+
         // fitCurve takes in the vectors with the position, hfr and weight (e.g. variance in HFR) values
         // along with the type of curve to use and whether or not to use weights in the calculation
         // It fits the curve and solves for the coefficients.
@@ -175,6 +183,12 @@ class CurveFitting
         // getStarParams returns the star parameters for the solved star
         bool getStarParams(const CurveFit curveFit, StarParams *starParams);
 
+        // Forget the previous solution, so the next solve starts from a guess based on its data
+        void resetSolver()
+        {
+            m_FirstSolverRun = true;
+        }
+
         // getCurveParams gets the coefficients of a curve solve
         // setCurveParams sets the coefficients of a curve solve
         // using get and set returns the solver to its state as it was when get was called
@@ -254,6 +268,19 @@ class CurveFitting
         // Used in the QString constructor.
         bool recreateFromQString(const QString &serialized);
 
+        // GSL solver workspace, with the guess and weights vectors that go with it.
+        struct Workspace
+        {
+            gsl_multifit_nlinear_workspace *w { nullptr };
+            gsl_vector *guess { nullptr };
+            gsl_vector *weights { nullptr };
+        };
+
+        // Returns the workspace for n datapoints and p parameters, allocating it on first use.
+        // Returns nullptr if it can't be allocated.
+        Workspace *getWorkspace(size_t n, size_t p);
+        void freeWorkspaces();
+
         // Type of curve
         CurveFit m_CurveType;
         // The data values.
@@ -269,6 +296,9 @@ class CurveFitting
         bool m_FirstSolverRun;
         CurveFit m_LastCurveType;
         QVector<double> m_LastCoefficients;
+        // GSL workspaces are sized for the number of datapoints and parameters, so they are kept by size.
+        // Focus runs refit curves of the same sizes, and stars of similar size have boxes of the same size.
+        QMap<QPair<size_t, size_t>, Workspace> m_Workspaces;
 };
 
 } //namespace
@@ -194,12 +194,7 @@ void Focus::prepareGUI()
 
 void Focus::loadStellarSolverProfiles()
 {
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                            QStandardPaths::AppLocalDataLocation)).filePath("SavedFocusProfiles.ini");
-    if(QFileInfo::exists(savedOptionsProfiles))
-        m_StellarSolverProfiles = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        m_StellarSolverProfiles = getDefaultFocusOptionsProfiles();
+    m_StellarSolverProfiles = getOptionsProfiles(FocusProfiles);
     focusSEPProfile->clear();
     for(auto &param : m_StellarSolverProfiles)
         focusSEPProfile->addItem(param.listName);
@@ -1333,8 +1328,7 @@ void Focus::start()
 
         if (m_FocusAlgorithm == FOCUS_LINEAR1PASS)
         {
-            // Curve fitting for stars and FWHM processing
-            starFitting.reset(new CurveFitting());
+            // FWHM processing, with its own curve fitting for stars
             focusFWHM.reset(new FocusFWHM(m_ScaleCalc));
             focusFourierPower.reset(new FocusFourierPower(m_ScaleCalc));
         }
@@ -1342,6 +1336,7 @@ void Focus::start()
         if (canAbsMove)
             initialFocuserAbsPosition = position;
         linearFocuser.reset(MakeLinearFocuser(params));
+        m_SpeculativeMove = SpeculativeMove();
         linearRequestedPosition = linearFocuser->initialPosition();
         if (!changeFocus(linearRequestedPosition - currentPosition))
             completeFocusProcedure(Ekos::FOCUS_ABORTED);
@@ -1561,6 +1556,7 @@ void Focus::stop(Ekos::FocusState completionState)
 
     opticalTrainCombo->setEnabled(true);
     inAutoFocus = false;
+    m_SpeculativeMove = SpeculativeMove();
     inAdjustFocus = false;
     inAdaptiveFocus = false;
     inBuildOffsets = false;
@@ -2099,35 +2095,35 @@ void Focus::getFWHM(double *FWHM, double *weight)
     switch (m_ImageData->getStatistics().dataType)
     {
         case TBYTE:
-            focusFWHM->processFWHM(reinterpret_cast<uint8_t const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<uint8_t const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TSHORT: // Don't think short is used as its recorded as unsigned short
-            focusFWHM->processFWHM(reinterpret_cast<short const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<short const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TUSHORT:
-            focusFWHM->processFWHM(reinterpret_cast<unsigned short const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<unsigned short const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TLONG:  // Don't think long is used as its recorded as unsigned long
-            focusFWHM->processFWHM(reinterpret_cast<long const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<long const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TULONG:
-            focusFWHM->processFWHM(reinterpret_cast<unsigned long const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<unsigned long const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TFLOAT:
-            focusFWHM->processFWHM(reinterpret_cast<float const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<float const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TLONGLONG:
-            focusFWHM->processFWHM(reinterpret_cast<long long const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<long long const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         case TDOUBLE:
-            focusFWHM->processFWHM(reinterpret_cast<double const *>(imageBuffer), m_ImageData, starFitting, FWHM, weight);
+            focusFWHM->processFWHM(reinterpret_cast<double const *>(imageBuffer), m_ImageData, FWHM, weight);
             break;
 
         default:
@@ -2493,7 +2489,7 @@ void Focus::setCurrentMeasure()
     // Let signal the current HFR now depending on whether the focuser is absolute or relative
     // Outside of Focus we continue to rely on HFR and independent of which measure the user selected we always calculate HFR
     if (canAbsMove)
-        emit newHFR(currentHFR, currentPosition);
+        emit newHFR(currentHFR, m_SpeculativeMove.active ? m_SpeculativeMove.framePosition : currentPosition);
     else
         emit newHFR(currentHFR, -1);
 
@@ -2609,7 +2605,10 @@ void Focus::setCaptureComplete()
     // If we are asked to analyze _all_ the stars within the field
     // THEN let's find stars in the image and get current HFR
     if (inFocusLoop == false || (inFocusLoop && (m_FocusView->isTrackingBoxEnabled() || focusUseFullField->isChecked())))
+    {
+        startSpeculativeMove();
         analyzeSources();
+    }
     else
         setHFRComplete();
 }
@@ -3112,6 +3111,19 @@ void Focus::plotLinearFinalUpdates()
 
 void Focus::autoFocusLinear()
 {
+    // autoFocusChecks() would capture again without stars, but the focuser already left the position of the frame
+    if (m_SpeculativeMove.active && currentHFR == INVALID_STAR_MEASURE && noStarCount < MAX_RECAPTURE_RETRIES)
+    {
+        absIterations++;
+        noStarCount++;
+        appendLogText(i18n("No stars detected, capturing again..."));
+        m_SpeculativeMove.recapture = true;
+        m_SpeculativeMove.analysisComplete = true;
+        if (m_SpeculativeMove.moveComplete)
+            finishSpeculativeMove();
+        return;
+    }
+
     if (!autoFocusChecks())
         return;
 
@@ -3128,13 +3140,15 @@ void Focus::autoFocusLinear()
         }
     }
 
-    addPlotPosition(currentPosition, currentMeasure, false);
+    // The focuser may already be moving to the next position
+    const int framePosition = m_SpeculativeMove.active ? m_SpeculativeMove.framePosition : currentPosition;
+    addPlotPosition(framePosition, currentMeasure, false);
 
     // Only use the relativeHFR algorithm if full field is enabled with one capture/measurement.
     bool useFocusStarsHFR = focusUseFullField->isChecked() && focusFramesCount->value() == 1;
     auto focusStars = useFocusStarsHFR || (m_FocusAlgorithm == FOCUS_LINEAR1PASS) ? &(m_ImageData->getStarCenters()) : nullptr;
 
-    linearRequestedPosition = linearFocuser->newMeasurement(currentPosition, currentMeasure, currentWeight, focusStars);
+    linearRequestedPosition = linearFocuser->newMeasurement(framePosition, currentMeasure, currentWeight, focusStars);
     if (m_FocusAlgorithm == FOCUS_LINEAR1PASS && linearFocuser->isDone() && linearFocuser->solution() != -1)
         // Linear 1 Pass is done, graph is drawn, so just move to the focus position, and update the graph.
         plotLinearFinalUpdates();
@@ -3142,6 +3156,19 @@ void Focus::autoFocusLinear()
         // Update the graph with the next datapoint, draw the curve, etc.
         plotLinearFocus();
 
+    if (m_SpeculativeMove.active)
+    {
+        m_SpeculativeMove.analysisComplete = true;
+        if (m_SpeculativeMove.moveComplete)
+            finishSpeculativeMove();
+        return;
+    }
+
+    processLinearRequest();
+}
+
+void Focus::processLinearRequest()
+{
     if (linearFocuser->isDone())
     {
         if (linearFocuser->solution() != -1)
@@ -3646,6 +3673,14 @@ void Focus::autoFocusProcessPositionChange(IPState state)
                 completeFocusProcedure(Ekos::FOCUS_ABORTED);
             }
         }
+        else if (inAutoFocus && m_SpeculativeMove.active)
+        {
+            // Capture once the previous frame is analyzed and confirms this position
+            m_SpeculativeMove.moveComplete = true;
+            m_SpeculativeMove.sinceMoveComplete.start();
+            if (m_SpeculativeMove.analysisComplete)
+                finishSpeculativeMove();
+        }
         else if (inAutoFocus)
         {
             qCDebug(KSTARS_EKOS_FOCUS) << QString("Focus position reached at %1, starting capture in %2 seconds.").arg(
@@ -3660,6 +3695,66 @@ void Focus::autoFocusProcessPositionChange(IPState state)
     }
 }
 
+bool Focus::startSpeculativeMove()
+{
+    m_SpeculativeMove = SpeculativeMove();
+
+    if (!Options::focusOverlapMoves() || !inAutoFocus || inFocusLoop || !canAbsMove || minimumRequiredHFR >= 0)
+        return false;
+    if ((m_FocusAlgorithm != FOCUS_LINEAR && m_FocusAlgorithm != FOCUS_LINEAR1PASS) || linearFocuser == nullptr)
+        return false;
+    // Several frames are averaged at each position, and a star may still have to be selected
+    if (focusFramesCount->value() != 1 || (!focusUseFullField->isChecked() && starCenter.isNull()))
+        return false;
+    // The algorithm samples this frame again if it is not at the requested position
+    if (abs(currentPosition - linearRequestedPosition) > 1)
+        return false;
+
+    // Only inward moves, outward moves are made in two steps to take up backlash
+    const int target = linearFocuser->nextPositionIfKnown();
+    if (target < 0 || currentPosition - target <= 1)
+        return false;
+
+    m_SpeculativeMove.active = true;
+    m_SpeculativeMove.framePosition = currentPosition;
+    m_SpeculativeMove.targetPosition = target;
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Linear: moving to %1 while analyzing the frame at %2").arg(target).arg(
+                                   currentPosition);
+    if (!changeFocus(target - currentPosition))
+    {
+        m_SpeculativeMove = SpeculativeMove();
+        return false;
+    }
+    return true;
+}
+
+void Focus::finishSpeculativeMove()
+{
+    const SpeculativeMove move = m_SpeculativeMove;
+    m_SpeculativeMove = SpeculativeMove();
+
+    if (move.recapture)
+    {
+        if (!changeFocus(move.framePosition - currentPosition))
+            completeFocusProcedure(Ekos::FOCUS_ABORTED);
+        return;
+    }
+
+    if (!linearFocuser->isDone() && linearRequestedPosition == move.targetPosition)
+    {
+        // The focuser has been settling since it arrived
+        const double settleTime = std::max(0.0, focusSettleTime->value() - move.sinceMoveComplete.elapsed() / 1000.0);
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Focus position reached at %1, starting capture in %2 seconds.").arg(
+                                       currentPosition).arg(settleTime);
+        capture(settleTime);
+        return;
+    }
+
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Linear: requested position %1 instead of %2").arg(linearRequestedPosition).arg(
+                                   move.targetPosition);
+    processLinearRequest();
+}
+
 void Focus::updateProperty(INDI::Property prop)
 {
     if (m_Focuser == nullptr || prop.getType() != INDI_NUMBER || prop.getDeviceName() != m_Focuser->getDeviceName())
@@ -25,6 +25,8 @@
 
 #include <parameters.h>
 
+#include <QElapsedTimer>
+
 namespace Ekos
 {
 
@@ -731,6 +733,16 @@ protected:
         // Start up capture, or occasionally move focuser again, after current focus-move accomplished.
         void autoFocusProcessPositionChange(IPState state);
 
+        // With the Linear algorithms, start moving the focuser to the next position while the frame just
+        // received is analyzed, if the algorithm already knows that position. Returns true if moving.
+        bool startSpeculativeMove();
+
+        // Called once both the speculative move and the analysis of the frame are done.
+        void finishSpeculativeMove();
+
+        // Acts on the position requested by the Linear algorithm: completes focus, or moves the focuser.
+        void processLinearRequest();
+
         // For the Linear algorithm, which always scans in (from higher position to lower position)
         // if we notice the new position is higher than the current position (that is, it is the start
         // of a new scan), we adjust the new position to be several steps further out than requested
@@ -1058,9 +1070,6 @@ protected:
         // Curve fitting for focuser movement.
         std::unique_ptr<CurveFitting> curveFitting;
 
-        // Curve fitting for stars.
-        std::unique_ptr<CurveFitting> starFitting;
-
         // FWHM processing.
         std::unique_ptr<FocusFWHM> focusFWHM;
 
@@ -1098,6 +1107,22 @@ protected:
         int focuserAdditionalMovement { 0 };
         int linearRequestedPosition { 0 };
 
+        // Focuser move started before the analysis of the current frame completed.
+        struct SpeculativeMove
+        {
+            bool active { false };
+            // Focuser position of the frame being analyzed.
+            int framePosition { 0 };
+            // Position the focuser is moving to.
+            int targetPosition { 0 };
+            bool moveComplete { false };
+            bool analysisComplete { false };
+            // The frame had no star and must be captured again at framePosition.
+            bool recapture { false };
+            QElapsedTimer sinceMoveComplete;
+        };
+        SpeculativeMove m_SpeculativeMove;
+
         bool hasDeviation { false };
 
         //double observatoryTemperature { INVALID_VALUE };
@@ -47,6 +47,8 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
         // If stars is not nullptr, then the relativeHFR scheme is used to modify the HFR value.
         int newMeasurement(int position, double value, const double starWeight, const QList<Edge*> *stars) override;
 
+        int nextPositionIfKnown() const override;
+
         FocusAlgorithmInterface *Copy() override;
 
         void getMeasurements(QVector<int> *pos, QVector<double> *val, QVector<double> *sds) const override
@@ -92,6 +94,8 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
 
         // Calc the next step size for Linear1Pass for FOCUS_WALK_FIXED_STEPS and FOCUS_WALK_CFZ_SHUFFLE
         int getNextStepSize();
+        // Step size after the measurement number step of the walk
+        int getStepSize(int step) const;
 
         // Called when we've found a solution, e.g. the HFR value is within tolerance of the desired value.
         // It it returns true, then it's decided tht we should try one more sample for a possible improvement.
@@ -790,8 +794,30 @@ int LinearFocusAlgorithm::linearWalk(int position, double value, const double st
     return completeIteration(nextStepSize, foundFit, minPos, minVal);
 }
 
+// The first pass of the fixed step walks samples positions that are decided in advance. The position
+// after the next measurement is known, unless that measurement ends the pass or the focuser's travel.
+// This mirrors linearWalk() and completeIteration().
+int LinearFocusAlgorithm::nextPositionIfKnown() const
+{
+    if (params.focusAlgorithm != Focus::FOCUS_LINEAR1PASS || !inFirstPass || done ||
+            (params.focusWalk != Focus::FOCUS_WALK_FIXED_STEPS && params.focusWalk != Focus::FOCUS_WALK_CFZ_SHUFFLE))
+        return -1;
+
+    const int step = numSteps + 1;
+    if (step >= params.numSteps || step > params.maxIterations)
+        return -1;
+
+    const int position = requestedPosition - getStepSize(step);
+    return position < minPositionLimit ? -1 : position;
+}
+
 // Function to calculate the next step size for LINEAR1PASS for walks: FOCUS_WALK_FIXED_STEPS and FOCUS_WALK_CFZ_SHUFFLE
 int LinearFocusAlgorithm::getNextStepSize()
+{
+    return getStepSize(numSteps);
+}
+
+int LinearFocusAlgorithm::getStepSize(int step) const
 {
     int nextStepSize, lower, upper;
 
@@ -817,9 +843,9 @@ int LinearFocusAlgorithm::getNextStepSize()
                 upper = (params.numSteps - lower);
             }
 
-            if (numSteps <= lower)
+            if (step <= lower)
                 nextStepSize = stepSize;
-            else if (numSteps >= upper)
+            else if (step >= upper)
                 nextStepSize = stepSize;
             else
                 nextStepSize = stepSize / 2;
@@ -115,6 +115,14 @@ class FocusAlgorithmInterface
         // If stars is not nullptr, then the they may be used to modify the HFR value.
         virtual int newMeasurement(int position, double value, const double starWeight, const QList<Edge*> *stars = nullptr) = 0;
 
+        // Returns the position newMeasurement() will return for the next measurement when it does not
+        // depend on the measured value, or -1 if it does. The focuser may then start moving there
+        // while the current frame is still being analyzed.
+        virtual int nextPositionIfKnown() const
+        {
+            return -1;
+        }
+
         // Returns true if the algorithm has terminated either successfully or in error.
         bool isDone() const
         {
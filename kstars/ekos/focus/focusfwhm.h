@@ -7,6 +7,10 @@
 #pragma once
 
 #include <QList>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <memory>
+#include <vector>
 #include "../fitsviewer/fitsstardetector.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
@@ -28,10 +32,8 @@ class FocusFWHM
         ~FocusFWHM();
 
         template <typename T>
-        void processFWHM(const T imageBuffer, const QSharedPointer<FITSData> &imageData, std::unique_ptr<CurveFitting> &starFitting,
-                         double *FWHM, double *weight)
+        void processFWHM(const T imageBuffer, const QSharedPointer<FITSData> &imageData, double *FWHM, double *weight)
         {
-            CurveFitting::StarParams starParams, starParams2;
             std::vector<double> FWHMs, R2s;
 
             auto focusStars = imageData->getStarCenters();
@@ -92,43 +94,76 @@ class FocusFWHM
                 }
             }
 
-            // We have the list of stars to process now so iterate through the list fitting a curve, etc
+            // We have the list of stars to process now so fit a curve to each of them. Stars are split in
+            // contiguous batches solved in parallel, each batch with its own CurveFitting object.
+            QVector<int> validStars;
             for (int s = 0; s < stars.size(); s++)
             {
-                if (!stars[s].isValid)
-                    continue;
+                if (stars[s].isValid)
+                    validStars.push_back(s);
+            }
+
+            const int numBatches = qBound(1, validStars.size() / MIN_STARS_PER_BATCH,
+                                          QThreadPool::globalInstance()->maxThreadCount());
+            while (static_cast<int>(m_StarFitting.size()) < numBatches)
+                m_StarFitting.emplace_back(new CurveFitting());
+
+            QVector<StarFit> fits(validStars.size());
+            QVector<int> batches;
+            for (int b = 0; b < numBatches; b++)
+                batches.push_back(b);
 
-                starParams.background = skyBackground.mean;
-                starParams.peak = focusStars[stars[s].star]->val;
-                starParams.centroid_x = focusStars[stars[s].star]->x - stars[s].start.first;
-                starParams.centroid_y = focusStars[stars[s].star]->y - stars[s].start.second;
-                starParams.HFR = focusStars[stars[s].star]->HFR;
-                starParams.theta = 0.0;
-                starParams.FWHMx = -1;
-                starParams.FWHMy = -1;
-                starParams.FWHM = -1;
-
-                starFitting->fitCurve3D(imageBuffer, stats.width, stars[s].start, stars[s].end, starParams, CurveFitting::FOCUS_GAUSSIAN,
-                                        false);
-                if (starFitting->getStarParams(CurveFitting::FOCUS_GAUSSIAN, &starParams2))
+            QtConcurrent::blockingMap(batches, [&](const int batch)
+            {
+                CurveFitting *starFitting = m_StarFitting[batch].get();
+                starFitting->resetSolver();
+
+                const int first = batch * validStars.size() / numBatches;
+                const int last = (batch + 1) * validStars.size() / numBatches;
+                for (int i = first; i < last; i++)
                 {
-                    starParams2.centroid_x += stars[s].start.first;
-                    starParams2.centroid_y += stars[s].start.second;
-                    double R2 = starFitting->calculateR2(CurveFitting::FOCUS_GAUSSIAN);
-                    if (R2 >= 0.25)
+                    const StarBox &box = stars[validStars[i]];
+                    CurveFitting::StarParams starParams;
+                    starParams.background = skyBackground.mean;
+                    starParams.peak = focusStars[box.star]->val;
+                    starParams.centroid_x = focusStars[box.star]->x - box.start.first;
+                    starParams.centroid_y = focusStars[box.star]->y - box.start.second;
+                    starParams.HFR = focusStars[box.star]->HFR;
+                    starParams.theta = 0.0;
+                    starParams.FWHMx = -1;
+                    starParams.FWHMy = -1;
+                    starParams.FWHM = -1;
+
+                    starFitting->fitCurve3D(imageBuffer, stats.width, box.start, box.end, starParams, CurveFitting::FOCUS_GAUSSIAN,
+                                            false);
+                    StarFit &fit = fits[i];
+                    fit.solved = starFitting->getStarParams(CurveFitting::FOCUS_GAUSSIAN, &fit.starParams);
+                    if (fit.solved)
                     {
-                        // Filter stars - 0.25 works OK on Sim
-                        FWHMs.push_back(starParams2.FWHM);
-                        R2s.push_back(R2);
-
-                        qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << R2
-                                                   << " x=" << focusStars[s]->x << " vs " << starParams2.centroid_x
-                                                   << " y=" << focusStars[s]->y << " vs " << starParams2.centroid_y
-                                                   << " HFR=" << focusStars[s]->HFR << " FWHM=" << starParams2.FWHM
-                                                   << " Background=" << skyBackground.mean << " vs " << starParams2.background
-                                                   << " Peak=" << focusStars[s]->val << "vs" << starParams2.peak;
+                        fit.starParams.centroid_x += box.start.first;
+                        fit.starParams.centroid_y += box.start.second;
+                        fit.R2 = starFitting->calculateR2(CurveFitting::FOCUS_GAUSSIAN);
                     }
                 }
+            });
+
+            for (int i = 0; i < fits.size(); i++)
+            {
+                const StarFit &fit = fits[i];
+                // Filter stars - 0.25 works OK on Sim
+                if (!fit.solved || fit.R2 < 0.25)
+                    continue;
+
+                const int s = stars[validStars[i]].star;
+                FWHMs.push_back(fit.starParams.FWHM);
+                R2s.push_back(fit.R2);
+
+                qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << fit.R2
+                                           << " x=" << focusStars[s]->x << " vs " << fit.starParams.centroid_x
+                                           << " y=" << focusStars[s]->y << " vs " << fit.starParams.centroid_y
+                                           << " HFR=" << focusStars[s]->HFR << " FWHM=" << fit.starParams.FWHM
+                                           << " Background=" << skyBackground.mean << " vs " << fit.starParams.background
+                                           << " Peak=" << focusStars[s]->val << "vs" << fit.starParams.peak;
             }
 
             if (FWHMs.size() == 0)
@@ -176,6 +211,19 @@ class FocusFWHM
             QPair<int, int> end; // bottom right of box. x = first element, y = second element
         };
 
+        // Result of the Gaussian fit of a star
+        struct StarFit
+        {
+            bool solved { false };
+            double R2 { 0.0 };
+            CurveFitting::StarParams starParams;
+        };
+
+        // Smallest number of stars worth a batch of its own
+        static constexpr int MIN_STARS_PER_BATCH = 8;
+
         Mathematics::RobustStatistics::ScaleCalculation m_ScaleCalc;
+        // One per batch, kept between frames so the solver workspaces are reused
+        std::vector<std::unique_ptr<CurveFitting>> m_StarFitting;
 };
 }
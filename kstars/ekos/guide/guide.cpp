@@ -779,6 +779,8 @@ bool Guide::captureOneFrame()
     // Timeout is exposure duration + timeout threshold in seconds
     captureTimeout.start(finalExposure * 1000 + CAPTURE_TIMEOUT_THRESHOLD);
 
+    if (guiderType == GUIDE_INTERNAL)
+        internalGuider->setExposureStarted(finalExposure);
     targetChip->capture(finalExposure);
 
     return true;
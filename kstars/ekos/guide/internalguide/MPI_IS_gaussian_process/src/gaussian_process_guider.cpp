@@ -16,6 +16,7 @@
 
 #include "gaussian_process_guider.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <iostream>
@@ -93,20 +94,26 @@ GaussianProcessGuider::~GaussianProcessGuider()
 {
 }
 
-void GaussianProcessGuider::SetTimestamp()
+void GaussianProcessGuider::SetTimestamp(double measurement_age /*= -1*/)
 {
-    auto current_time = std::chrono::system_clock::now();
+    auto current_time = now();
     double delta_measurement_time = std::chrono::duration<double>(current_time - last_time_).count();
     last_time_ = current_time;
-    get_last_point().timestamp = std::chrono::duration<double>(current_time - start_time_).count()
-                                 - (delta_measurement_time / 2.0) // use the midpoint as time stamp
-                                 + dither_offset_; // correct for the gear time offset from dithering
+    // use the known time of the measurement, or else the midpoint as time stamp
+    const double age = measurement_age >= 0.0 ? measurement_age : delta_measurement_time / 2.0;
+    double timestamp = std::chrono::duration<double>(current_time - start_time_).count()
+                       - age
+                       + dither_offset_; // correct for the gear time offset from dithering
+    // a measurement can be older than the midpoint given to a dark guiding step before it
+    if (measurement_age >= 0.0 && get_number_of_measurements() > 1)
+        timestamp = std::max(timestamp, get_second_last_point().timestamp);
+    get_last_point().timestamp = timestamp;
 }
 
 // adds a new measurement to the circular buffer that holds the data.
-void GaussianProcessGuider::HandleGuiding(double input, double SNR)
+void GaussianProcessGuider::HandleGuiding(double input, double SNR, double measurement_age /*= -1*/)
 {
-    SetTimestamp();
+    SetTimestamp(measurement_age);
     get_last_point().measurement = input;
     get_last_point().variance = CalculateVariance(SNR);
 
@@ -247,7 +254,7 @@ double GaussianProcessGuider::PredictGearError(double prediction_location)
     // in the first step of each sequence, use the current time stamp as last prediction end
     if (last_prediction_end_ < 0.0)
     {
-        last_prediction_end_ = std::chrono::duration<double>(std::chrono::system_clock::now() - start_time_).count();
+        last_prediction_end_ = std::chrono::duration<double>(now() - start_time_).count();
     }
 
     // prediction from the last endpoint to the prediction point
@@ -266,7 +273,8 @@ double GaussianProcessGuider::PredictGearError(double prediction_location)
     return (p1 - p0);
 }
 
-double GaussianProcessGuider::result(double input, double SNR, double time_step, double prediction_point /*= -1*/)
+double GaussianProcessGuider::result(double input, double SNR, double time_step, double prediction_point /*= -1*/,
+                                     double measurement_age /*= -1*/)
 {
     /*
      * Dithering behaves differently from pausing. During dithering, the mount
@@ -303,12 +311,12 @@ double GaussianProcessGuider::result(double input, double SNR, double time_step,
     // the starting time is set at the first call of result after startup or reset
     if (get_number_of_measurements() == 1)
     {
-        start_time_ = std::chrono::system_clock::now();
+        start_time_ = now();
         last_time_ = start_time_; // this is OK, since last_time_ only provides a minor correction
     }
 
     // collect data point content, except for the control signal
-    HandleGuiding(input, SNR);
+    HandleGuiding(input, SNR, measurement_age);
 
     // calculate hysteresis result, too, for hybrid control
     double last_control = 0.0;
@@ -332,7 +340,7 @@ double GaussianProcessGuider::result(double input, double SNR, double time_step,
     {
         if (prediction_point < 0.0)
         {
-            prediction_point = std::chrono::duration<double>(std::chrono::system_clock::now() - start_time_).count();
+            prediction_point = std::chrono::duration<double>(now() - start_time_).count();
         }
         // the point of highest precision shoud be between now and the next step
         UpdateGP(prediction_point + 0.5 * time_step);
@@ -395,7 +403,7 @@ double GaussianProcessGuider::deduceResult(double time_step, double prediction_p
     {
         if (prediction_point < 0.0)
         {
-            prediction_point = std::chrono::duration<double>(std::chrono::system_clock::now() - start_time_).count();
+            prediction_point = std::chrono::duration<double>(now() - start_time_).count();
         }
         // the point of highest precision should be between now and the next step
         UpdateGP(prediction_point + 0.5 * time_step);
@@ -432,8 +440,8 @@ void GaussianProcessGuider::reset()
     circular_buffer_data_[0].control = 0; // set first control to zero
 
     last_prediction_end_ = -1.0; // the negative value signals we didn't predict yet
-    start_time_ = std::chrono::system_clock::now();
-    last_time_ = std::chrono::system_clock::now();
+    start_time_ = now();
+    last_time_ = now();
 
     dither_offset_ = 0.0;
     dither_steps_ = 0;
@@ -589,6 +597,11 @@ bool GaussianProcessGuider::SetPredictionGain(double prediction_gain)
     return false;
 }
 
+void GaussianProcessGuider::SetClock(std::function<std::chrono::system_clock::time_point()> clock)
+{
+    clock_ = std::move(clock);
+}
+
 void GaussianProcessGuider::inject_data_point(double timestamp, double input, double SNR, double control)
 {
     // collect data point content, except for the control signal
@@ -596,7 +609,7 @@ void GaussianProcessGuider::inject_data_point(double timestamp, double input, do
     last_prediction_end_ = timestamp;
     get_last_point().timestamp = timestamp; // overrides the usual HandleTimestamps();
 
-    start_time_ = std::chrono::system_clock::now() - std::chrono::seconds((int) timestamp);
+    start_time_ = now() - std::chrono::seconds((int) timestamp);
 
     add_one_point(); // add new point here, since the control is for the next point in time
     HandleControls(control); // already store control signal
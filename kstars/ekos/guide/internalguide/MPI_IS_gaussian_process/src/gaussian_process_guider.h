@@ -24,6 +24,7 @@
 #include "math_tools.h"
 #include "ekos_guide_debug.h"
 #include <chrono>
+#include <functional>
 
 enum Hyperparameters
 {
@@ -155,6 +156,12 @@ class GaussianProcessGuider
 
         std::chrono::system_clock::time_point start_time_; // reference time
         std::chrono::system_clock::time_point last_time_;
+        std::function<std::chrono::system_clock::time_point()> clock_; // empty for the system clock
+
+        std::chrono::system_clock::time_point now() const
+        {
+            return clock_ ? clock_() : std::chrono::system_clock::now();
+        }
 
         double control_signal_;
         double prediction_;
@@ -183,14 +190,16 @@ class GaussianProcessGuider
         guide_parameters parameters;
 
         /**
-         * Stores the current time and creates a timestamp for the GP.
+         * Stores the current time and creates a timestamp for the GP. The timestamp is
+         * measurement_age seconds before now, or the midpoint since the last timestamp
+         * if the age is negative.
          */
-        void SetTimestamp();
+        void SetTimestamp(double measurement_age = -1.0);
 
         /**
          * Stores the measurement, SNR and resets last_prediction_end_.
          */
-        void HandleGuiding(double input, double SNR);
+        void HandleGuiding(double input, double SNR, double measurement_age = -1.0);
 
         /**
          * Stores a zero as blind "measurement" with high variance.
@@ -247,6 +256,13 @@ class GaussianProcessGuider
         double GetPredictionGain() const;
         bool SetPredictionGain(double);
 
+        /**
+         * Sets the clock that timestamps the measurements, the system clock by default.
+         * Replays of guiding use it to run the GP on a simulated timeline.
+         * Takes effect at the next reset().
+         */
+        void SetClock(std::function<std::chrono::system_clock::time_point()> clock);
+
         /**
          * Returns the weight of the prediction on the output control value
          */
@@ -258,7 +274,7 @@ class GaussianProcessGuider
                 return 0.0;
             }
 
-            auto current_time = std::chrono::system_clock::now();
+            auto current_time = now();
             double delta_measurement_time = std::chrono::duration<double>(current_time - last_time_).count();
 
             if (parameters.min_periods_for_inference_ * period_length == 0 || delta_measurement_time == 0)
@@ -281,8 +297,12 @@ class GaussianProcessGuider
          * stored, 2. the GP is updated with the new data point, 3. the prediction
          * is calculated to compensate the gear error and 4. the controller is
          * calculated, consisting of feedback and prediction parts.
+         * measurement_age is the time in seconds from the middle of the exposure to now,
+         * negative if unknown. The gear error is then predicted from the time of the
+         * measurement, which compensates the latency of the guide frames.
          */
-        double result(double input, double SNR, double time_step, double prediction_point = -1.0);
+        double result(double input, double SNR, double time_step, double prediction_point = -1.0,
+                      double measurement_age = -1.0);
 
         /**
          * This method provides predictive control if no measurement could be made.
@@ -371,7 +371,8 @@ void cgmath::processAxis(const int k, const bool dithering, const bool darkGuide
         return;
     }
     else if (useGPG && gpg->computePulse(arcsecDrift,
-                                         usingSEPMultiStar() ? &guideStars : nullptr, &pulseLength, &dir, calibration, timeStep))
+                                         usingSEPMultiStar() ? &guideStars : nullptr, &pulseLength, &dir, calibration, timeStep,
+                                         stageTimer.measurementAge()))
     {
         pulseDirection = dir;
         pulseLength = std::min(pulseLength, static_cast<int>(maxPulseMilliseconds + 0.5));
@@ -455,7 +456,7 @@ void cgmath::performProcessing(Ekos::GuideState state, QSharedPointer<FITSData>
             if (guideStarPosition.x != -1 && !std::isnan(guideStarPosition.x))
             {
                 gpg->suspended(guideStarPosition, targetPosition,
-                               usingSEPMultiStar() ? &guideStars : nullptr, calibration);
+                               usingSEPMultiStar() ? &guideStars : nullptr, calibration, stageTimer.measurementAge());
             }
         }
         // do nothing if suspended
@@ -466,6 +467,7 @@ void cgmath::performProcessing(Ekos::GuideState state, QSharedPointer<FITSData>
 
     // find guiding star location in the image
     starPosition = findLocalStarPosition(imageData, guideView, false);
+    stageTimer.mark(GuideStageTimer::STAR_DETECTED);
 
     // If no star found, mark as lost star.
     if (starPosition.x == -1 || std::isnan(starPosition.x))
@@ -27,6 +27,7 @@
 #include "calibration.h"
 
 #include "gpg.h"
+#include "guidestagetimer.h"
 
 class FITSData;
 class Edge;
@@ -103,6 +104,11 @@ class cgmath : public QObject
         {
             return *gpg;
         }
+        // Latency of the stages of the current guide frame.
+        GuideStageTimer &getStageTimer()
+        {
+            return stageTimer;
+        }
         const cproc_out_params *getOutputParameters() const
         {
             return &out_params;
@@ -218,6 +224,7 @@ class cgmath : public QObject
         GuideStars guideStars;
 
         std::unique_ptr<GPG> gpg;
+        GuideStageTimer stageTimer;
         Calibration calibration;
         bool configureInParams(Ekos::GuideState state);
         void updateOutParams(int k, const double arcsecDrift, int pulseLength, GuideDirection pulseDirection);
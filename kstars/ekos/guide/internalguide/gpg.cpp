@@ -136,6 +136,12 @@ void GPG::reset()
     qCDebug(KSTARS_EKOS_GUIDE) << "Resetting GPG";
 }
 
+void GPG::setClock(std::function<std::chrono::system_clock::time_point()> clock)
+{
+    gpg->SetClock(std::move(clock));
+    reset();
+}
+
 void GPG::startDithering(double dx, double dy, const Calibration &cal)
 {
     // convert the x and y offsets to RA and DEC offsets.
@@ -164,7 +170,7 @@ void GPG::ditheringSettled(bool success)
 void GPG::suspended(const GuiderUtils::Vector &guideStarPosition,
                     const GuiderUtils::Vector &reticlePosition,
                     GuideStars *guideStars,
-                    const Calibration &cal)
+                    const Calibration &cal, double measurementAge)
 {
     constexpr int MaxGpgSamplesForReset = 25;
     // We just reset the gpg if there's not enough samples to make
@@ -199,7 +205,8 @@ void GPG::suspended(const GuiderUtils::Vector &guideStarPosition,
 
     QElapsedTimer gpgTimer;
     gpgTimer.restart();
-    const double gpgResult = gpg->result(gpgInput, getSNR(guideStars, gpgInput), Options::guideExposure());
+    const double gpgResult = gpg->result(gpgInput, getSNR(guideStars, gpgInput), Options::guideExposure(), -1.0,
+                                         measurementAge);
     // Store the updated period length.
     std::vector<double> gpgParams = gpg->GetGPHyperparameters();
     Options::setGPGPeriod(gpgParams[PKPeriodLength]);
@@ -216,7 +223,7 @@ void GPG::suspended(const GuiderUtils::Vector &guideStarPosition,
 
 bool GPG::computePulse(double raArcsecError, GuideStars *guideStars,
                        int *pulseLength, GuideDirection *pulseDir,
-                       const Calibration &cal, Seconds timeStep)
+                       const Calibration &cal, Seconds timeStep, double measurementAge)
 {
     if (!Options::gPGEnabled())
         return false;
@@ -258,7 +265,8 @@ bool GPG::computePulse(double raArcsecError, GuideStars *guideStars,
     // Cast back to a raw double
     auto const rawTime = timeStep.count();
 
-    const double gpgResult = gpg->result(raArcsecError, getSNR(guideStars, raArcsecError), rawTime);
+    const double gpgResult = gpg->result(raArcsecError, getSNR(guideStars, raArcsecError), rawTime, -1.0,
+                                         measurementAge);
     const double gpgTime = gpgTimer.elapsed();
     gpgSamples++;
 
@@ -266,14 +274,15 @@ bool GPG::computePulse(double raArcsecError, GuideStars *guideStars,
     const double gpgPulse = convertCorrectionToPulseMilliseconds(cal, pulseLength, pulseDir, gpgResult);
 
     qCDebug(KSTARS_EKOS_GUIDE)
-            << QString("GPG: elapsed %1s. RA in %2, result: %3 * %4 --> %5 : %6ms %7")
+            << QString("GPG: elapsed %1s. RA in %2 (age %8s), result: %3 * %4 --> %5 : %6ms %7")
             .arg(gpgTime / 1000.0)
             .arg(raArcsecError, 0, 'f', 2)
             .arg(gpgResult, 0, 'f', 2)
             .arg(cal.raPulseMillisecondsPerArcsecond(), 0, 'f', 1)
             .arg(gpgPulse, 0, 'f', 1)
             .arg(*pulseLength)
-            .arg(directionStr(*pulseDir));
+            .arg(directionStr(*pulseDir))
+            .arg(measurementAge, 0, 'f', 2);
     if (Options::gPGEstimatePeriod())
     {
         double period_length = gpg->GetGPHyperparameters()[PKPeriodLength];
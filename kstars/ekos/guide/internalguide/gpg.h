@@ -28,6 +28,10 @@ class GPG
         // Restarts the gpg.
         void reset();
 
+        // Replaces the system clock that timestamps the measurements, and restarts the gpg.
+        // Used to replay guiding on a simulated timeline.
+        void setClock(std::function<std::chrono::system_clock::time_point()> clock);
+
         // Should be called when dithering starts.
         // Inputs are pixel offsets in camera coordinates.
         void startDithering(double dx, double dy, const Calibration &cal);
@@ -39,16 +43,20 @@ class GPG
         // Should be called while suspended, at the point when
         // guiding would normally occur. GPG gets updated but does not
         // emit a pulse.
+        // measurementAge is the time in seconds from the middle of the guide exposure
+        // to now, negative if unknown.
         void suspended(const GuiderUtils::Vector &guideStarPosition,
                        const GuiderUtils::Vector &reticlePosition,
                        GuideStars *guideStars,
-                       const Calibration &cal);
+                       const Calibration &cal, double measurementAge = -1);
 
         // Compute the RA pulse for guiding.
         // Returns false if it chooses not to compute a pulse.
+        // When measurementAge is known, the error is predicted from the time of the
+        // measurement instead of the time it is processed.
         bool computePulse(double raArcsecError, GuideStars *guideStars,
                           int *pulseLength, GuideDirection *pulseDir,
-                          const Calibration &cal, Seconds timeStep);
+                          const Calibration &cal, Seconds timeStep, double measurementAge = -1);
 
         double predictionContribution();
 
@@ -319,3 +319,8 @@ void GuideLog::settleCompletedInfo()
 {
     appendToLog("INFO: SETTLING STATE CHANGE, Settling complete\n");
 }
+
+void GuideLog::latencyInfo(const QString &statistics)
+{
+    appendToLog(QString("INFO: %1\n").arg(statistics));
+}
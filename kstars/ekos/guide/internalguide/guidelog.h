@@ -87,6 +87,7 @@ class GuideLog
         void resumeInfo();
         void settleStartedInfo();
         void settleCompletedInfo();
+        void latencyInfo(const QString &statistics);
 
         // Deal with suspend, resume, dither, ...
     private:
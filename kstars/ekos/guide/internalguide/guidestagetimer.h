@@ -0,0 +1,217 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+/*
+ * Times the processing stages of one guide frame, from the moment the frame reaches the
+ * internal guider to the moment its correction pulses are sent.
+ *
+ * When the start of the exposure is known, the timer also knows when the middle of the
+ * exposure was, which is when the guide star position was measured, and how long the
+ * frame took to arrive after the end of the exposure. All the times use the same
+ * monotonic clock, which setClock() may replace. Latency statistics are kept over the
+ * frames since resetStatistics().
+ */
+class GuideStageTimer
+{
+    public:
+        enum Stage
+        {
+            STAR_DETECTED,
+            DRIFT_COMPUTED,
+            PULSE_SENT,
+            STAGE_COUNT
+        };
+
+        GuideStageTimer()
+        {
+            m_Clock.start();
+        }
+
+        // Replaces the monotonic clock by nsecs, which returns nanoseconds. Used to replay
+        // guiding on a simulated timeline.
+        void setClock(std::function<qint64()> nsecs)
+        {
+            m_Now = std::move(nsecs);
+        }
+
+        // Called when the exposure of the next guide frame is requested.
+        void exposureStarted(double exposureSeconds)
+        {
+            m_NextExposureStart = now();
+            m_NextExposure = exposureSeconds;
+        }
+
+        // Called when a new guide frame is received.
+        void start()
+        {
+            m_FrameReceived = now();
+            m_Elapsed.fill(-1);
+
+            // The exposure belongs to this frame if the frame arrived after its end, and not much later.
+            const double sinceStart = (m_FrameReceived - m_NextExposureStart) / 1e9;
+            m_HasExposure = m_NextExposureStart >= 0 && m_NextExposure > 0
+                            && sinceStart >= m_NextExposure && sinceStart < m_NextExposure + MAX_DOWNLOAD_SECONDS;
+            m_ExposureStart = m_NextExposureStart;
+            m_Exposure = m_NextExposure;
+            m_NextExposureStart = -1;
+        }
+
+        // Records the time of stage since the frame was received.
+        void mark(Stage stage)
+        {
+            if (m_FrameReceived < 0)
+                return;
+            m_Elapsed[stage] = now() - m_FrameReceived;
+            if (stage == PULSE_SENT)
+                addStatistics();
+        }
+
+        // Milliseconds from the reception of the frame to stage, or -1 if the stage was not reached.
+        double elapsedMs(Stage stage) const
+        {
+            return m_Elapsed[stage] < 0 ? -1 : m_Elapsed[stage] / 1e6;
+        }
+
+        // Seconds from the middle of the exposure of the current frame to now, or -1 if unknown.
+        double measurementAge() const
+        {
+            if (!m_HasExposure)
+                return -1;
+            return (now() - m_ExposureStart) / 1e9 - m_Exposure / 2;
+        }
+
+        // Seconds from the end of the exposure of the current frame to its reception, or -1 if unknown.
+        double downloadSeconds() const
+        {
+            if (!m_HasExposure)
+                return -1;
+            return (m_FrameReceived - m_ExposureStart) / 1e9 - m_Exposure;
+        }
+
+        // Recent average of the seconds from the end of an exposure to its pulses, 0 if unknown.
+        double expectedLatency() const
+        {
+            return m_ExpectedLatency;
+        }
+
+        // One line description of the stage times, for the debug log.
+        QString toString() const
+        {
+            return QString("download %1 ms, detect %2 ms, drift %3 ms, pulse %4 ms")
+                   .arg(downloadSeconds() < 0 ? -1 : downloadSeconds() * 1000, 0, 'f', 1)
+                   .arg(elapsedMs(STAR_DETECTED), 0, 'f', 1)
+                   .arg(elapsedMs(DRIFT_COMPUTED), 0, 'f', 1)
+                   .arg(elapsedMs(PULSE_SENT), 0, 'f', 1);
+        }
+
+        void resetStatistics()
+        {
+            m_Statistics.fill(Statistic());
+            m_ExpectedLatency = 0;
+        }
+
+        // Number of frames in the latency statistics.
+        int statisticsCount() const
+        {
+            return m_Statistics[TOTAL_STAT].count;
+        }
+
+        // Mean and maximum time of each stage, in milliseconds, for the guide log.
+        QString statistics() const
+        {
+            static const std::array<const char *, STAT_COUNT> names { { "download", "detect", "drift", "pulse", "total" } };
+            QString text = QString("Guide latency over %1 frames (mean/max ms):").arg(statisticsCount());
+            for (int i = 0; i < STAT_COUNT; ++i)
+            {
+                const Statistic &stat = m_Statistics[i];
+                text += QString(" %1 %2/%3").arg(names[i])
+                        .arg(stat.count > 0 ? stat.sum / stat.count : 0, 0, 'f', 1)
+                        .arg(stat.max, 0, 'f', 1);
+                if (i < STAT_COUNT - 1)
+                    text += ",";
+            }
+            return text;
+        }
+
+    private:
+        // Longest time from the end of an exposure to the reception of its frame.
+        static constexpr double MAX_DOWNLOAD_SECONDS = 60.0;
+        // Weight of the last frame in the expected latency.
+        static constexpr double LATENCY_SMOOTHING = 0.2;
+
+        // The statistics of each stage only count its own time, total runs from the middle of the exposure to the pulses.
+        enum StatIndex
+        {
+            DOWNLOAD_STAT,
+            DETECT_STAT,
+            DRIFT_STAT,
+            PULSE_STAT,
+            TOTAL_STAT,
+            STAT_COUNT
+        };
+        struct Statistic
+        {
+            int count { 0 };
+            double sum { 0 };
+            double max { 0 };
+
+            void add(double ms)
+            {
+                if (ms < 0)
+                    return;
+                count++;
+                sum += ms;
+                max = std::max(max, ms);
+            }
+        };
+
+        qint64 now() const
+        {
+            return m_Now ? m_Now() : m_Clock.nsecsElapsed();
+        }
+
+        void addStatistics()
+        {
+            if (elapsedMs(STAR_DETECTED) < 0 || elapsedMs(DRIFT_COMPUTED) < 0)
+                return;
+
+            m_Statistics[DETECT_STAT].add(elapsedMs(STAR_DETECTED));
+            m_Statistics[DRIFT_STAT].add(elapsedMs(DRIFT_COMPUTED) - elapsedMs(STAR_DETECTED));
+            m_Statistics[PULSE_STAT].add(elapsedMs(PULSE_SENT) - elapsedMs(DRIFT_COMPUTED));
+            if (!m_HasExposure)
+                return;
+
+            m_Statistics[DOWNLOAD_STAT].add(downloadSeconds() * 1000);
+            m_Statistics[TOTAL_STAT].add(m_Exposure * 500 + downloadSeconds() * 1000 + elapsedMs(PULSE_SENT));
+
+            const double latency = downloadSeconds() + elapsedMs(PULSE_SENT) / 1000;
+            m_ExpectedLatency = m_ExpectedLatency <= 0 ? latency :
+                                (1 - LATENCY_SMOOTHING) * m_ExpectedLatency + LATENCY_SMOOTHING * latency;
+        }
+
+        QElapsedTimer m_Clock;
+        std::function<qint64()> m_Now;
+        // Times are nanoseconds of m_Clock, or of m_Now when set, -1 if unknown.
+        qint64 m_NextExposureStart { -1 };
+        double m_NextExposure { 0 };
+        qint64 m_ExposureStart { -1 };
+        double m_Exposure { 0 };
+        bool m_HasExposure { false };
+        qint64 m_FrameReceived { -1 };
+        std::array<qint64, STAGE_COUNT> m_Elapsed { { -1, -1, -1 } };
+
+        std::array<Statistic, STAT_COUNT> m_Statistics;
+        double m_ExpectedLatency { 0 };
+};
@@ -31,6 +31,9 @@
 // margin below (e.g. if a guide star was selected that was near the max guide-star hfr, the later
 // the hfr increased a little, we still want to be able to find it.
 constexpr double HFR_MARGIN = 2.0;
+
+// Don't accept reference stars whose position is more than this many pixels from expected.
+constexpr double MAX_STAR_ASSOCIATION_DISTANCE = 10;
 /*
  Start with a set of reference (x,y) positions from stars, where one is designated a guide star.
  Given these and a set of new input stars, determine a mapping of new stars to the references.
@@ -115,6 +118,7 @@ void GuideStars::setupStarCorrespondence(const QList<Edge> &neighbors, int guide
     }
     else
         starCorrespondence.reset();
+    lastGuideStarPosition = QPointF(-1, -1);
 }
 
 // Calls SEP to generate a set of star detections and score them,
@@ -292,10 +296,10 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     // If a user doesn't have multiple stars available, the user shouldn't be using multistar.
     constexpr int MAX_CONSECUTIVE_UNRELIABLE = 10;
     if (firstFrame)
+    {
         unreliableDectionCounter = 0;
-
-    // Don't accept reference stars whose position is more than this many pixels from expected.
-    constexpr double maxStarAssociationDistance = 10;
+        lastGuideStarPosition = QPointF(-1, -1);
+    }
 
     if (imageData == nullptr)
         return GuiderUtils::Vector(-1, -1, -1);
@@ -316,8 +320,16 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     const double maxHFR = Options::guideMaxHFR() + HFR_MARGIN;
     if (starCorrespondence.size() > 0)
     {
+        // When using large star-correspondence sets and filtering with a StellarSolver profile,
+        // the stars at the edge of detection can be lost. Best not to filter, but...
+        double minFraction = 0.5;
+        if (starCorrespondence.size() > 25) minFraction =  0.33;
+        else if (starCorrespondence.size() > 15) minFraction =  0.4;
 
-        findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+        // Stars only move a few pixels between guide frames. Search near their expected
+        // positions first, and only detect stars over the full frame if that fails.
+        if (!findStarsInWindows(imageData, trackingBox, maxHFR, minFraction))
+            findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
         if (detectedStars.empty())
             return GuiderUtils::Vector(-1, -1, -1);
 
@@ -327,13 +339,7 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
         // Star correspondence can run quicker if it knows the image size.
         starCorrespondence.setImageSize(imageData->width(), imageData->height());
 
-        // When using large star-correspondence sets and filtering with a StellarSolver profile,
-        // the stars at the edge of detection can be lost. Best not to filter, but...
-        double minFraction = 0.5;
-        if (starCorrespondence.size() > 25) minFraction =  0.33;
-        else if (starCorrespondence.size() > 15) minFraction =  0.4;
-
-        Edge foundStar = starCorrespondence.find(detectedStars, maxStarAssociationDistance, &starMap, true, minFraction);
+        Edge foundStar = starCorrespondence.find(detectedStars, MAX_STAR_ASSOCIATION_DISTANCE, &starMap, true, minFraction);
 
         // Is there a correspondence to the guide star
         // Should we also weight distance to the tracking box?
@@ -348,6 +354,7 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
                 unreliableDectionCounter = 0;
                 qCDebug(KSTARS_EKOS_GUIDE) << QString("StarCorrespondence found star %1 at %2 %3 SNR %4")
                                            .arg(i).arg(star.x, 0, 'f', 1).arg(star.y, 0, 'f', 1).arg(SNR, 0, 'f', 1);
+                lastGuideStarPosition = QPointF(star.x, star.y);
 
                 if (guideView != nullptr)
                     plotStars(guideView, trackingBox);
@@ -362,6 +369,7 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
             guideStarMass = foundStar.sum;
             unreliableDectionCounter = 0;  // debating this
             qCDebug(KSTARS_EKOS_GUIDE) << "StarCorrespondence invented at" << foundStar.x << foundStar.y << "SNR" << guideStarSNR;
+            lastGuideStarPosition = QPointF(foundStar.x, foundStar.y);
             if (guideView != nullptr)
                 plotStars(guideView, trackingBox);
             return GuiderUtils::Vector(foundStar.x, foundStar.y, 0);
@@ -369,6 +377,7 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     }
 
     qCDebug(KSTARS_EKOS_GUIDE) << "StarCorrespondence not used. It failed to find the guide star.";
+    lastGuideStarPosition = QPointF(-1, -1);
 
     if (++unreliableDectionCounter > MAX_CONSECUTIVE_UNRELIABLE)
         return GuiderUtils::Vector(-1, -1, -1);
@@ -426,6 +435,62 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     return GuiderUtils::Vector(-1, -1, -1);
 }
 
+bool GuideStars::findStarsInWindows(const QSharedPointer<FITSData> &imageData, const QRect &trackingBox,
+                                    double maxHFR, double minFraction)
+{
+    constexpr int MAX_WINDOW_SIZE = 128;
+
+    const int guideIndex = starCorrespondence.guideStar();
+    if (!Options::guideMultistarWindows() || guideIndex < 0 || lastGuideStarPosition.x() < 0)
+        return false;
+
+    // All stars moved like the guide star since it was selected.
+    const Edge guideReference = starCorrespondence.reference(guideIndex);
+    const QPointF offset = lastGuideStarPosition - QPointF(guideReference.x, guideReference.y);
+    QVector<QPointF> centers;
+    centers.reserve(starCorrespondence.size());
+    for (int i = 0; i < starCorrespondence.size(); ++i)
+    {
+        const Edge reference = starCorrespondence.reference(i);
+        centers.push_back(QPointF(reference.x, reference.y) + offset);
+    }
+
+    // Large enough for a star that moved as far as can be associated, and its wings.
+    int size = static_cast<int>(2 * (MAX_STAR_ASSOCIATION_DISTANCE + 3 * maxHFR));
+    if (trackingBox.isValid())
+        size = std::max(size, trackingBox.width());
+    size = std::min(size, MAX_WINDOW_SIZE);
+
+    // Detect with the same profile as over the full frame, so that the same stars are found.
+    const QList<SSolver::Parameters> profiles = Ekos::getOptionsProfiles(Ekos::GuideProfiles);
+    const int profileIndex = Options::guideOptionsProfile();
+    const SSolver::Parameters params = (profileIndex >= 0 && profileIndex < profiles.size()) ?
+                                       profiles[profileIndex] : SSolver::Parameters();
+    windowDetector.setParameters(params.minarea, params.deblend_thresh, params.deblend_contrast);
+
+    QList<Edge> stars;
+    SkyBackground background;
+    windowDetector.detect(imageData, centers, size, &stars, &background);
+    stars.erase(std::remove_if(stars.begin(), stars.end(), [maxHFR](const Edge & star)
+    {
+        return star.HFR > maxHFR;
+    }), stars.end());
+
+    const int minStars = std::max(MIN_STAR_CORRESPONDENCE_SIZE,
+                                  static_cast<int>(ceil(minFraction * starCorrespondence.size())));
+    if (stars.size() < minStars)
+    {
+        qCDebug(KSTARS_EKOS_GUIDE) << "Multistar: windows found" << stars.size() << "of" << starCorrespondence.size()
+                                   << "references, searching the full frame";
+        return false;
+    }
+
+    detectedStars = stars;
+    skyBackground = background;
+    m_NumStarsDetected = stars.size();
+    return true;
+}
+
 SSolver::Parameters GuideStars::getStarExtractionParameters(int num)
 {
     SSolver::Parameters params;
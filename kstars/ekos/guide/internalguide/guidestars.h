@@ -13,6 +13,7 @@
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitssepdetector.h"
 #include "starcorrespondence.h"
+#include "guidewindowdetector.h"
 #include "vect.h"
 #include "../guideview.h"
 #include "calibration.h"
@@ -123,6 +124,12 @@ class GuideStars
                           const QRect *roi = nullptr,
                           QList<double> *outputScores = nullptr,
                           QList<double> *minDistances = nullptr);
+        // Detects stars only near the positions where the reference stars are expected,
+        // given where the guide star was last found. Returns false, leaving the detections
+        // unchanged, if not enough stars are found that way.
+        bool findStarsInWindows(const QSharedPointer<FITSData> &imageData, const QRect &trackingBox,
+                                double maxHFR, double minFraction);
+
         // The interface to the SEP star detection algoritms.
         int findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge*> *sepStars, int num);
 
@@ -187,5 +194,10 @@ class GuideStars
 
         int m_NumStarsDetected { 0 };
 
+        // Windowed detection of the reference stars, and the last position of the guide star,
+        // from which the positions of the reference stars in the next frame are predicted.
+        GuideWindowDetector windowDetector;
+        QPointF lastGuideStarPosition { -1, -1 };
+
         friend class TestGuideStars;
 };
@@ -0,0 +1,217 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidewindowdetector.h"
+
+#include "ekos_guide_debug.h"
+#include "fitsviewer/sep/sep.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Windows smaller than this, e.g. clipped by the frame edges, are not searched.
+constexpr int MIN_WINDOW_SIZE = 8;
+
+// Detection threshold, in units of the background RMS, as in the default StellarSolver extraction.
+constexpr double THRESHOLD_SIGMA = 2.0;
+
+// Stars detected closer than this in two windows are the same star.
+constexpr double SAME_STAR_DISTANCE = 1.5;
+}
+
+int GuideWindowDetector::detect(const QSharedPointer<FITSData> &imageData, const QVector<QPointF> &centers, int size,
+                                QList<Edge> *stars, SkyBackground *background)
+{
+    stars->clear();
+    if (imageData.isNull() || centers.isEmpty() || size < MIN_WINDOW_SIZE)
+        return 0;
+
+    const QRect frame(0, 0, imageData->width(), imageData->height());
+    double meanSum = 0, sigmaSum = 0;
+    int numWindows = 0, numPixels = 0;
+
+    for (const auto &center : centers)
+    {
+        const QRect window = QRect(static_cast<int>(std::lround(center.x())) - size / 2,
+                                   static_cast<int>(std::lround(center.y())) - size / 2,
+                                   size, size).intersected(frame);
+        if (window.width() < MIN_WINDOW_SIZE || window.height() < MIN_WINDOW_SIZE)
+            continue;
+
+        if (!copyWindow(*imageData, window))
+            return 0;
+
+        Edge star;
+        double mean = 0, sigma = 0;
+        const bool found = detectInWindow(window, center, &star, &mean, &sigma);
+
+        // The background of every searched window counts, whether or not a star is in it.
+        if (sigma > 0)
+        {
+            meanSum += mean;
+            sigmaSum += sigma;
+            numPixels += window.width() * window.height();
+            numWindows++;
+        }
+        if (!found)
+            continue;
+
+        bool duplicate = false;
+        for (const auto &other : *stars)
+        {
+            if (std::hypot(other.x - star.x, other.y - star.y) < SAME_STAR_DISTANCE)
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate)
+            stars->append(star);
+    }
+
+    // Same fields as FITSSEPDetector sets from the full frame background.
+    if (numWindows > 0)
+    {
+        background->mean = meanSum / numWindows;
+        background->sigma = sigmaSum / numWindows;
+        background->numPixelsInSkyEstimate = numPixels;
+        background->setStarsDetected(stars->size());
+    }
+    return stars->size();
+}
+
+void GuideWindowDetector::setParameters(int minArea, int deblendThresholds, double deblendContrast)
+{
+    m_MinArea = minArea;
+    m_DeblendThresholds = deblendThresholds;
+    m_DeblendContrast = deblendContrast;
+}
+
+bool GuideWindowDetector::copyWindow(const FITSData &imageData, const QRect &window)
+{
+    // The buffer only grows, it is reused for all the windows of all the frames.
+    const int windowPixels = window.width() * window.height();
+    if (m_Window.size() < windowPixels)
+        m_Window.resize(windowPixels);
+
+    switch (imageData.dataType())
+    {
+        case TBYTE:
+            copyWindow<uint8_t>(imageData, window);
+            return true;
+        case TSHORT:
+            copyWindow<int16_t>(imageData, window);
+            return true;
+        case TUSHORT:
+            copyWindow<uint16_t>(imageData, window);
+            return true;
+        case TLONG:
+            copyWindow<int32_t>(imageData, window);
+            return true;
+        case TULONG:
+            copyWindow<uint32_t>(imageData, window);
+            return true;
+        case TFLOAT:
+            copyWindow<float>(imageData, window);
+            return true;
+        case TLONGLONG:
+            copyWindow<int64_t>(imageData, window);
+            return true;
+        case TDOUBLE:
+            copyWindow<double>(imageData, window);
+            return true;
+        default:
+            qCDebug(KSTARS_EKOS_GUIDE) << "Guide windows: unsupported data type" << imageData.dataType();
+            return false;
+    }
+}
+
+template <typename T>
+void GuideWindowDetector::copyWindow(const FITSData &imageData, const QRect &window)
+{
+    const T *image = reinterpret_cast<const T *>(imageData.getImageBuffer());
+    const int imageWidth = imageData.width();
+    float *out = m_Window.data();
+    for (int y = window.top(); y <= window.bottom(); ++y)
+    {
+        const T *row = image + static_cast<qint64>(y) * imageWidth + window.left();
+        for (int x = 0; x < window.width(); ++x)
+            *out++ = static_cast<float>(row[x]);
+    }
+}
+
+bool GuideWindowDetector::detectInWindow(const QRect &window, const QPointF &center, Edge *star,
+        double *mean, double *sigma)
+{
+    sep_image image = {m_Window.data(), nullptr, nullptr, SEP_TFLOAT, 0, 0,
+                       window.width(), window.height(), 0.0, SEP_NOISE_NONE, 1.0, 0.0
+                      };
+
+    // A single background tile covers the whole window.
+    sep_bkg *bkg = nullptr;
+    int status = sep_background(&image, window.width(), window.height(), 1, 1, 0.0, &bkg);
+    if (status != 0)
+    {
+        sep_bkg_free(bkg);
+        return false;
+    }
+    *mean = bkg->global;
+    *sigma = bkg->globalrms;
+
+    sep_catalog *catalog = nullptr;
+    float convolution[] = {1, 2, 1, 2, 4, 2, 1, 2, 1};
+    status = sep_bkg_subarray(bkg, image.data, image.dtype);
+    if (status == 0)
+        status = sep_extract(&image, THRESHOLD_SIGMA * bkg->globalrms, SEP_THRESH_ABS, m_MinArea, convolution, 3, 3,
+                             SEP_FILTER_CONV, m_DeblendThresholds, m_DeblendContrast, 1, 1.0, &catalog);
+    sep_bkg_free(bkg);
+
+    if (status != 0 || catalog == nullptr || catalog->nobj == 0)
+    {
+        sep_catalog_free(catalog);
+        return false;
+    }
+
+    // Keep the object closest to where the star was expected.
+    const double cx = center.x() - window.x();
+    const double cy = center.y() - window.y();
+    int best = 0;
+    double bestDistance = std::hypot(catalog->x[0] - cx, catalog->y[0] - cy);
+    for (int i = 1; i < catalog->nobj; ++i)
+    {
+        const double distance = std::hypot(catalog->x[i] - cx, catalog->y[i] - cy);
+        if (distance < bestDistance)
+        {
+            best = i;
+            bestDistance = distance;
+        }
+    }
+
+    const double x = catalog->x[best];
+    const double y = catalog->y[best];
+    const double a = catalog->a[best];
+    const double b = catalog->b[best];
+
+    // Half flux radius, measured on the background subtracted window.
+    double fraction = 0.5, hfr = 0;
+    short flag = 0;
+    if (sep_flux_radius(&image, x, y, std::max(4 * a, 3.0), 5, 0, nullptr, &fraction, 1, &hfr, &flag) != 0)
+        hfr = 0;
+
+    star->x = x + window.x();
+    star->y = y + window.y();
+    star->val = static_cast<int>(catalog->peak[best]);
+    star->sum = catalog->flux[best];
+    star->HFR = hfr;
+    star->width = a;
+    star->numPixels = catalog->npix[best];
+    star->ellipticity = a > 0 ? 1 - b / a : 0;
+
+    sep_catalog_free(catalog);
+    return true;
+}
@@ -0,0 +1,56 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QRect>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitssepdetector.h"
+
+/*
+ * Detects guide stars with SEP, but only in small square windows around the positions
+ * where they are expected, instead of over the whole guide frame.
+ * Each window is copied into a float buffer that is kept from frame to frame, so that
+ * steady-state guiding does not allocate image memory. The background of each window is
+ * estimated separately, and the results are combined into one SkyBackground so that star
+ * SNRs can be compared with those of a full-frame detection.
+ */
+class GuideWindowDetector
+{
+    public:
+        GuideWindowDetector() {}
+        ~GuideWindowDetector() {}
+
+        // Detects the star nearest the center of each window of size x size pixels centered on centers.
+        // Stars are returned in image coordinates, a star found in several windows is only returned once.
+        // Returns the number of stars detected.
+        int detect(const QSharedPointer<FITSData> &imageData, const QVector<QPointF> &centers, int size,
+                   QList<Edge> *stars, SkyBackground *background);
+
+        // Sets the extraction parameters, those of the star extraction profile used over the full frame.
+        void setParameters(int minArea, int deblendThresholds, double deblendContrast);
+
+    private:
+        // Copies the window of the first channel of the image into m_Window, as floats.
+        bool copyWindow(const FITSData &imageData, const QRect &window);
+        template <typename T>
+        void copyWindow(const FITSData &imageData, const QRect &window);
+
+        // Runs SEP on the window copied in m_Window. Returns false if nothing is detected.
+        bool detectInWindow(const QRect &window, const QPointF &center, Edge *star, double *mean, double *sigma);
+
+        QVector<float> m_Window;
+
+        // Defaults of the guide star extraction profile.
+        int m_MinArea { 10 };
+        int m_DeblendThresholds { 32 };
+        double m_DeblendContrast { 0.005 };
+};
@@ -120,6 +120,8 @@ bool InternalGuider::guide()
         GuideLog::GuideInfo info;
         fillGuideInfo(&info);
         guideLog.startGuiding(info);
+        pmath->getStageTimer().resetStatistics();
+        m_LatencyLogCount = 0;
     }
     state = GUIDE_GUIDING;
 
@@ -144,6 +146,12 @@ bool InternalGuider::abort()
     // calibrationStage = CAL_IDLE; remove totally when understand trackingStarSelected
 
     logFile.close();
+    if (pmath->getStageTimer().statisticsCount() > 0)
+    {
+        guideLog.latencyInfo(pmath->getStageTimer().statistics());
+        pmath->getStageTimer().resetStatistics();
+        m_LatencyLogCount = 0;
+    }
     guideLog.endGuiding();
     emit guideInfo("");
 
@@ -684,8 +692,14 @@ void InternalGuider::setGuideView(const QSharedPointer<GuideView> &guideView)
     m_GuideFrame = guideView;
 }
 
+void InternalGuider::setExposureStarted(double exposureSeconds)
+{
+    pmath->getStageTimer().exposureStarted(exposureSeconds);
+}
+
 void InternalGuider::setImageData(const QSharedPointer<FITSData> &data)
 {
+    pmath->getStageTimer().start();
     m_ImageData = data;
     if (Options::saveGuideImages())
     {
@@ -850,6 +864,7 @@ bool InternalGuider::processGuiding()
     {
         auto const timeStep = calculateGPGTimeStep();
         pmath->performProcessing(state, m_ImageData, m_GuideFrame, timeStep, &guideLog);
+        pmath->getStageTimer().mark(GuideStageTimer::DRIFT_COMPUTED);
         if (pmath->usingSEPMultiStar())
         {
             QString info = "";
@@ -895,6 +910,15 @@ bool InternalGuider::processGuiding()
     {
         emit newMultiPulse(out->pulse_dir[GUIDE_RA], out->pulse_length[GUIDE_RA],
                            out->pulse_dir[GUIDE_DEC], out->pulse_length[GUIDE_DEC], StartCaptureAfterPulses);
+
+        // Only frames with pulses count in the latency statistics
+        pmath->getStageTimer().mark(GuideStageTimer::PULSE_SENT);
+        qCDebug(KSTARS_EKOS_GUIDE) << "Guide frame latency:" << pmath->getStageTimer().toString();
+        if (pmath->getStageTimer().statisticsCount() >= m_LatencyLogCount + LATENCY_LOG_FRAMES)
+        {
+            m_LatencyLogCount = pmath->getStageTimer().statisticsCount();
+            guideLog.latencyInfo(pmath->getStageTimer().statistics());
+        }
     }
     else
         emit frameCaptureRequested();
@@ -920,20 +944,24 @@ bool InternalGuider::processGuiding()
 
 
 // Here we calculate the time until the next time we will be emitting guiding corrections.
+// The corrections of a frame are emitted after its exposure, its download and its processing.
 std::pair<Seconds, Seconds> InternalGuider::calculateGPGTimeStep()
 {
     Seconds timeStep;
 
     const Seconds guideDelay{(Options::guideDelay())};
+    const Seconds latency{pmath->getStageTimer().expectedLatency()};
 
-    auto const captureInterval = Seconds(m_captureTimer->intervalAsDuration()) + guideDelay;
+    auto const captureInterval = Seconds(m_captureTimer->intervalAsDuration()) + guideDelay + latency;
     auto const darkGuideInterval = Seconds(m_darkGuideTimer->intervalAsDuration());
 
     if (!Options::gPGDarkGuiding() || !isInferencePeriodFinished())
     {
         return std::pair<Seconds, Seconds>(captureInterval, captureInterval);
     }
-    auto const captureTimeRemaining = Seconds(m_captureTimer->remainingTimeAsDuration()) + guideDelay;
+    auto captureTimeRemaining = Seconds(m_captureTimer->remainingTimeAsDuration()) + guideDelay;
+    if (captureTimeRemaining > Seconds::zero())
+        captureTimeRemaining += latency;
     auto const darkGuideTimeRemaining = Seconds(m_darkGuideTimer->remainingTimeAsDuration());
     // Are both firing at the same time (or at least, both due)?
     if (captureTimeRemaining <= Seconds::zero()
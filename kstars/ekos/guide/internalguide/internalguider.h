@@ -90,6 +90,8 @@ class InternalGuider : public GuideInterface
         void setGuideView(const QSharedPointer<GuideView> &guideView);
         // Image Data
         void setImageData(const QSharedPointer<FITSData> &data);
+        // Called when the exposure of a guide frame is started.
+        void setExposureStarted(double exposureSeconds);
 
         bool start();
 
@@ -162,6 +164,8 @@ class InternalGuider : public GuideInterface
 
         QElapsedTimer reacquireTimer;
         int m_highRMSCounter {0};
+        // Number of frames in the latency statistics when they were last logged
+        int m_LatencyLogCount {0};
 
         GuiderUtils::Matrix ROT_Z;
         Ekos::GuideState rememberState { GUIDE_IDLE };
@@ -178,6 +182,8 @@ class InternalGuider : public GuideInterface
 
         // How many high RMS pulses before we stop
         static const uint8_t MAX_RMS_THRESHOLD = 10;
+        // Guide frames between two latency statistics in the guide log
+        static const int LATENCY_LOG_FRAMES = 100;
         // How many lost stars before we stop
         static const uint8_t MAX_LOST_STAR_THRESHOLD = 5;
 
@@ -6,87 +6,117 @@
 
 #include "starcorrespondence.h"
 
+#include <algorithm>
+#include <cmath>
 #include <math.h>
 #include "ekos_guide_debug.h"
 
-// Finds the star in sortedStars that's closest to x,y and within maxDistance pixels.
-// Returns the index of the closest star in  sortedStars, or -1 if none satisfies the criteria.
-// sortedStars must be sorted by x, from lower x to higher x.
-// Fills distance to the pixel distance to the closest star.
-int StarCorrespondence::findClosestStar(double x, double y, const QList<Edge> sortedStars,
-                                        double maxDistance, double *distance) const
+namespace
 {
-    if (x < -maxDistance || y < -maxDistance ||
-            x > imageWidth + maxDistance || y > imageWidth + maxDistance)
-        return -1;
+// Sparse fields get larger cells, so that the grid has at most this many cells per star.
+constexpr int MAX_CELLS_PER_STAR = 4;
+}  // namespace
 
-    const int size = sortedStars.size();
-    int startPoint = 0;
+void StarCorrespondence::buildGrid(const QList<Edge> &stars, double maxDistance)
+{
+    StarGrid &grid = m_Grid;
+    const int numStars = stars.size();
+    grid.x.resize(numStars);
+    grid.y.resize(numStars);
+    if (numStars == 0)
+    {
+        grid.columns = grid.rows = 0;
+        return;
+    }
 
-    // Efficiency improvement to quickly find the start point.
-    // Increments by size/10 to find a better start point.
-    const int coarseIncrement = size / 10;
-    if (coarseIncrement > 1)
+    double maxX = stars[0].x, maxY = stars[0].y;
+    grid.minX = maxX;
+    grid.minY = maxY;
+    for (int i = 0; i < numStars; ++i)
     {
-        for (int i = 0; i < size; i += coarseIncrement)
-        {
-            if (sortedStars[i].x < x - maxDistance)
-                startPoint = i;
-            else
-                break;
-        }
+        grid.x[i] = stars[i].x;
+        grid.y[i] = stars[i].y;
+        grid.minX = std::min(grid.minX, static_cast<double>(grid.x[i]));
+        grid.minY = std::min(grid.minY, static_cast<double>(grid.y[i]));
+        maxX = std::max(maxX, static_cast<double>(grid.x[i]));
+        maxY = std::max(maxY, static_cast<double>(grid.y[i]));
     }
 
-    // Iterate through the stars starting with the star with lowest x where x >= x - maxDistance
-    // through the star with greatest x where x <= x + maxDistance.  Find the closest star to x,y.
+    grid.cellSize = std::max(maxDistance, 1.0);
+    const qint64 maxCells = static_cast<qint64>(MAX_CELLS_PER_STAR) * numStars + 16;
+    for (;;)
+    {
+        grid.columns = static_cast<int>((maxX - grid.minX) / grid.cellSize) + 1;
+        grid.rows = static_cast<int>((maxY - grid.minY) / grid.cellSize) + 1;
+        if (static_cast<qint64>(grid.columns) * grid.rows <= maxCells)
+            break;
+        grid.cellSize *= 2;
+    }
+
+    // Counting sort of the stars by cell.
+    const int numCells = grid.columns * grid.rows;
+    grid.cellStart.fill(0, numCells + 1);
+    grid.starCell.resize(numStars);
+    for (int i = 0; i < numStars; ++i)
+    {
+        const int column = static_cast<int>((grid.x[i] - grid.minX) / grid.cellSize);
+        const int row = static_cast<int>((grid.y[i] - grid.minY) / grid.cellSize);
+        grid.starCell[i] = row * grid.columns + column;
+        grid.cellStart[grid.starCell[i] + 1]++;
+    }
+    for (int cell = 0; cell < numCells; ++cell)
+        grid.cellStart[cell + 1] += grid.cellStart[cell];
+
+    grid.cellFill.resize(numCells);
+    std::copy(grid.cellStart.constBegin(), grid.cellStart.constBegin() + numCells, grid.cellFill.begin());
+    grid.cellStars.resize(numStars);
+    for (int i = 0; i < numStars; ++i)
+        grid.cellStars[grid.cellFill[grid.starCell[i]]++] = i;
+}
+
+// Finds the star that's closest to x,y and within maxDistance pixels.
+// Returns the index of the closest star in the input stars, or -1 if none satisfies the criteria.
+// Fills distance to the pixel distance to the closest star.
+int StarCorrespondence::findClosestStar(double x, double y, double maxDistance, double *distance) const
+{
+    const StarGrid &grid = m_Grid;
+    if (distance != nullptr) *distance = maxDistance;
+    if (grid.columns == 0 || x < -maxDistance || y < -maxDistance ||
+            x > imageWidth + maxDistance || y > imageHeight + maxDistance)
+        return -1;
+
+    const int column = static_cast<int>(std::floor((x - grid.minX) / grid.cellSize));
+    const int row = static_cast<int>(std::floor((y - grid.minY) / grid.cellSize));
+    if (column < -1 || row < -1 || column > grid.columns || row > grid.rows)
+        return -1;
+
+    // Ties go to the star with the highest index, so that the result doesn't depend on the cell order.
     int bestIndex = -1;
     double bestSquaredDistance = maxDistance * maxDistance;
-    for (int i = startPoint; i < size; ++i)
+    for (int r = std::max(row - 1, 0); r <= std::min(row + 1, grid.rows - 1); ++r)
     {
-        auto &star = sortedStars[i];
-        if (star.x < x - maxDistance) continue;
-        if (star.x > x + maxDistance) break;
-        const double xDiff = star.x - x;
-        const double yDiff = star.y - y;
-        const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
-        if (squaredDistance <= bestSquaredDistance)
+        for (int c = std::max(column - 1, 0); c <= std::min(column + 1, grid.columns - 1); ++c)
         {
-            bestIndex = i;
-            bestSquaredDistance = squaredDistance;
+            const int cell = r * grid.columns + c;
+            for (int k = grid.cellStart[cell]; k < grid.cellStart[cell + 1]; ++k)
+            {
+                const int i = grid.cellStars[k];
+                const double xDiff = grid.x[i] - x;
+                const double yDiff = grid.y[i] - y;
+                const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
+                if (squaredDistance < bestSquaredDistance ||
+                        (squaredDistance == bestSquaredDistance && i > bestIndex))
+                {
+                    bestIndex = i;
+                    bestSquaredDistance = squaredDistance;
+                }
+            }
         }
     }
     if (distance != nullptr) *distance = sqrt(bestSquaredDistance);
     return bestIndex;
 }
 
-namespace
-{
-// Sorts stars by their x values, places the sorted stars into sortedStars.
-// sortedToOriginal is a map whose index is the index of a star in sortedStars and whose
-// value is the index of a star in stars.
-// Therefore, sortedToOrigial[a] = b, means that sortedStars[a] corresponds to stars[b].
-void sortByX(const QList<Edge> &stars, QList<Edge> *sortedStars, QVector<int> *sortedToOriginal)
-{
-    sortedStars->clear();
-    sortedToOriginal->clear();
-
-    // Sort the stars by their x-positions, lower to higher.
-    QVector<std::pair<int, float>> rx;
-    for (int i = 0; i < stars.size(); ++i)
-        rx.push_back(std::pair<int, float>(i, stars[i].x));
-    std::sort(rx.begin(), rx.end(), [](const std::pair<int, float> &a, const std::pair<int, double> &b)
-    {
-        return a.second < b.second;
-    });
-    for (int i = 0; i < stars.size(); ++i)
-    {
-        sortedStars->append(stars[ rx[i].first ]);
-        sortedToOriginal->push_back(rx[i].first);
-    }
-}
-
-}  // namespace
-
 StarCorrespondence::StarCorrespondence(const QList<Edge> &stars, int guideStar)
 {
     initialize(stars, guideStar);
@@ -133,9 +163,9 @@ void StarCorrespondence::reset()
     initialized = false;
 }
 
-int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+int StarCorrespondence::findInternal(double maxDistance, QVector<int> *starMap,
                                      int guideStarIndex, const QVector<Offsets> &offsets,
-                                     int *numFound, int *numNotFound, double minFraction) const
+                                     int *numFound, int *numNotFound, double minFraction)
 {
     // This is the cost of not finding one of the reference stars.
     constexpr double missingRefStarCost = 100;
@@ -143,7 +173,8 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
     constexpr double distanceWeight = 1.0;
 
     // Initialize all stars to not-corresponding to any reference star.
-    *starMap = QVector<int>(stars.size(), -1);
+    const int numStars = m_Grid.x.size();
+    starMap->fill(-1, numStars);
 
     // We won't accept a solution worse than bestCost.
     // In the default case, we need to find about half the reference stars.
@@ -154,20 +185,19 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
     int bestCost = offsets.size() * missingRefStarCost * (1 - minFraction);
     // Note that the above implies that if stars.size() < offsets.size() * minFraction
     // then it is impossible to succeed.
-    if (stars.size() < minFraction * offsets.size())
+    if (numStars < minFraction * offsets.size())
         return -1;
 
     // Assume the guide star corresponds to each of the stars.
     // Score the assignment, pick the best, and then assign the rest.
-    const int numStars = stars.size();
     int bestStarIndex = -1, bestNumFound = 0, bestNumNotFound = 0;
     for (int starIndex = 0; starIndex < numStars; ++starIndex)
     {
-        const float starX = stars[starIndex].x;
-        const float starY = stars[starIndex].y;
+        const float starX = m_Grid.x[starIndex];
+        const float starY = m_Grid.y[starIndex];
 
         double cost = 0.0;
-        QVector<int> mapping(stars.size(), -1);
+        m_Matches.clear();
         int numFound = 0, numNotFound = 0;
         for (int offsetIndex = 0; offsetIndex < offsets.size(); ++offsetIndex)
         {
@@ -178,11 +208,10 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
             if (cost > bestCost) break;
 
             // Look for an input star at the offset position.
-            // Note the index value returned is the sorted index, which is converted back later.
             const auto &offset = offsets[offsetIndex];
             double distance;
             const int closestIndex = findClosestStar(starX + offset.x, starY + offset.y,
-                                     stars, maxDistance, &distance);
+                                     maxDistance, &distance);
             if (closestIndex < 0)
             {
                 // This reference star position had no corresponding input star.
@@ -194,7 +223,7 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
 
             // If starIndex is the star that corresponds to guideStarIndex, then
             // stars[index] corresponds to references[offsetIndex]
-            mapping[closestIndex] = offsetIndex;
+            m_Matches.append(qMakePair(closestIndex, offsetIndex));
             cost += distance * distanceWeight;
         }
         if (cost < bestCost)
@@ -204,9 +233,10 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
             bestNumFound = numFound;
             bestNumNotFound = numNotFound;
 
-            *starMap = QVector<int>(stars.size(), -1);
-            for (int i = 0; i < mapping.size(); ++i)
-                (*starMap)[i] = mapping[i];
+            // Later matches of the same star replace the earlier ones.
+            starMap->fill(-1);
+            for (const auto &match : m_Matches)
+                (*starMap)[match.first] = match.second;
             (*starMap)[starIndex] = guideStarIndex;
         }
     }
@@ -240,12 +270,15 @@ void StarCorrespondence::makeOffsets(const QVector<Offsets> &offsets, QVector<Of
 
 // We create an imaginary star from the ones we did find.
 Edge StarCorrespondence::inventStarPosition(const QList<Edge> &stars, const QVector<int> &starMap,
-        QVector<Offsets> offsets, Offsets offset) const
+        const QVector<Offsets> &offsets, Offsets offset)
 {
     Edge inventedStar;
     inventedStar.invalidate();
 
-    QVector<double> xPositions, yPositions;
+    QVector<double> &xPositions = m_XPositions;
+    QVector<double> &yPositions = m_YPositions;
+    xPositions.clear();
+    yPositions.clear();
     float refSum = 0, origSum = 0, refNumPixels = 0, origNumPixels = 0;
     for (int i = 0; i < starMap.size(); ++i)
     {
@@ -305,43 +338,25 @@ Edge StarCorrespondence::inventStarPosition(const QList<Edge> &stars, const QVec
     return inventedStar;
 }
 
-namespace
-{
-// This utility converts the starMap to refer to indexes in the original star QVector
-// instead of the sorted-by-x version.
-void unmapStarMap(const QVector<int> &sortedStarMap, const QVector<int> &sortedToOriginal, QVector<int> *starMap)
-{
-    for (int i = 0; i < sortedStarMap.size(); ++i)
-        (*starMap)[sortedToOriginal[i]] = sortedStarMap[i];
-}
-}
-
 Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
                               QVector<int> *starMap, bool adapt, double minFraction)
 {
     m_NumReferencesFound = 0;
-    *starMap = QVector<int>(stars.size(), -1);
+    starMap->fill(-1, stars.size());
     Edge foundStar;
     foundStar.invalidate();
     if (!initialized)  return foundStar;
     int numFound, numNotFound;
 
-    // findClosestStar needs an input with stars sorted by their x.
+    // findClosestStar searches the grid of the input stars.
     // Do this outside of the loops.
-    QList<Edge> sortedStars;
-    QVector<int> sortedToOriginal;
-    sortByX(stars, &sortedStars, &sortedToOriginal);
+    buildGrid(stars, maxDistance);
 
-    QVector<int> sortedStarMap;
-    int bestStarIndex = findInternal(sortedStars, maxDistance, &sortedStarMap, guideStarIndex,
+    int bestStarIndex = findInternal(maxDistance, starMap, guideStarIndex,
                                      guideStarOffsets, &numFound, &numNotFound, minFraction);
 
     if (bestStarIndex > -1)
     {
-        // Convert back to the unsorted index value.
-        bestStarIndex = sortedToOriginal[bestStarIndex];
-        unmapStarMap(sortedStarMap, sortedToOriginal, starMap);
-
         foundStar = stars[bestStarIndex];
         qCDebug(KSTARS_EKOS_GUIDE)
                 << "StarCorrespondence found guideStar at " << bestStarIndex << "found/not"
@@ -364,15 +379,14 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
         {
             if (gStarIndex == guideStarIndex)
                 continue;
-            QVector<Offsets> gStarOffsets;
+            QVector<Offsets> &gStarOffsets = m_CandidateOffsets;
             makeOffsets(guideStarOffsets, &gStarOffsets, gStarIndex);
-            QVector<int> newStarMap;
-            int detectedStarIndex = findInternal(sortedStars, maxDistance, &newStarMap,
+            int detectedStarIndex = findInternal(maxDistance, &m_CandidateMap,
                                                  gStarIndex, gStarOffsets,
                                                  &numFound, &numNotFound, minFraction);
             if (detectedStarIndex >= 0 && numFound > bestNumFound)
             {
-                Edge invented = inventStarPosition(sortedStars, newStarMap, gStarOffsets,
+                Edge invented = inventStarPosition(stars, m_CandidateMap, gStarOffsets,
                                                    guideStarOffsets[gStarIndex]);
                 if (invented.x < 0 || invented.y < 0)
                     continue;
@@ -380,7 +394,8 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
                 bestInvented = invented;
                 bestNumFound = numFound;
                 bestNumNotFound = numNotFound;
-                sortedStarMap = newStarMap;
+                // The buffer of the previous best map is reused for the next candidates.
+                starMap->swap(m_CandidateMap);
 
                 if (numNotFound <= 1)
                     // We can't do better than this.
@@ -389,8 +404,6 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
         }
         if (bestNumFound > 0)
         {
-            // Convert back to the unsorted index value.
-            unmapStarMap(sortedStarMap, sortedToOriginal, starMap);
             qCDebug(KSTARS_EKOS_GUIDE)
                     << "StarCorrespondence found guideStar (invented) at "
                     << bestInvented.x << bestInvented.y << "found/not" << bestNumFound << bestNumNotFound;
@@ -8,6 +8,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QPair>
 #include <QVector>
 #include <QVector2D>
 
@@ -111,9 +112,10 @@ class StarCorrespondence
         void adaptOffsets(const QList<Edge> &stars, const QVector<int> &starMap);
 
         // Utility used by find. Useful for iterating when the guide star is missing.
-        int findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+        // Works on the stars in m_Grid, built by buildGrid().
+        int findInternal(double maxDistance, QVector<int> *starMap,
                          int guideStarIndex, const QVector<Offsets> &offsets,
-                         int *numFound, int *numNotFound, double minFraction) const;
+                         int *numFound, int *numNotFound, double minFraction);
 
         // Used to when guide star is missing. Creates offsets as if other stars were the guide star.
         void makeOffsets(const QVector<Offsets> &offsets, QVector<Offsets> *targetOffsets, int targetStar) const;
@@ -125,12 +127,13 @@ class StarCorrespondence
         // StarMap is the map made for that substitude by findInternal().
         // Offset is the offset from the original guide star to that substitute guide star.
         Edge inventStarPosition(const QList<Edge> &stars, const QVector<int> &starMap,
-                                QVector<Offsets> offsets, Offsets offset) const;
+                                const QVector<Offsets> &offsets, Offsets offset);
 
-        // Finds the star closest to x,y. Returns the index in sortedStars.
-        // sortedStars should be sorted in x, which allows for a speedup in search.
-        int findClosestStar(double x, double y, const QList<Edge> sortedStars,
-                            double maxDistance, double *distance) const;
+        // Stores the positions of the input stars in m_Grid and indexes them by cell.
+        void buildGrid(const QList<Edge> &stars, double maxDistance);
+
+        // Finds the star of m_Grid closest to x,y. Returns its index in the input stars.
+        int findClosestStar(double x, double y, double maxDistance, double *distance) const;
 
         // The offsets of the reference stars relative to the guide star.
         QVector<Offsets> guideStarOffsets;
@@ -159,5 +162,28 @@ class StarCorrespondence
 
         // A copy of the original reference offsets used so that the values don't move too far.
         QVector<Offsets> originalGuideStarOffsets;
+
+        // The input stars of the current find(), with a grid of cells at least maxDistance wide.
+        // The stars within maxDistance of a position are then in the 3x3 cells around it, so a
+        // closest star search only looks at a few stars whatever the number of stars.
+        struct StarGrid
+        {
+            QVector<float> x, y;      // Star positions, in the order of the input stars.
+            QVector<int> cellStart;   // Index in cellStars of the first star of each cell, and the end.
+            QVector<int> cellStars;   // Star indexes, grouped by cell.
+            QVector<int> starCell;    // Cell of each star, used while building.
+            QVector<int> cellFill;    // Next free position of each cell, used while building.
+            double minX { 0 }, minY { 0 };
+            double cellSize { 1 };
+            int columns { 0 }, rows { 0 };
+        };
+        StarGrid m_Grid;
+
+        // Buffers reused by every find(), so that matching does not allocate once they have grown.
+        // Pairs of (input star index, reference index) matched for one guide star candidate.
+        QVector<QPair<int, int>> m_Matches;
+        QVector<int> m_CandidateMap;
+        QVector<Offsets> m_CandidateOffsets;
+        QVector<double> m_XPositions, m_YPositions;
 };
 
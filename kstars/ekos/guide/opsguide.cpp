@@ -53,12 +53,7 @@ OpsGuide::OpsGuide() : QFrame(KStars::Instance())
 
 void OpsGuide::loadOptionsProfiles()
 {
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                            QStandardPaths::AppLocalDataLocation)).filePath("SavedGuideProfiles.ini");
-    if(QFile(savedOptionsProfiles).exists())
-        optionsList = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        optionsList = getDefaultGuideOptionsProfiles();
+    optionsList = getOptionsProfiles(GuideProfiles);
     kcfg_GuideOptionsProfile->clear();
     for(SSolver::Parameters param : optionsList)
         kcfg_GuideOptionsProfile->addItem(param.listName);
@@ -28,9 +28,12 @@
 #include "ekos/capture/placeholderpath.h"
 #include "skyobjects/starobject.h"
 #include "greedyscheduler.h"
+#include "tools/satellitepasspredictor.h"
 
 #include <KConfigDialog>
 #include <KActionCollection>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 #include <fitsio.h>
 #include <ekos_scheduler_debug.h>
@@ -4751,9 +4754,54 @@ void Scheduler::startCapture(bool restart)
     else
         appendLogText(i18n("Job '%1' capture is in progress...", currentJob->getName()));
 
+    if (Options::schedulerSatelliteCrossings())
+        checkSatelliteCrossings(currentJob);
+
     startCurrentOperationTimer();
 }
 
+void Scheduler::checkSatelliteCrossings(SchedulerJob *job)
+{
+    const QList<Satellite *> satellites = SatellitePassPredictor::selectedSatellites();
+    if (satellites.isEmpty())
+        return;
+
+    // Check the remaining capture time of the job, bounded to a single night
+    const double startJD = KStarsData::Instance()->clock()->utc().djd();
+    int64_t duration = job->getEstimatedTime();
+    if (duration <= 0)
+        duration = 3600;
+    const double stopJD = startJD + std::min<int64_t>(duration, 12 * 3600) / 86400.0;
+
+    // Satellites are cloned here on the GUI thread, the search itself runs in the background
+    auto predictor = std::make_shared<SatellitePassPredictor>(KStarsData::Instance()->geo());
+    predictor->setSatellites(satellites);
+
+    const SkyPoint target = job->getTargetCoords();
+    const double radius = Options::schedulerSatelliteCrossingRadius();
+    const QString jobName = job->getName();
+
+    auto watcher = new QFutureWatcher<QVector<SatellitePassPredictor::Crossing>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, jobName]()
+    {
+        const auto crossings = watcher->result();
+        watcher->deleteLater();
+
+        for (const auto &crossing : crossings)
+        {
+            const QDateTime ingress = KStarsData::Instance()->geo()->UTtoLT(KStarsDateTime(crossing.ingressJD));
+            appendLogText(i18n("Warning: satellite %1 is predicted to cross the field of job '%2' at %3 (%4° from center).",
+                               crossing.name, jobName, ingress.toString("hh:mm:ss"),
+                               QString::number(crossing.separation, 'f', 2)));
+        }
+    });
+
+    watcher->setFuture(QtConcurrent::run([predictor, target, radius, startJD, stopJD]()
+    {
+        return predictor->findCrossings(target, radius, startJD, stopJD);
+    }));
+}
+
 void Scheduler::stopGuiding()
 {
     if (!guideInterface)
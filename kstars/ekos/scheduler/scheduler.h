@@ -936,6 +936,12 @@ class Scheduler : public QWidget, public Ui::Scheduler
         // Returns true if the job is storing its captures on the same machine as the scheduler.
         bool canCountCaptures(const SchedulerJob &job);
 
+        /**
+         * @brief checkSatelliteCrossings Predict in the background which selected satellites cross the field
+         * of the job during its expected capture time, and warn about them in the log.
+         */
+        void checkSatelliteCrossings(SchedulerJob *job);
+
         /**
          * @brief checkRepeatSequence Check if the entire job sequence might be repeated
          * @return true if the checkbox is set and the number of iterations is below the
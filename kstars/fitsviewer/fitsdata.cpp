@@ -123,9 +123,7 @@ FITSData::~FITSData()
     }
 #endif
 
-    if (starCenters.count() > 0)
-        qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
 
     if (m_SkyObjects.count() > 0)
         qDeleteAll(m_SkyObjects);
@@ -144,8 +142,7 @@ FITSData::~FITSData()
 void FITSData::loadCommon(const QString &inFilename)
 {
     int status = 0;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
 
     if (fptr != nullptr)
     {
@@ -2040,8 +2037,7 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
         m_StarFindFuture.waitForFinished();
 
     starAlgorithm = algorithm;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    clearStarCenters();
     starsSearched = true;
 
     switch (algorithm)
@@ -2691,6 +2687,24 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
     }
 }
 
+void FITSData::setStars(QVector<Edge> &&stars)
+{
+    clearStarCenters();
+    m_Stars = std::move(stars);
+    starCenters.reserve(m_Stars.size());
+    for (auto &star : m_Stars)
+        starCenters.append(&star);
+}
+
+void FITSData::clearStarCenters()
+{
+    if (m_Stars.isEmpty())
+        qDeleteAll(starCenters);
+    starCenters.clear();
+    m_Stars.clear();
+    m_StarRegions.clear();
+}
+
 QList<Edge *> FITSData::getStarCentersInSubFrame(QRect subFrame) const
 {
     QList<Edge *> starCentersInSubFrame;
@@ -287,10 +287,6 @@ class FITSData : public QObject
         {
             return starsSearched;
         }
-        void appendStar(Edge *newCenter)
-        {
-            starCenters.append(newCenter);
-        }
         const QList<Edge *> &getStarCenters() const
         {
             return starCenters;
@@ -299,9 +295,26 @@ class FITSData : public QObject
 
         void setStarCenters(const QList<Edge*> &centers)
         {
-            qDeleteAll(starCenters);
+            clearStarCenters();
             starCenters = centers;
         }
+        /**
+         * @brief Set the detected stars without allocating each of them.
+         * getStarCenters() then points into @p stars.
+         */
+        void setStars(QVector<Edge> &&stars);
+        /**
+         * @brief Star statistics of the regions the image was divided in to detect stars.
+         * Empty unless stars were detected one region at a time, see FITSSEPDetector.
+         */
+        const QVector<StarRegion> &getStarRegions() const
+        {
+            return m_StarRegions;
+        }
+        void setStarRegions(const QVector<StarRegion> &regions)
+        {
+            m_StarRegions = regions;
+        }
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
 
         void setSkyBackground(const SkyBackground &bg)
@@ -586,6 +599,8 @@ class FITSData : public QObject
 
     private:
         void loadCommon(const QString &inFilename);
+        // Deletes starCenters unless they point into m_Stars.
+        void clearStarCenters();
         /**
          * @brief privateLoad Load an image (FITS, RAW, or images supported by Qt like jpeg, png).
          * @param Buffer pointer to image data. If buffer is emtpy, read from disk (m_Filename).
@@ -711,6 +726,9 @@ class FITSData : public QObject
         WCSState m_WCSState { Idle };
         /// All the stars we detected, if any.
         QList<Edge *> starCenters;
+        /// Storage of starCenters when set with setStars(), otherwise starCenters owns its stars.
+        QVector<Edge> m_Stars;
+        QVector<StarRegion> m_StarRegions;
         QList<Edge *> localStarCenters;
         /// The biggest fattest star in the image.
         Edge m_SelectedHFRStar;
@@ -16,9 +16,11 @@
 #include "Options.h"
 #include "kspaths.h"
 
+#include <limits>
 #include <memory>
 #include <math.h>
 #include <QPointer>
+#include <QThreadPool>
 #include <QtConcurrent>
 
 #ifdef HAVE_STELLARSOLVER
@@ -58,102 +60,226 @@ QFuture<bool> FITSSEPDetector::findSources(QRect const &boundary)
     return QtConcurrent::run(this, &FITSSEPDetector::findSourcesAndBackground, boundary);
 }
 
+#ifdef HAVE_STELLARSOLVER
+namespace
+{
+// Smallest tile of a tiled extraction, smaller images are extracted in one pass.
+constexpr int MIN_TILE_AREA = 2048 * 2048;
+// Tiles are extracted with this margin, so that the stars on their edges are complete.
+// A star is only kept by the tile containing its center.
+constexpr int TILE_MARGIN = 128;
+
+struct Tile
+{
+    QRect core;
+    QRect extracted;
+    QList<FITSImage::Star> stars;
+    FITSImage::Background background;
+};
+
+QVector<Tile> makeTiles(const QRect &frame)
+{
+    QVector<Tile> tiles;
+    const qint64 area = static_cast<qint64>(frame.width()) * frame.height();
+    const int count = static_cast<int>(qMin<qint64>(QThreadPool::globalInstance()->maxThreadCount(),
+                                       area / MIN_TILE_AREA));
+    if (count < 2)
+        return tiles;
+
+    // Tiles as square as possible
+    const int columns = qBound(1, qRound(sqrt(count * frame.width() / static_cast<double>(frame.height()))), count);
+    const int rows = qMax(1, count / columns);
+    for (int row = 0; row < rows; row++)
+    {
+        const int top = frame.top() + frame.height() * row / rows;
+        const int bottom = frame.top() + frame.height() * (row + 1) / rows;
+        for (int column = 0; column < columns; column++)
+        {
+            const int left = frame.left() + frame.width() * column / columns;
+            const int right = frame.left() + frame.width() * (column + 1) / columns;
+            Tile tile;
+            tile.core = QRect(left, top, right - left, bottom - top);
+            tile.extracted = tile.core.adjusted(-TILE_MARGIN, -TILE_MARGIN, TILE_MARGIN, TILE_MARGIN) & frame;
+            tiles.append(tile);
+        }
+    }
+    return tiles;
+}
+
+bool containsCenter(const QRect &rect, const FITSImage::Star &star)
+{
+    return star.x >= rect.left() && star.x < rect.left() + rect.width() &&
+           star.y >= rect.top() && star.y < rect.top() + rect.height();
+}
+
+// Extracts the stars of each tile on the global thread pool, and merges them.
+QList<FITSImage::Star> extractTiles(const FITSData *data, QVector<Tile> &tiles, const SSolver::Parameters &params,
+                                    bool runHFR, SkyBackground *background)
+{
+    // The brightness filters of the profile depend on all the stars of the frame, they are
+    // applied below once the tiles are merged. Stars kept by the initial selection of the whole
+    // frame are also kept by the initial selection of their tile.
+    SSolver::Parameters tileParams = params;
+    tileParams.removeBrightest = 0;
+    tileParams.removeDimmest = 0;
+    tileParams.keepNum = std::numeric_limits<int>::max();
+
+    const FITSImage::Statistic stats = data->getStatistics();
+    const uint8_t *buffer = data->getImageBuffer();
+    QtConcurrent::blockingMap(tiles, [&](Tile & tile)
+    {
+        QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(stats, buffer));
+        solver->setParameters(tileParams);
+        solver->setLogLevel(SSolver::LOG_NONE);
+        solver->setSSLogLevel(SSolver::LOG_OFF);
+        solver->extract(runHFR, tile.extracted);
+
+        for (const auto &star : solver->getStarList())
+        {
+            if (containsCenter(tile.core, star))
+                tile.stars.append(star);
+        }
+        tile.background = solver->getBackground();
+    });
+
+    QList<FITSImage::Star> stars;
+    double area = 0, mean = 0, variance = 0;
+    int detected = 0;
+    for (const auto &tile : tiles)
+    {
+        stars.append(tile.stars);
+        const double tileArea = static_cast<double>(tile.core.width()) * tile.core.height();
+        area += tileArea;
+        mean += tileArea * tile.background.global;
+        variance += tileArea * tile.background.globalrms * tile.background.globalrms;
+        detected += tile.background.num_stars_detected;
+    }
+    if (area > 0)
+    {
+        background->mean = mean / area;
+        background->sigma = sqrt(variance / area);
+    }
+    background->numPixelsInSkyEstimate = tiles.first().background.bw * tiles.first().background.bh;
+    background->setStarsDetected(detected);
+
+    std::sort(stars.begin(), stars.end(), [](const FITSImage::Star & star1, const FITSImage::Star & star2)
+    {
+        return star1.flux > star2.flux;
+    });
+    if (params.initialKeep > 0 && stars.size() > params.initialKeep)
+        stars.erase(stars.begin() + params.initialKeep, stars.end());
+    const int brightest = static_cast<int>(stars.size() * params.removeBrightest / 100.0);
+    const int dimmest = static_cast<int>(stars.size() * params.removeDimmest / 100.0);
+    stars = stars.mid(brightest, qMax(0, stars.size() - brightest - dimmest));
+    if (params.keepNum > 0 && stars.size() > params.keepNum)
+        stars.erase(stars.begin() + params.keepNum, stars.end());
+    return stars;
+}
+
+// Median HFR and mean ellipticity of the stars of each tile.
+QVector<StarRegion> regionStatistics(const QVector<Tile> &tiles, const QList<FITSImage::Star> &stars, bool runHFR)
+{
+    QVector<StarRegion> regions;
+    regions.reserve(tiles.size());
+    for (const auto &tile : tiles)
+    {
+        StarRegion region;
+        region.rect = tile.core;
+        QVector<double> hfrs;
+        double ellipticity = 0;
+        for (const auto &star : stars)
+        {
+            if (!containsCenter(tile.core, star))
+                continue;
+            region.stars++;
+            if (runHFR)
+                hfrs.append(star.HFR);
+            if (star.a > 0)
+                ellipticity += 1 - star.b / star.a;
+        }
+        if (!hfrs.isEmpty())
+        {
+            std::nth_element(hfrs.begin(), hfrs.begin() + hfrs.size() / 2, hfrs.end());
+            region.HFR = hfrs[hfrs.size() / 2];
+        }
+        if (region.stars > 0)
+            region.ellipticity = ellipticity / region.stars;
+        regions.append(region);
+    }
+    return regions;
+}
+}
+#endif
+
 bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 {
 #ifndef HAVE_STELLARSOLVER
     Q_UNUSED(boundary)
     return false;
 #else
-    QList<Edge*> starCenters;
     SkyBackground skyBG;
     int maxStarsCount = getValue("maxStarsCount", 100000).toInt();
 
     int optionsProfileIndex = getValue("optionsProfileIndex", -1).toInt();
     Ekos::ProfileGroup group = static_cast<Ekos::ProfileGroup>(getValue("optionsProfileGroup", 1).toInt());
-    QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(m_ImageData->getStatistics(),
-            m_ImageData->getImageBuffer()));
-    QString filename = "";
     QPointer<FITSData> image(m_ImageData);
-    switch(group)
-    {
-        case Ekos::AlignProfiles:
-            //So it should not be here if it is Align.
-            break;
-        case Ekos::GuideProfiles:
-            filename = "SavedGuideProfiles.ini";
-            break;
-        case Ekos::FocusProfiles:
-            filename = "SavedFocusProfiles.ini";
-            break;
-        case Ekos::HFRProfiles:
-            filename = "SavedHFRProfiles.ini";
-            break;
-    }
 
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(filename);
-    QList<SSolver::Parameters> optionsList;
-    if(QFile(savedOptionsProfiles).exists())
-        optionsList = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-    {
-        switch(group)
-        {
-            case Ekos::AlignProfiles:
-                optionsList = Ekos::getDefaultAlignOptionsProfiles();
-                break;
-            case Ekos::GuideProfiles:
-                optionsList = Ekos::getDefaultGuideOptionsProfiles();
-                break;
-            case Ekos::FocusProfiles:
-                optionsList = Ekos::getDefaultFocusOptionsProfiles();
-                break;
-            case Ekos::HFRProfiles:
-                optionsList = Ekos::getDefaultHFROptionsProfiles();
-                break;
-        }
-    }
+    // Profiles are cached, this does not read the saved profiles file for each frame
+    const QList<SSolver::Parameters> optionsList = Ekos::getOptionsProfiles(group);
+    auto params = SSolver::Parameters();  // This is default
     if (optionsProfileIndex >= 0 && optionsList.count() > optionsProfileIndex)
     {
-        auto params = optionsList[optionsProfileIndex];
-        params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
+        params = optionsList[optionsProfileIndex];
         qCDebug(KSTARS_FITS) << "Sextract with: " << optionsList[optionsProfileIndex].listName;
     }
-    else
-    {
-        auto params = SSolver::Parameters();  // This is default
-        params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
-    }
+    params.partition = Options::stellarSolverPartition();
 
     QList<FITSImage::Star> stars;
     const bool runHFR = group != Ekos::AlignProfiles;
 
-    solver->setLogLevel(SSolver::LOG_NONE);
-    solver->setSSLogLevel(SSolver::LOG_OFF);
+    // StellarSolver partitions the image itself when asked to
+    const QRect frame = boundary.isValid() ? boundary : QRect(0, 0, m_ImageData->width(), m_ImageData->height());
+    QVector<Tile> tiles;
+    if (Options::stellarSolverTiles() && !params.partition)
+        tiles = makeTiles(frame);
 
-    if (boundary.isValid())
-        solver->extract(runHFR, boundary);
-    else
-        solver->extract(runHFR);
+    if (tiles.isEmpty())
+    {
+        QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(m_ImageData->getStatistics(),
+                m_ImageData->getImageBuffer()));
+        solver->setParameters(params);
+        solver->setLogLevel(SSolver::LOG_NONE);
+        solver->setSSLogLevel(SSolver::LOG_OFF);
 
-    stars = solver->getStarList();
+        if (boundary.isValid())
+            solver->extract(runHFR, boundary);
+        else
+            solver->extract(runHFR);
 
-    // If m_ImageData goes out of scope, also return.
-    if (stars.empty() || image.isNull())
-        return false;
+        stars = solver->getStarList();
 
-    auto bg = solver->getBackground();
+        // If m_ImageData goes out of scope, also return.
+        if (stars.empty() || image.isNull())
+            return false;
 
-    skyBG.mean = bg.global;
-    skyBG.sigma = bg.globalrms;
-    skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
-    skyBG.setStarsDetected(bg.num_stars_detected);
-    m_ImageData->setSkyBackground(skyBG);
+        auto bg = solver->getBackground();
 
-    //There is more information that can be obtained by the Stellarsolver->
-    //Background info, Star positions(if a plate solve was done before), etc
-    //The information is available as long as the StellarSolver exists.
+        skyBG.mean = bg.global;
+        skyBG.sigma = bg.globalrms;
+        skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
+        skyBG.setStarsDetected(bg.num_stars_detected);
+
+        //There is more information that can be obtained by the Stellarsolver->
+        //Background info, Star positions(if a plate solve was done before), etc
+        //The information is available as long as the StellarSolver exists.
+    }
+    else
+    {
+        stars = extractTiles(m_ImageData, tiles, params, runHFR, &skyBG);
+        if (stars.empty() || image.isNull())
+            return false;
+    }
+    m_ImageData->setSkyBackground(skyBG);
 
     // Let's sort edges, starting with widest
     if (runHFR)
@@ -164,31 +290,33 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 
     // Take only the first maxNumCenters stars
     int starCount = qMin(maxStarsCount, stars.count());
-    starCenters.reserve(starCount);
+    QVector<Edge> starCenters(starCount);
     for (int i = 0; i < starCount; i++)
     {
-        Edge *oneEdge = new Edge();
-        oneEdge->x = stars[i].x;
-        oneEdge->y = stars[i].y;
-        oneEdge->val = stars[i].peak;
-        oneEdge->sum = stars[i].flux;
-        oneEdge->HFR = stars[i].HFR;
-        oneEdge->width = stars[i].a;
-        oneEdge->numPixels = stars[i].numPixels;
+        Edge &oneEdge = starCenters[i];
+        oneEdge.x = stars[i].x;
+        oneEdge.y = stars[i].y;
+        oneEdge.val = stars[i].peak;
+        oneEdge.sum = stars[i].flux;
+        oneEdge.HFR = stars[i].HFR;
+        oneEdge.width = stars[i].a;
+        oneEdge.numPixels = stars[i].numPixels;
         if (stars[i].a > 0)
             // See page 63 to find the ellipticity equation for SEP.
             // http://astroa.physics.metu.edu.tr/MANUALS/sextractor/Guide2source_extractor.pdf
-            oneEdge->ellipticity = 1 - stars[i].b / stars[i].a;
+            oneEdge.ellipticity = 1 - stars[i].b / stars[i].a;
         else
-            oneEdge->ellipticity = 0;
-
-        starCenters.append(oneEdge);
+            oneEdge.ellipticity = 0;
     }
-    m_ImageData->setStarCenters(starCenters);
+    m_ImageData->setStars(std::move(starCenters));
+
+    if (!tiles.isEmpty())
+        m_ImageData->setStarRegions(regionStatistics(tiles, stars, runHFR));
     return true;
 #endif
 }
 
+
 template <typename T>
 void FITSSEPDetector::getFloatBuffer(float * buffer, int x, int y, int w, int h, FITSData const *data) const
 {
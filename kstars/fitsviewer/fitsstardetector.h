@@ -14,6 +14,7 @@
 #include <QHash>
 #include <QStandardItem>
 #include <QFuture>
+#include <QRect>
 
 class FITSData;
 
@@ -36,6 +37,17 @@ class Edge
         float ellipticity {0};
 };
 
+/// Statistics of the stars detected in one region of an image.
+struct StarRegion
+{
+    QRect rect;
+    /// Median HFR of the stars of the region, or -1 if not computed.
+    double HFR {-1};
+    /// Mean ellipticity of the stars of the region.
+    double ellipticity {0};
+    int stars {0};
+};
+
 class BahtinovEdge : public Edge
 {
     public:
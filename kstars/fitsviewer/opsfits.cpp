@@ -71,12 +71,7 @@ OpsFITS::OpsFITS() : QFrame(KStars::Instance())
 
 void OpsFITS::loadStellarSolverProfiles()
 {
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                            QStandardPaths::AppLocalDataLocation)).filePath("SavedHFRProfiles.ini");
-    if(QFile(savedOptionsProfiles).exists())
-        m_StellarSolverProfiles = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        m_StellarSolverProfiles = Ekos::getDefaultHFROptionsProfiles();
+    m_StellarSolverProfiles = Ekos::getOptionsProfiles(Ekos::HFRProfiles);
     HfrOptionsProfiles->clear();
     for(auto param : m_StellarSolverProfiles)
         HfrOptionsProfiles->addItem(param.listName);
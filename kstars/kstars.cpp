@@ -9,11 +9,14 @@
 #include "config-kstars.h"
 #include "version.h"
 
+#include "chartrenderer.h"
+#include "timelapserenderer.h"
 #include "fov.h"
 #include "kactionmenu.h"
 #include "kstarsadaptor.h"
 #include "kstarsdata.h"
 #include "kstarssplash.h"
+#include "ksprofiler.h"
 #include "observinglist.h"
 #include "Options.h"
 #include "skymap.h"
@@ -148,6 +151,9 @@ KStars::KStars(bool doSplash, bool clockrun, const QString &startdate)
 
     QDBusConnection::sessionBus().registerObject("/KStars", this);
     QDBusConnection::sessionBus().registerService("org.kde.kstars");
+    KSProfiler::Instance();
+    ChartRenderer::Instance();
+    TimeLapseRenderer::Instance();
 
 #ifdef HAVE_CFITSIO
     m_GenericFITSViewer.clear();
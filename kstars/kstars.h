@@ -451,6 +451,24 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getObjectPositionInfo(const QString &objectName);
 
+        /** DBUS interface function.  Return XML listing the passes of the selected satellites
+             * @param startJD Julian day (UTC) of the start of the search
+             * @param stopJD Julian day (UTC) of the end of the search
+             * @param minAltitude only report passes rising above this altitude, in degrees
+             * @note Satellites are those selected in the satellites configuration, at the current location.
+             */
+        Q_SCRIPTABLE QString getSatellitePasses(double startJD, double stopJD, double minAltitude = 0);
+
+        /** DBUS interface function.  Return XML listing the crossings of a field by the selected satellites
+             * @param RA_J2000 J2000.0 RA of the field center, in degrees
+             * @param Dec_J2000 J2000.0 Declination of the field center, in degrees
+             * @param radius radius of the field, in degrees
+             * @param startJD Julian day (UTC) of the start of the search
+             * @param stopJD Julian day (UTC) of the end of the search
+             */
+        Q_SCRIPTABLE QString getSatelliteCrossings(double RA_J2000, double Dec_J2000, double radius,
+                double startJD, double stopJD);
+
         /** DBUS interface function. Render eyepiece view and save it in the file(s) specified
              * @note See EyepieceField::renderEyepieceView() for more info. This is a DBus proxy that calls that method, and then writes the resulting image(s) to file(s).
              * @note Important: If imagePath is empty, but overlay is true, or destPathImage is supplied, this method will make a blocking DSS download.
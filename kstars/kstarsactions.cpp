@@ -2131,5 +2131,6 @@ void KStars::slotDSOCatalogGUI()
     connect(ui, &QDialog::finished, this, [&](const auto)
     {
         KStars::Instance()->data()->skyComposite()->catalogsComponent()->dropCache();
+        KStars::Instance()->data()->skyComposite()->contentChanged();
     });
 }
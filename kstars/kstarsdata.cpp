@@ -12,6 +12,8 @@
 #include "skycomponents/supernovaecomponent.h"
 #include "skycomponents/skymapcomposite.h"
 #include "ksnotification.h"
+#include "ksprofiler.h"
+#include "updatescheduler.h"
 #include "skyobjectuserdata.h"
 #include <kio/job_base.h>
 #include <kio/filecopyjob.h>
@@ -130,72 +132,37 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
-    //Load Time Zone Rules//
-    emit progressText(i18n("Reading time zone rules"));
-    if (!readTimeZoneRulebook())
-    {
-        fatalErrorMessage("TZrules.dat");
-        return false;
-    }
-
-    emit progressText(
-        i18n("Upgrade existing user city db to support geographic elevation."));
-
-    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
-
-    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
-    /// geographic elevation.
-    if (QFile::exists(dbfile))
-    {
-        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
-
-        fixcitydb.setDatabaseName(dbfile);
-        fixcitydb.open();
-
-        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
-        {
-            QSqlRecord r = fixcitydb.record("city");
-            if (!r.contains("Elevation"))
-            {
-                emit progressText(i18n("Adding \"Elevation\" column to city table."));
-
-                QSqlQuery query(fixcitydb);
-                if (query.exec(
-                        "alter table city add column Elevation real default -10;") ==
-                    false)
-                {
-                    emit progressText(QString("failed to add Elevation column to city "
-                                              "table in mycitydb.sqlite: &1")
-                                          .arg(query.lastError().text()));
-                }
-            }
-            else
-            {
-                emit progressText(i18n("City table already contains \"Elevation\"."));
-            }
-        }
-        else
-        {
-            emit progressText(i18n("City table missing from database."));
-        }
-        fixcitydb.close();
-    }
-
-    //Load Cities//
-    emit progressText(i18n("Loading city data"));
-    if (!readCityData())
-    {
-        fatalErrorMessage("citydb.sqlite");
-        return false;
-    }
+    // Startup runs as two independent chains which only meet once the location is set:
+    //  - time zone rules -> cities, on the thread pool
+    //  - user database -> sky objects -> URL data, on this thread
+    QFuture<QString> locations = QtConcurrent::run(this, &KStarsData::readLocationData);
+    KSProfiler::Stages stages("startup");
 
     //Initialize User Database//
+    stages.enter("userdb");
     emit progressText(i18n("Loading User Information"));
     m_ksuserdb.Initialize();
 
     //Initialize SkyMapComposite//
+    stages.enter("skycomposite");
     emit progressText(i18n("Loading sky objects"));
     m_SkyComposite.reset(new SkyMapComposite());
+
+    stages.enter("locations-wait");
+    const QString failedFile = locations.result();
+    if (!failedFile.isEmpty())
+    {
+        fatalErrorMessage(failedFile);
+        return false;
+    }
+
+    // The location dialogs use this connection on the main thread. It must be added here,
+    // a connection can only be used by the thread that created it.
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
+    const QString mycitydbFile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+    if (QFile::exists(mycitydbFile))
+        mycitydb.setDatabaseName(mycitydbFile);
+
     //Load Image URLs//
     //#ifndef Q_OS_ANDROID
     //On Android these 2 calls produce segfault. WARNING
@@ -218,6 +185,7 @@ bool KStarsData::initialize()
     //#endif
     //emit progressText( i18n("Loading Variable Stars" ) );
 
+    stages.enter("userlists");
 #ifndef KSTARS_LITE
     //Initialize Observing List
     m_ObservingList = new ObservingList();
@@ -259,7 +227,10 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 
     KSNumbers num(ut().djd());
 
-    if (std::abs(ut().djd() - LastNumUpdate.djd()) > 1.0)
+    // Each class of objects is recomputed once it may have moved by a fraction of a pixel
+    const double zoom = Options::zoomFactor();
+
+    if (std::abs(ut().djd() - LastNumUpdate.djd()) > UpdateScheduler::interval(UpdateScheduler::FixedObjects, zoom))
     {
         LastNumUpdate = KStarsDateTime(ut().djd());
         m_preUpdateNumID++;
@@ -267,14 +238,13 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         skyComposite()->update(&num);
     }
 
-    if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > 0.01)
+    if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > UpdateScheduler::interval(UpdateScheduler::SolarSystemBodies, zoom))
     {
         LastPlanetUpdate = KStarsDateTime(ut().djd());
         skyComposite()->updateSolarSystemBodies(&num);
     }
 
-    // Moon moves ~30 arcmin/hr, so update its position every minute.
-    if (std::abs(ut().djd() - LastMoonUpdate.djd()) > 0.00069444)
+    if (std::abs(ut().djd() - LastMoonUpdate.djd()) > UpdateScheduler::interval(UpdateScheduler::Moons, zoom))
     {
         LastMoonUpdate = ut();
         skyComposite()->updateMoons(&num);
@@ -282,12 +252,13 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 
     //Update Alt/Az coordinates.  Timescale varies with zoom level
     //If Clock is in Manual Mode, always update. (?)
-    if (std::abs(ut().djd() - LastSkyUpdate.djd()) > 0.1 / Options::zoomFactor() || clock()->isManualMode())
+    if (std::abs(ut().djd() - LastSkyUpdate.djd()) > UpdateScheduler::interval(UpdateScheduler::HorizontalCoordinates, zoom) ||
+            clock()->isManualMode())
     {
         LastSkyUpdate = ut();
         m_preUpdateID++;
-        //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
-        skyComposite()->update(&num);
+        // Catalog coordinates only change with the numbers above, only update Alt/Az coords here
+        skyComposite()->update(nullptr);
 
         emit skyUpdate(clock()->isManualMode());
     }
@@ -433,80 +404,134 @@ SkyObject *KStarsData::objectNamed(const QString &name)
     return skyComposite()->findByName(name, true); // objectNamed has to do an exact match
 }
 
-bool KStarsData::readCityData()
+QString KStarsData::readLocationData()
 {
-    QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
-    QString dbfile      = KSPaths::locate(QStandardPaths::AppLocalDataLocation, "citydb.sqlite");
-    citydb.setDatabaseName(dbfile);
-    if (citydb.open() == false)
-    {
-        qCCritical(KSTARS) << "Unable to open city database file " << dbfile << citydb.lastError().text();
-        return false;
-    }
+    KSProfiler::Scope scope("startup/locations");
+
+    //Load Time Zone Rules//
+    emit progressText(i18n("Reading time zone rules"));
+    if (!readTimeZoneRulebook())
+        return QString("TZrules.dat");
 
-    QSqlQuery get_query(citydb);
+    emit progressText(
+        i18n("Upgrade existing user city db to support geographic elevation."));
 
-    //get_query.prepare("SELECT * FROM city");
-    if (!get_query.exec("SELECT * FROM city"))
-    {
-        qCCritical(KSTARS) << get_query.lastError();
-        return false;
-    }
+    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
 
-    bool citiesFound = false;
-    // get_query.size() always returns -1 so we set citiesFound if at least one city is found
-    while (get_query.next())
+    // This runs on the thread pool, so the connections opened here are private to it and
+    // removed before returning. The named "mycitydb" connection of the dialogs is added by
+    // initialize() on the main thread.
+
+    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
+    /// geographic elevation.
+    if (QFile::exists(dbfile))
     {
-        citiesFound          = true;
-        QString name         = get_query.value(1).toString();
-        QString province     = get_query.value(2).toString();
-        QString country      = get_query.value(3).toString();
-        dms lat              = dms(get_query.value(4).toString());
-        dms lng              = dms(get_query.value(5).toString());
-        double TZ            = get_query.value(6).toDouble();
-        TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-        double elevation     = get_query.value(8).toDouble();
-
-        // appends city names to list
-        geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, true, 4));
+        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb-startup");
+
+        fixcitydb.setDatabaseName(dbfile);
+        fixcitydb.open();
+
+        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
+        {
+            QSqlRecord r = fixcitydb.record("city");
+            if (!r.contains("Elevation"))
+            {
+                emit progressText(i18n("Adding \"Elevation\" column to city table."));
+
+                QSqlQuery query(fixcitydb);
+                if (query.exec(
+                        "alter table city add column Elevation real default -10;") ==
+                    false)
+                {
+                    emit progressText(QString("failed to add Elevation column to city "
+                                              "table in mycitydb.sqlite: &1")
+                                          .arg(query.lastError().text()));
+                }
+            }
+            else
+            {
+                emit progressText(i18n("City table already contains \"Elevation\"."));
+            }
+        }
+        else
+        {
+            emit progressText(i18n("City table missing from database."));
+        }
+        fixcitydb.close();
+        fixcitydb = QSqlDatabase();
+        QSqlDatabase::removeDatabase("fixcitydb-startup");
     }
-    citydb.close();
+
+    //Load Cities//
+    emit progressText(i18n("Loading city data"));
+    if (!readCityData())
+        return QString("citydb.sqlite");
+
+    return QString();
+}
+
+bool KStarsData::readCityData()
+{
+    // At least one city is expected in the bundled database
+    if (readCityTable(KSPaths::locate(QStandardPaths::AppLocalDataLocation, "citydb.sqlite"), true) <= 0)
+        return false;
 
     // Reading local database
-    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
-    dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+    const QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+    if (QFile::exists(dbfile) && readCityTable(dbfile, false) < 0)
+        return false;
 
-    if (QFile::exists(dbfile))
+    return true;
+}
+
+int KStarsData::readCityTable(const QString &dbfile, bool readOnly)
+{
+    // Runs on the thread pool, the connection is private to this call.
+    const QString connection("citydb-startup");
+    int count = -1;
     {
-        mycitydb.setDatabaseName(dbfile);
-        if (mycitydb.open())
+        QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", connection);
+        citydb.setDatabaseName(dbfile);
+        if (citydb.open() == false)
         {
-            QSqlQuery get_query(mycitydb);
-
+            qCCritical(KSTARS) << "Unable to open city database file " << dbfile << citydb.lastError().text();
+            // A custom city database that can not be opened is ignored
+            if (!readOnly)
+                count = 0;
+        }
+        else
+        {
+            QSqlQuery get_query(citydb);
             if (!get_query.exec("SELECT * FROM city"))
             {
-                qDebug() << Q_FUNC_INFO << get_query.lastError();
-                return false;
+                qCCritical(KSTARS) << get_query.lastError();
             }
-            while (get_query.next())
+            else
             {
-                QString name         = get_query.value(1).toString();
-                QString province     = get_query.value(2).toString();
-                QString country      = get_query.value(3).toString();
-                dms lat              = dms(get_query.value(4).toString());
-                dms lng              = dms(get_query.value(5).toString());
-                double TZ            = get_query.value(6).toDouble();
-                TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-                double elevation     = get_query.value(8).toDouble();
-
-                // appends city names to list
-                geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, false, 4));
+                // get_query.size() always returns -1 so the cities are counted
+                count = 0;
+                while (get_query.next())
+                {
+                    QString name         = get_query.value(1).toString();
+                    QString province     = get_query.value(2).toString();
+                    QString country      = get_query.value(3).toString();
+                    dms lat              = dms(get_query.value(4).toString());
+                    dms lng              = dms(get_query.value(5).toString());
+                    double TZ            = get_query.value(6).toDouble();
+                    TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
+                    double elevation     = get_query.value(8).toDouble();
+
+                    // appends city names to list
+                    geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, readOnly, 4));
+                    count++;
+                }
             }
-            mycitydb.close();
+            get_query.finish();
+            citydb.close();
         }
     }
-
-    return citiesFound;
+    QSqlDatabase::removeDatabase(connection);
+    return count;
 }
 
 bool KStarsData::readTimeZoneRulebook()
@@ -475,9 +475,25 @@ class KStarsData : public QObject
          */
         bool readCityData();
 
+        /**
+         * Append the cities of the city table of a database to the list of geographic locations.
+         * @param dbfile path of the database
+         * @param readOnly true for the bundled database, false for the custom cities
+         * @return the number of cities read, or -1 if the table could not be read.
+         */
+        int readCityTable(const QString &dbfile, bool readOnly);
+
         /** Read the data file that contains daylight savings time rules. */
         bool readTimeZoneRulebook();
 
+        /**
+         * @short Read the time zone rules, then the city databases.
+         * The city databases reference the rules, the rest of the startup does not use either,
+         * so this runs on the thread pool while the sky is loaded.
+         * @return the name of the data file that failed to load, or an empty string on success.
+         */
+        QString readLocationData();
+
         //TODO JM: ADV tree should use XML instead
         /**
          * Read Advanced interface structure to be used later to construct the list view in
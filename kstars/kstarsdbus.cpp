@@ -25,6 +25,7 @@
 #include "tools/whatsinteresting/wiview.h"
 #include "dialogs/finddialog.h"
 #include "tools/nameresolver.h"
+#include "tools/satellitepasspredictor.h"
 
 #ifdef HAVE_CFITSIO
 #include "fitsviewer/fitsviewer.h"
@@ -38,6 +39,8 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 #include "kstars_debug.h"
 
@@ -915,6 +918,90 @@ QString KStars::getObjectPositionInfo(const QString &objectName)
     return output;
 }
 
+namespace
+{
+// Runs a satellite prediction on the global thread pool. The event loop keeps the GUI
+// responsive while the D-Bus caller waits for the result.
+template <typename Result, typename Function>
+Result predictInBackground(const Function &predict)
+{
+    QFutureWatcher<Result> watcher;
+    QEventLoop loop;
+    QObject::connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::run(predict));
+    if (!watcher.isFinished())
+        loop.exec();
+    return watcher.result();
+}
+}
+
+QString KStars::getSatellitePasses(double startJD, double stopJD, double minAltitude)
+{
+    // The satellites and the location are copied here, the worker only touches the copies
+    GeoLocation geo(*data()->geo());
+    SatellitePassPredictor predictor(&geo);
+    predictor.setSatellites(SatellitePassPredictor::selectedSatellites());
+    const auto passes = predictInBackground<QVector<SatellitePassPredictor::Pass>>([&]()
+    {
+        return predictor.findPasses(startJD, stopJD, minAltitude);
+    });
+
+    QString output;
+    QXmlStreamWriter stream(&output);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+    stream.writeStartElement("passes");
+    for (const auto &pass : passes)
+    {
+        stream.writeStartElement("pass");
+        stream.writeTextElement("Name", pass.name);
+        stream.writeTextElement("Rise_JD", QString::number(pass.riseJD, 'f', 6));
+        stream.writeTextElement("Culmination_JD", QString::number(pass.culminationJD, 'f', 6));
+        stream.writeTextElement("Set_JD", QString::number(pass.setJD, 'f', 6));
+        stream.writeTextElement("Max_Altitude_Degrees", QString::number(pass.maxAltitude));
+        stream.writeTextElement("Visible", pass.visible ? "true" : "false");
+        stream.writeEndElement(); // pass
+    }
+    stream.writeEndElement(); // passes
+    stream.writeEndDocument();
+    return output;
+}
+
+QString KStars::getSatelliteCrossings(double RA_J2000, double Dec_J2000, double radius, double startJD, double stopJD)
+{
+    SkyPoint target;
+    target.setRA0(dms(RA_J2000));
+    target.setDec0(dms(Dec_J2000));
+
+    GeoLocation geo(*data()->geo());
+    SatellitePassPredictor predictor(&geo);
+    predictor.setSatellites(SatellitePassPredictor::selectedSatellites());
+    const auto crossings = predictInBackground<QVector<SatellitePassPredictor::Crossing>>([&]()
+    {
+        return predictor.findCrossings(target, radius, startJD, stopJD);
+    });
+
+    QString output;
+    QXmlStreamWriter stream(&output);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+    stream.writeStartElement("crossings");
+    for (const auto &crossing : crossings)
+    {
+        stream.writeStartElement("crossing");
+        stream.writeTextElement("Name", crossing.name);
+        stream.writeTextElement("Ingress_JD", QString::number(crossing.ingressJD, 'f', 6));
+        stream.writeTextElement("Closest_JD", QString::number(crossing.closestJD, 'f', 6));
+        stream.writeTextElement("Egress_JD", QString::number(crossing.egressJD, 'f', 6));
+        stream.writeTextElement("Separation_Degrees", QString::number(crossing.separation));
+        stream.writeTextElement("Visible", crossing.visible ? "true" : "false");
+        stream.writeEndElement(); // crossing
+    }
+    stream.writeEndElement(); // crossings
+    stream.writeEndDocument();
+    return output;
+}
+
 void KStars::renderEyepieceView(const QString &objectName, const QString &destPathChart, const double fovWidth,
                                 const double fovHeight, const double rotation, const double scale, const bool flip,
                                 const bool invert, QString imagePath, const QString &destPathImage, const bool overlay,
@@ -19,6 +19,7 @@
 #include "simclock.h"
 #include "version.h"
 #if !defined(KSTARS_LITE)
+#include "chartrenderer.h"
 #include "kstars.h"
 #include "skymap.h"
 #endif
@@ -193,6 +194,7 @@ int main(int argc, char *argv[])
 
     //parser.addHelpOption(INSERT_DESCRIPTION_HERE);
     parser.addOption(QCommandLineOption("dump", i18n("Dump sky image to file."), "file"));
+    parser.addOption(QCommandLineOption("charts", i18n("Render the finder charts listed in a file."), "file"));
     parser.addOption(QCommandLineOption("script", i18n("Script to execute."), "file"));
     parser.addOption(QCommandLineOption("width", i18n("Width of sky image."), "value"));
     parser.addOption(QCommandLineOption("height", i18n("Height of sky image."), "value"));
@@ -206,7 +208,7 @@ int main(int argc, char *argv[])
     parser.process(app);
     aboutData.processCommandLine(&parser);
 
-    if (parser.isSet("dump"))
+    if (parser.isSet("dump") || parser.isSet("charts"))
     {
         qCDebug(KSTARS) << "Dumping sky image";
 
@@ -234,7 +236,7 @@ int main(int argc, char *argv[])
         {
             format = "BMP";
         }
-        else
+        else if (!fname.isEmpty())
         {
             qCWarning(KSTARS) << i18n("Could not parse image format of %1; assuming PNG.",
                                       fname);
@@ -335,6 +337,14 @@ int main(int argc, char *argv[])
 
         qApp->processEvents();
         map->setupProjector();
+
+        if (parser.isSet("charts"))
+        {
+            const int charts = ChartRenderer::Instance()->renderCharts(parser.value("charts"), w, h);
+            delete map;
+            return charts < 0 ? 1 : 0;
+        }
+
         map->exportSkyImage(&sky);
         qApp->processEvents();
 
@@ -53,6 +53,10 @@ OpsImageOverlay::OpsImageOverlay() : QFrame(KStars::Instance())
     {
         Options::setImageOverlayTimeout(value);
     });
+    connect(kcfg_ImageOverlaySolvers, QOverload<int>::of(&QSpinBox::valueChanged), [](int value)
+    {
+        Options::setImageOverlaySolvers(value);
+    });
     connect(kcfg_ImageOverlayDefaultScale, QOverload<double>::of(&QDoubleSpinBox::valueChanged), [](double value)
     {
         Options::setImageOverlayDefaultScale(value);
@@ -95,6 +99,7 @@ void OpsImageOverlay::syncOptions()
     kcfg_ShowImageOverlays->setChecked(Options::showImageOverlays());
     kcfg_ImageOverlayMaxDimension->setValue(Options::imageOverlayMaxDimension());
     kcfg_ImageOverlayTimeout->setValue(Options::imageOverlayTimeout());
+    kcfg_ImageOverlaySolvers->setValue(Options::imageOverlaySolvers());
     kcfg_ImageOverlayDefaultScale->setValue(Options::imageOverlayDefaultScale());
 }
 
@@ -31,6 +31,16 @@ double AzimuthalEquidistantProjector::projectionK(double x) const
     return ((crad != 0) ? crad / sin(crad) : 1); // This handles the 0/0 case. The limit of x / sin(x) is 1 as x -> 0.
 }
 
+void AzimuthalEquidistantProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                                  uchar *visible, bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        const Eigen::ArrayXd crad = c.acos();
+        return (crad != 0).select(crad / crad.sin(), 1.0);
+    });
+}
+
 double AzimuthalEquidistantProjector::projectionL(double x) const
 {
     return x;
@@ -22,6 +22,8 @@ class AzimuthalEquidistantProjector : public Projector
     Projection type() const override;
     double radius() const override;
     double projectionK(double x) const override;
+    void toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                       uchar *visible = nullptr, bool refract = true) const override;
     double projectionL(double x) const override;
 };
 
@@ -60,6 +60,45 @@ Eigen::Vector2f EquirectangularProjector::toScreenVec(const SkyPoint *o, bool oR
     return p;
 }
 
+void EquirectangularProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+        uchar *visible, bool refract) const
+{
+    refract &= m_vp.useRefraction;
+
+    double lon0, lat0;
+    if (m_vp.useAltAz)
+    {
+        lon0 = m_vp.focus->az().reduce().radians();
+        lat0 = SkyPoint::refract(m_vp.focus->alt(), refract).radians();
+    }
+    else
+    {
+        lon0 = m_vp.focus->ra().reduce().radians();
+        lat0 = m_vp.focus->dec().radians();
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        double dX, Y;
+        if (m_vp.useAltAz)
+        {
+            dX = lon0 - lon[i];
+            Y  = SkyPoint::refract(lat[i] / dms::DegToRad, refract) * dms::DegToRad;
+        }
+        else
+        {
+            dX = lon[i] - lon0;
+            Y  = lat[i];
+        }
+
+        const auto p = rst(KSUtils::reduceAngle(dX, -dms::PI, dms::PI), Y - lat0);
+        x[i] = p[0];
+        y[i] = p[1];
+        if (visible)
+            visible[i] = (p[0] > 0 && p[0] < m_vp.width);
+    }
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const dms *lat, bool onlyAltAz) const
 {
     SkyPoint result;
@@ -26,6 +26,15 @@ double GnomonicProjector::projectionK(double x) const
     return 1.0 / x;
 }
 
+void GnomonicProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                      uchar *visible, bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return c.inverse();
+    });
+}
+
 double GnomonicProjector::projectionL(double x) const
 {
     return atan(x);
@@ -26,6 +26,15 @@ double LambertProjector::projectionK(double x) const
     return sqrt(2.0 / (1.0 + x));
 }
 
+void LambertProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                     uchar *visible, bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return (2.0 / (1.0 + c)).sqrt();
+    });
+}
+
 double LambertProjector::projectionL(double x) const
 {
     return 2.0 * asin(0.5 * x);
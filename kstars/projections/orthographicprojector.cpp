@@ -27,6 +27,15 @@ double OrthographicProjector::projectionK(double x) const
     return 1.0;
 }
 
+void OrthographicProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                          uchar *visible, bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return Eigen::ArrayXd::Ones(c.size());
+    });
+}
+
 double OrthographicProjector::projectionL(double x) const
 {
     return asin(x);
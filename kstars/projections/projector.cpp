@@ -580,3 +580,15 @@ Eigen::Vector2f Projector::toScreenVec(const SkyPoint *o, bool oRefract, bool *o
 #endif
     return p;
 }
+
+void Projector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y, uchar *visible,
+                              bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [this](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return c.unaryExpr([this](double v)
+        {
+            return projectionK(v);
+        });
+    });
+}
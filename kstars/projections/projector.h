@@ -133,6 +133,24 @@ class Projector
          */
         QPointF toScreen(const SkyPoint *o, bool oRefract = true, bool *onVisibleHemisphere = nullptr) const;
 
+        /**
+         * @short Project a batch of points given as separate coordinate arrays.
+         *
+         * Gives the same result as calling toScreenVec() on each point, but the view parameters
+         * are read once and the trigonometry and projection specific code run over whole arrays,
+         * which the compiler can vectorize. Each projection implements its own batch version.
+         *
+         * @param lon right ascensions in equatorial mode, azimuths in horizontal mode, in radians
+         * @param lat declinations in equatorial mode, altitudes in horizontal mode, in radians
+         * @param count number of points
+         * @param x screen x coordinates, filled with @p count values
+         * @param y screen y coordinates, filled with @p count values
+         * @param visible if not null, filled with @p count flags, nonzero for points on the visible hemisphere
+         * @param refract true = refract the altitudes if Options::useRefraction() is set
+         */
+        virtual void toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                   uchar *visible = nullptr, bool refract = true) const;
+
         /**
          * @short Determine RA, Dec coordinates of the pixel at (dx, dy), which are the
          * screen pixel coordinate offsets from the center of the Sky pixmap.
@@ -316,6 +334,68 @@ class Projector
             };
         }
 
+        /**
+         * Batch version of the azimuthal projection done by toScreenVec().
+         *
+         * @p radialK is the array form of projectionK(). It takes the cosines of the angular
+         * distances from the focus as an Eigen::ArrayXd and returns an Eigen::ArrayXd.
+         * Points with non finite coordinates are projected to (0, 0) and are not visible.
+         * @see toScreenBatch()
+         */
+        template <typename RadialK>
+        void projectAzimuthal(const double *lon, const double *lat, int count, float *x, float *y,
+                              uchar *visible, bool refract, RadialK radialK) const
+        {
+            if (count <= 0)
+                return;
+
+            const Eigen::Map<const Eigen::ArrayXd> lonA(lon, count);
+            Eigen::ArrayXd Y = Eigen::Map<const Eigen::ArrayXd>(lat, count);
+            Eigen::ArrayXd dX;
+
+            if (m_vp.useAltAz)
+            {
+                if (refract && m_vp.useRefraction)
+                {
+                    for (int i = 0; i < count; i++)
+                        Y[i] = SkyPoint::refract(Y[i] / dms::DegToRad) * dms::DegToRad;
+                }
+                dX = m_vp.focus->az().radians() - lonA;
+            }
+            else
+                dX = lonA - m_vp.focus->ra().radians();
+
+            // No need to reduce dX, only its sine and cosine are used
+            const Eigen::ArrayXd sindX = dX.sin(), cosdX = dX.cos();
+            const Eigen::ArrayXd sinY = Y.sin(), cosY = Y.cos();
+
+            //c is the cosine of the angular distance from the center
+            const Eigen::ArrayXd c = m_sinY0 * sinY + m_cosY0 * cosY * cosdX;
+            const Eigen::ArrayXd k = radialK(c);
+            const Eigen::ArrayXd px = k * cosY * sindX;
+            const Eigen::ArrayXd py = k * (m_cosY0 * sinY - m_sinY0 * cosY * cosdX);
+
+            // Same as rst()
+            const double halfWidth = m_vp.width / 2.0, halfHeight = m_vp.height / 2.0;
+            const double zoom = m_vp.zoomFactor;
+            const double cosR = m_vp.rotationAngle.cos(), sinR = m_vp.rotationAngle.sin();
+            Eigen::Map<Eigen::ArrayXf>(x, count) = (halfWidth - zoom * (px * cosR - py * sinR)).cast<float>();
+            Eigen::Map<Eigen::ArrayXf>(y, count) = (halfHeight - zoom * (px * sinR + py * cosR)).cast<float>();
+
+            if (visible)
+                Eigen::Map<Eigen::Array<uchar, Eigen::Dynamic, 1>>(visible, count) = (c > cosMaxFieldAngle()).cast<uchar>();
+
+            for (int i = 0; i < count; i++)
+            {
+                if (!(std::isfinite(Y[i]) && std::isfinite(dX[i])))
+                {
+                    x[i] = y[i] = 0;
+                    if (visible)
+                        visible[i] = 0;
+                }
+            }
+        }
+
         /**
          * Transform screen (x, y) to projector (x, y) accounting for scale, rotation
          *
@@ -26,6 +26,15 @@ double StereographicProjector::projectionK(double x) const
     return 2.0 / (1.0 + x);
 }
 
+void StereographicProjector::toScreenBatch(const double *lon, const double *lat, int count, float *x, float *y,
+                                           uchar *visible, bool refract) const
+{
+    projectAzimuthal(lon, lat, count, x, y, visible, refract, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return 2.0 / (1.0 + c);
+    });
+}
+
 double StereographicProjector::projectionL(double x) const
 {
     return 2.0 * atan2(x, 2.0);
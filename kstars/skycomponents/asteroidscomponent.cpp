@@ -17,6 +17,7 @@
 #include "solarsystemcomposite.h"
 #include "skycomponent.h"
 #include "skylabeler.h"
+#include "skymapcomposite.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #else
@@ -40,7 +41,7 @@
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent)
     : BinaryListComponent(this, "asteroids"), SolarSystemListComponent(parent)
 {
-    loadData();
+    loadDataAsync();
 }
 
 bool AsteroidsComponent::selected()
@@ -168,11 +169,6 @@ void AsteroidsComponent::loadDataFromText()
             //new_asteroid->setAngularSize(0.005);
 
             appendListObject(new_asteroid);
-
-            // Add name to the list of object names
-            objectNames(SkyObject::ASTEROID).append(name);
-            objectLists(SkyObject::ASTEROID)
-            .append(QPair<QString, const SkyObject *>(name, new_asteroid));
         });
     }
     catch (const std::runtime_error &e)
@@ -316,6 +312,9 @@ void AsteroidsComponent::downloadReady()
 #endif
     // Reload asteroids
     loadData(true);
+#ifndef KSTARS_LITE
+    KStarsData::Instance()->skyComposite()->contentChanged();
+#endif
 
 #ifdef KSTARS_LITE
     KStarsLite::Instance()->data()->setFullTimeUpdate();
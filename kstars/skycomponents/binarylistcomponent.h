@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <QBuffer>
 #include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QFileInfo>
+#include <QFuture>
+#include <QtConcurrent>
 
 #include "listcomponent.h"
 #include "binarylistcomponent.h"
@@ -34,6 +39,15 @@
  * This is a concession to the already present architecture.
  *
  * File paths are determent by the means of KSPaths::writableLocation.
+ *
+ * The binary starts with a small header recording the size and modification time of
+ * the text file it was generated from. A binary whose header does not match the
+ * current text file is considered stale and is regenerated from text. The binary is
+ * memory-mapped while it is read, so no intermediate copy of the file is made.
+ *
+ * The data can also be loaded on the thread pool with `loadDataAsync()`. Only the object
+ * list of the component is filled then, the names are added to the lists of object names
+ * of the sky composite by `finishLoading()` on the GUI thread.
  */
 template <class T, typename Component>
 class BinaryListComponent
@@ -57,6 +71,14 @@ public:
      */
     BinaryListComponent(Component* parent, QString basename, QString txtExt, QString binExt);
 
+    /**
+     * @brief finishLoading
+     * @short Wait for the data started by `loadDataAsync()` and register the object names.
+     * Must be called from the GUI thread before the component data is used. Does nothing if
+     * no asynchronous load is pending.
+     */
+    void finishLoading();
+
 protected:
     /**
      * @brief loadData
@@ -74,18 +96,27 @@ protected:
      */
     virtual void loadData(bool dropBinaryFile);
 
+    /**
+     * @brief loadDataAsync
+     * @short Start loading the component data on the thread pool. Call from the
+     * constructor of the derived class, after the file paths are set.
+     * @see finishLoading()
+     */
+    void loadDataAsync();
+
     /**
      * @brief loadDataFromBinary
      * @short Opens the default binfile and calls `loadDataFromBinary([FILE])`
      */
-    virtual void loadDataFromBinary();
+    virtual bool loadDataFromBinary();
 
     /**
      * @brief loadDataFromBinary
      * @param binfile the binary file
      * @short Loads the component data from the given binary.
+     * @return false if the binary could not be read or is stale with respect to the text file
      */
-    virtual void loadDataFromBinary(QFile &binfile);
+    virtual bool loadDataFromBinary(QFile &binfile);
 
     /**
      * @brief writeBinary
@@ -107,7 +138,8 @@ protected:
      * This method shall be implemented by those who derive this class.
      *
      * This method should load the component data from text by the use of
-     * `addListObject`  or similar.
+     * `addListObject`  or similar. It must not touch the lists of object names, as it may
+     * run off the GUI thread.
      */
     virtual void loadDataFromText() = 0;
 
@@ -139,8 +171,32 @@ protected:
 
 // Don't allow the children to mess with the Binary Version!
 private:
+    /** @short Loads the objects from binary or text without registering their names. */
+    void loadObjects(bool dropBinaryFile);
+
+    /** @short Removes the objects of the component, leaving the lists of object names alone. */
+    void clearObjects();
+
+    /** @short Adds the names of all objects to the lists of object names. */
+    void registerObjectNames();
+
+    /**
+     * @short Reads the binary header and checks it against the current text file.
+     * @return true if the stream is positioned after a valid, up-to-date header
+     */
+    bool readHeader(QDataStream &in, quint32 &count) const;
+
+    /** @short Writes the binary header for the current text file and @p count objects. */
+    void writeHeader(QDataStream &out, quint32 count) const;
+
+    static constexpr quint32 binmagic = 0x4b53424c; // "KSBL"
+    static constexpr quint32 binformat = 1;
+
     QDataStream::Version binversion = QDataStream::Qt_5_5;
     Component* parent;
+
+    QFuture<void> pending_load;
+    bool load_pending { false };
 };
 
 template<class T, typename Component>
@@ -161,55 +217,176 @@ void  BinaryListComponent<T, Component>::loadData()
 
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
+{
+    // A reload must not race with a pending asynchronous load
+    finishLoading();
+
+    loadObjects(dropBinaryFile);
+    registerObjectNames();
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::loadDataAsync()
+{
+    load_pending = true;
+    pending_load = QtConcurrent::run([this]()
+    {
+        loadObjects(false);
+    });
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::finishLoading()
+{
+    if (!load_pending)
+        return;
+
+    pending_load.waitForFinished();
+    load_pending = false;
+    registerObjectNames();
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::loadObjects(bool dropBinaryFile)
 {
     // Clear old Stuff (in case of reload)
-    clearData();
+    clearObjects();
 
     // Drop Binary file for a fresh reload
     if(dropBinaryFile)
         dropBinary();
 
     QFile binfile(filepath_bin);
-    if (binfile.exists()) {
-        loadDataFromBinary(binfile);
-    } else {
-        loadDataFromText();
+    if (binfile.exists() && loadDataFromBinary(binfile))
+        return;
+
+    // Missing, unreadable or stale binary: rebuild it from text
+    clearObjects();
+    loadDataFromText();
+
+    // Don't cache a failed text load, we want to retry next time
+    if (!parent->m_ObjectList.isEmpty())
         writeBinary(binfile);
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::registerObjectNames()
+{
+    QStringList &names = parent->objectNames(T::TYPE);
+    QVector<QPair<QString, const SkyObject *>> &lists = parent->objectLists(T::TYPE);
+
+    names.clear();
+    lists.clear();
+    names.reserve(parent->m_ObjectList.size());
+    lists.reserve(parent->m_ObjectList.size());
+
+    for (auto object : parent->m_ObjectList)
+    {
+        names.append(object->name());
+        lists.append(QPair<QString, const SkyObject *>(object->name(), object));
     }
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary()
+bool  BinaryListComponent<T, Component>::loadDataFromBinary()
 {
     QFile binfile(filepath_bin);
-    loadDataFromBinary(binfile);
+    return loadDataFromBinary(binfile);
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
+bool  BinaryListComponent<T, Component>::readHeader(QDataStream &in, quint32 &count) const
 {
-    // Open our binary file and create a Stream
-    if (binfile.open(QIODevice::ReadOnly))
+    quint32 magic = 0, format = 0;
+    qint64 size = -1, mtime = -1;
+
+    in >> magic >> format >> size >> mtime >> count;
+    if (in.status() != QDataStream::Ok || magic != binmagic || format != binformat)
+        return false;
+
+    // Without a text file there is nothing to compare against, so trust the binary
+    QFileInfo txtinfo(filepath_txt);
+    if (!txtinfo.exists())
+        return true;
+
+    return size == txtinfo.size() && mtime == txtinfo.lastModified().toMSecsSinceEpoch();
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::writeHeader(QDataStream &out, quint32 count) const
+{
+    QFileInfo txtinfo(filepath_txt);
+    const qint64 size  = txtinfo.exists() ? txtinfo.size() : -1;
+    const qint64 mtime = txtinfo.exists() ? txtinfo.lastModified().toMSecsSinceEpoch() : -1;
+
+    out << binmagic << binformat << size << mtime << count;
+}
+
+template<class T, typename Component>
+bool  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
+{
+    if (!binfile.open(QIODevice::ReadOnly))
     {
-        QDataStream in(&binfile);
+        qWarning() << "Failed loading binary data from" << binfile.fileName();
+        return false;
+    }
 
-        // Use the specified binary version
-        // TODO: Place this into the config
-        in.setVersion(binversion);
-        in.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    // Map the whole file and stream from memory, fall back to regular reads otherwise
+    uchar *mapped = binfile.map(0, binfile.size());
+    QBuffer buffer;
+    QIODevice *device = &binfile;
+    if (mapped)
+    {
+        buffer.setData(QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<int>(binfile.size())));
+        buffer.open(QIODevice::ReadOnly);
+        device = &buffer;
+    }
 
-        while(!in.atEnd()){
-            T *new_object = nullptr;
-            in >> new_object;
+    QDataStream in(device);
 
-            parent->appendListObject(new_object);
-            // Add name to the list of object names
-            parent->objectNames(T::TYPE).append(new_object->name());
-            parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
-        }
+    // Use the specified binary version
+    // TODO: Place this into the config
+    in.setVersion(binversion);
+    in.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    quint32 count = 0;
+    if (!readHeader(in, count))
+    {
+        qDebug() << "Binary data in" << binfile.fileName() << "is stale, regenerating it.";
+        buffer.close();
+        if (mapped)
+            binfile.unmap(mapped);
         binfile.close();
+        return false;
+    }
+
+    parent->m_ObjectList.reserve(static_cast<int>(count));
+
+    for (quint32 n = 0; n < count && !in.atEnd(); ++n)
+    {
+        T *new_object = nullptr;
+        in >> new_object;
+
+        if (in.status() != QDataStream::Ok)
+        {
+            delete new_object;
+            break;
+        }
+
+        parent->appendListObject(new_object);
     }
-    else qWarning() << "Failed loading binary data from" << binfile.fileName();
+
+    const bool complete = in.status() == QDataStream::Ok && static_cast<quint32>(parent->m_ObjectList.size()) == count;
+
+    buffer.close();
+    if (mapped)
+        binfile.unmap(mapped);
+    binfile.close();
+
+    if (!complete)
+        qWarning() << "Truncated binary data in" << binfile.fileName();
+
+    return complete;
 }
 
 template<class T, typename Component>
@@ -223,11 +400,18 @@ template<class T, typename Component>
 void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
 {
     // Open our file and create a stream
-    binfile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (!binfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Failed writing binary data to" << binfile.fileName();
+        return;
+    }
+
     QDataStream out(&binfile);
     out.setVersion(binversion);
     out.setFloatingPointPrecision(QDataStream::DoublePrecision);
 
+    writeHeader(out, static_cast<quint32>(parent->m_ObjectList.size()));
+
     // Now just dump out everything
     for(auto object : parent->m_ObjectList){
          out << *((T*)object);
@@ -250,12 +434,18 @@ bool  BinaryListComponent<T, Component>::dropText()
 
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::clearData()
+{
+    clearObjects();
+
+    parent->objectLists(T::TYPE).clear();
+    parent->objectNames(T::TYPE).clear();
+}
+
+template<class T, typename Component>
+void  BinaryListComponent<T, Component>::clearObjects()
 {
     // Clear lists
     qDeleteAll(parent->m_ObjectList);
     parent->m_ObjectList.clear();
     parent->m_ObjectHash.clear();
-
-    parent->objectLists(T::TYPE).clear();
-    parent->objectNames(T::TYPE).clear();
 }
@@ -286,7 +286,7 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
 void CatalogsComponent::updateSkyMesh(SkyMap &map, MeshBufNum_t buf)
 {
-    SkyPoint *focus = map.focus();
+    SkyPoint *focus = map.projector()->viewParams().focus;
     float radius    = map.projector()->fov();
     if (radius > 180.0)
         radius = 180.0;
@@ -22,6 +22,7 @@
 #endif
 #include "Options.h"
 #include "skylabeler.h"
+#include "skymapcomposite.h"
 #include "skypainter.h"
 #include "solarsystemcomposite.h"
 #include "auxiliary/filedownloader.h"
@@ -37,9 +38,14 @@
 #include <cmath>
 
 CometsComponent::CometsComponent(SolarSystemComposite *parent)
-    : SolarSystemListComponent(parent)
+    : BinaryListComponent(this, "cometels", "json.gz", "bin"), SolarSystemListComponent(parent)
 {
-    loadData();
+    // The comet elements may be the copy shipped with KStars, not a downloaded one
+    QString file_name = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString("cometels.json.gz"));
+    if (!file_name.isEmpty())
+        filepath_txt = file_name;
+
+    loadDataAsync();
 }
 
 bool CometsComponent::selected()
@@ -76,20 +82,14 @@ bool CometsComponent::selected()
  * @li 21 comet nuclear magnitude slope parameter
  * @note See KSComet constructor for more details.
  */
-void CometsComponent::loadData()
+void CometsComponent::loadDataFromText()
 {
     QString name, orbit_class;
 
     emitProgressText(i18n("Loading comets"));
     qCInfo(KSTARS) << "Loading comets";
 
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
-
-    QString file_name = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString("cometels.json.gz"));
+    const QString &file_name = filepath_txt;
 
     try
     {
@@ -148,10 +148,6 @@ void CometsComponent::loadData()
             com->setOrbitClass(orbit_class);
             com->setAngularSize(0.005);
             appendListObject(com);
-
-            // Add *short* name to the list of object names
-            objectNames(SkyObject::COMET).append(com->name());
-            objectLists(SkyObject::COMET).append(QPair<QString, const SkyObject *>(com->name(), com));
         });
     }
     catch (const std::runtime_error&)
@@ -359,8 +355,12 @@ void CometsComponent::downloadReady()
     }
 #endif
 
-    // Reload comets
-    loadData();
+    // Reload comets from the freshly downloaded file
+    filepath_txt = file.fileName();
+    loadData(true);
+#ifndef KSTARS_LITE
+    KStarsData::Instance()->skyComposite()->contentChanged();
+#endif
 
 #ifdef KSTARS_LITE
     KStarsLite::Instance()->data()->setFullTimeUpdate();
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include "binarylistcomponent.h"
 #include "ksparser.h"
+#include "skyobjects/kscomet.h"
 #include "solarsystemlistcomponent.h"
 #include "filedownloader.h"
 
@@ -23,10 +25,13 @@ class SkyLabeler;
  * @author Jason Harris
  * @version 0.1
  */
-class CometsComponent : public QObject, public SolarSystemListComponent
+class CometsComponent : public QObject, public SolarSystemListComponent,
+    virtual public BinaryListComponent<KSComet, CometsComponent>
 {
         Q_OBJECT
 
+        friend class BinaryListComponent<KSComet, CometsComponent>;
+
     public:
         /**
          * @short Default constructor.
@@ -46,7 +51,7 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         void downloadError(const QString &errorString);
 
     private:
-        void loadData();
+        void loadDataFromText() override;
 
         QPointer<FileDownloader> downloadJob;
 };
@@ -17,6 +17,7 @@
 #include "starblock.h"
 #include "starcomponent.h"
 #include "htmesh/MeshIterator.h"
+#include "ksprofiler.h"
 #include "projections/projector.h"
 
 #include <qplatformdefs.h>
@@ -279,7 +280,7 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 
     m_skyMesh->inDraw(true);
 
-    SkyPoint *focus = map->focus();
+    SkyPoint *focus = map->projector()->viewParams().focus;
     m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
 
     MeshIterator region(m_skyMesh, DRAW_BUF);
@@ -327,6 +328,8 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         region.reset();
     }
 
+    skyp->beginPointSources();
+
     while (region.hasNext())
     {
         ++nTrixels;
@@ -388,7 +391,7 @@ void DeepStarComponent::draw(SkyPainter *skyp)
                 if (mag > maglim)
                     break;
 
-                if (skyp->drawPointSource(curStar, mag, curStar->spchar()))
+                if (skyp->addPointSource(curStar, mag, curStar->spchar()))
                     visibleStarCount++;
             }
         }
@@ -397,7 +400,13 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //        verifySBLIntegrity();
         t_drawUnnamed += t.restart();
     }
+    skyp->flushPointSources();
     m_skyMesh->inDraw(false);
+
+    // The timers above are in milliseconds
+    KSProfiler::addTime("draw/deepstars/dynamicload", t_dynamicLoad * 1000000LL);
+    KSProfiler::addTime("draw/deepstars/drawunnamed", t_drawUnnamed * 1000000LL);
+    KSProfiler::count("draw/deepstars/visible", visibleStarCount);
 #ifdef PROFILE_SINCOS
     trig_calls_here += dms::trig_function_calls;
     trig_redundancy_here += dms::redundant_trig_function_calls;
@@ -12,6 +12,7 @@
 #include "skymap.h"
 #include "fitsviewer/fitsdata.h"
 #include "auxiliary/kspaths.h"
+#include "ekos/auxiliary/solverservice.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
 
@@ -21,6 +22,7 @@
 #include <QComboBox>
 #include <QtConcurrent>
 #include <QRegularExpression>
+#include <QThread>
 
 namespace
 {
@@ -45,6 +47,9 @@ enum ColumnIndex
 constexpr int UNPROCESSED_INDEX = 0;
 constexpr int OK_INDEX = 4;
 
+// Reduced resolution levels of the overlay images are not built below this width.
+constexpr int MIN_LEVEL_WIDTH = 32;
+
 // Helper to create the image overlay table.
 // Start the table, displaying the heading and timing information, common to all sessions.
 void setupTable(QTableWidget *table)
@@ -124,6 +129,43 @@ QString toDecString(double dec)
 }
 }  // namespace
 
+void ImageOverlay::setImage(QImage *img)
+{
+    QSharedPointer<QImage> image(img);
+    setImage(image, img != nullptr ? makeLevels(*img) : QVector<QImage>());
+}
+
+void ImageOverlay::setImage(const QSharedPointer<QImage> &img, const QVector<QImage> &levels)
+{
+    m_Img = img;
+    m_Levels = levels;
+}
+
+QVector<QImage> ImageOverlay::makeLevels(const QImage &img)
+{
+    QVector<QImage> levels;
+    if (img.isNull())
+        return levels;
+
+    QImage level = img;
+    while (level.width() / 2 >= MIN_LEVEL_WIDTH && level.height() / 2 >= 1)
+    {
+        level = level.scaled(level.width() / 2, level.height() / 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        levels.append(level);
+    }
+    return levels;
+}
+
+QImage ImageOverlay::imageForWidth(double width) const
+{
+    for (int i = m_Levels.size() - 1; i >= 0; --i)
+    {
+        if (m_Levels[i].width() >= width)
+            return m_Levels[i];
+    }
+    return *m_Img;
+}
+
 ImageOverlayComponent::ImageOverlayComponent(SkyComposite *parent) : SkyComponent(parent)
 {
     QDir dir = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/imageOverlays");
@@ -288,9 +330,9 @@ void ImageOverlayComponent::statusCellChanged(int row)
                 QImage *img = loadImageFile(fullFilename, !m_Overlays[row].m_EastToTheRight);
                 m_Overlays[row].m_Width = img->width();
                 m_Overlays[row].m_Height = img->height();
-                m_Overlays[row].m_Img.reset(img);
+                m_Overlays[row].setImage(img);
             }
-            saveToUserDB();
+            saveToUserDB(row);
             QString msg = i18n("Stored OK status for %1.", m_Overlays[row].m_Filename);
             emit updateLog(msg);
         }
@@ -355,14 +397,7 @@ void ImageOverlayComponent::setWidgets(QTableWidget *table, QPlainTextEdit *stat
 
 void ImageOverlayComponent::initSolverProfiles()
 {
-    QString savedOptionsProfiles = QDir(KSPaths::writableLocation(
-                                            QStandardPaths::AppLocalDataLocation)).filePath("SavedAlignProfiles.ini");
-
-    QList<SSolver::Parameters> optionsList;
-    if(QFile(savedOptionsProfiles).exists())
-        optionsList = StellarSolver::loadSavedOptionsProfiles(savedOptionsProfiles);
-    else
-        optionsList = Ekos::getDefaultAlignOptionsProfiles();
+    const QList<SSolver::Parameters> optionsList = Ekos::getOptionsProfiles(Ekos::AlignProfiles);
 
     m_SolverProfile->clear();
     for(auto &param : optionsList)
@@ -443,21 +478,56 @@ void ImageOverlayComponent::updateTable()
 
 void ImageOverlayComponent::loadAllImageFiles()
 {
-    m_LoadImagesFuture = QtConcurrent::run(this, &ImageOverlayComponent::loadImageFileLoop);
+    // The worker only gets the file names, the overlays themselves are only touched on this thread.
+    QVector<QPair<QString, bool>> filenames;
+    for (const auto &o : m_Overlays)
+    {
+        if (o.m_Status == ImageOverlay::AVAILABLE && o.m_Img.get() == nullptr)
+            filenames.push_back(qMakePair(o.m_Filename, !o.m_EastToTheRight));
+    }
+    const QString directory = m_Directory;
+    m_LoadImagesFuture = QtConcurrent::run([this, directory, filenames]()
+    {
+        loadImageFileLoop(directory, filenames);
+    });
 }
 
-void ImageOverlayComponent::loadImageFileLoop()
+void ImageOverlayComponent::loadImageFileLoop(const QString &directory, const QVector<QPair<QString, bool>> &filenames)
 {
     emit updateLog(i18n("Loading image files..."));
-    while (loadImageFile());
-    int num = 0;
-    for (const auto &o : m_Overlays)
-        if (o.m_Img.get() != nullptr)
-            num++;
-    emit updateLog(i18n("%1 image files loaded.", num));
-    // Restore editing for the table.
-    m_ImageOverlayTable->setEditTriggers(m_EditTriggers);
-    m_Initialized = true;
+    for (const auto &file : filenames)
+    {
+        const QString fullFilename = QString("%1%2%3").arg(directory).arg(QDir::separator()).arg(file.first);
+        QSharedPointer<QImage> img(loadImageFile(fullFilename, file.second));
+        const QVector<QImage> levels = ImageOverlay::makeLevels(*img);
+
+        // Note: The original width and height in m_Width/m_Height is kept even
+        // though the image was rescaled. This is to get the rendering right
+        // with the original scale.
+        const QString filename = file.first;
+        QMetaObject::invokeMethod(this, [this, filename, img, levels]()
+        {
+            auto row = m_Filenames.find(filename);
+            if (row == m_Filenames.end() || row.value() >= m_Overlays.size())
+                return;
+            ImageOverlay &o = m_Overlays[row.value()];
+            if (o.m_Filename == filename && o.m_Img.get() == nullptr)
+                o.setImage(img, levels);
+        }, Qt::QueuedConnection);
+    }
+
+    // Queued after the images, so that they are all set when this runs.
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        int num = 0;
+        for (const auto &o : m_Overlays)
+            if (o.m_Img.get() != nullptr)
+                num++;
+        emit updateLog(i18n("%1 image files loaded.", num));
+        // Restore editing for the table.
+        m_ImageOverlayTable->setEditTriggers(m_EditTriggers);
+        m_Initialized = true;
+    }, Qt::QueuedConnection);
 }
 
 QImage *ImageOverlayComponent::loadImageFile (const QString &fullFilename, bool mirror)
@@ -474,27 +544,6 @@ QImage *ImageOverlayComponent::loadImageFile (const QString &fullFilename, bool
     return processedImg;
 }
 
-bool ImageOverlayComponent::loadImageFile()
-{
-    bool updatedSomething = false;
-
-    for (auto &o : m_Overlays)
-    {
-        if (o.m_Status == o.ImageOverlay::AVAILABLE && o.m_Img.get() == nullptr)
-        {
-            QString fullFilename = QString("%1%2%3").arg(m_Directory).arg(QDir::separator()).arg(o.m_Filename);
-            QImage *img = loadImageFile(fullFilename, !o.m_EastToTheRight);
-            o.m_Img.reset(img);
-            updatedSomething = true;
-
-            // Note: The original width and height in o.m_Width/m_Height is kept even
-            // though the image was rescaled. This is to get the rendering right
-            // with the original scale.
-        }
-    }
-    return updatedSomething;
-}
-
 
 // Copies the info in m_Overlays into m_ImageOverlayTable UI.
 void ImageOverlayComponent::initializeGui()
@@ -580,27 +629,62 @@ void ImageOverlayComponent::saveToUserDB()
         KStarsData::Instance()->userdb()->AddImageOverlay(metadata);
 }
 
-void ImageOverlayComponent::solveImage(const QString &filename)
+// Only updates the DB row of one overlay, which is much faster than rewriting
+// the table when solving many overlays.
+void ImageOverlayComponent::saveToUserDB(int row)
+{
+    if (row >= 0 && row < m_Overlays.size())
+        KStarsData::Instance()->userdb()->AddImageOverlay(m_Overlays[row]);
+}
+
+int ImageOverlayComponent::numWorkers() const
+{
+    if (Options::imageOverlaySolvers() > 0)
+        return Options::imageOverlaySolvers();
+    return std::max(1, QThread::idealThreadCount() / 2);
+}
+
+bool ImageOverlayComponent::solversRunning() const
+{
+    for (const auto &solver : m_Solvers)
+    {
+        if (solver->isRunning())
+            return true;
+    }
+    return false;
+}
+
+void ImageOverlayComponent::solveImage(int row)
 {
     if (!m_Initialized) return;
     m_SolveButton->setText(i18n("Abort"));
+    const QString filename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
     const int solverTimeout = Options::imageOverlayTimeout();
     auto profiles = Ekos::getDefaultAlignOptionsProfiles();
     auto parameters = profiles.at(m_SolverProfile->currentIndex());
     // Double search radius
     parameters.search_radius = parameters.search_radius * 2;
+    // The workers already use the cores, one thread per solve scales better.
+    if (numWorkers() > 1)
+        parameters.multiAlgorithm = SSolver::NOT_MULTI;
+
+    QSharedPointer<SolverUtils> solver(new SolverUtils(parameters, solverTimeout), &QObject::deleteLater);
+    SolverUtils *solverPtr = solver.get();
+    connect(solverPtr, &SolverUtils::done, this, [this, solverPtr](bool timedOut, bool success,
+            const FITSImage::Solution & solution, double elapsedSeconds)
+    {
+        solverDone(solverPtr, timedOut, success, solution, elapsedSeconds);
+    });
+    m_Solvers.append(solver);
+    m_SolvingRows[solverPtr] = row;
 
-    m_Solver.reset(new SolverUtils(parameters, solverTimeout),  &QObject::deleteLater);
-    connect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone, Qt::UniqueConnection);
-
-    if (m_RowsToSolve.size() > 1)
+    if (m_RowsToSolve.size() > 0)
         emit updateLog(i18n("Solving: %1. %2 in queue.", filename, m_RowsToSolve.size()));
     else
         emit updateLog(i18n("Solving: %1.", filename));
 
     // If the user added some RA/DEC/Scale values to the table, they will be used in the solve
     // (but aren't remembered in the DB unless the solve is successful).
-    int row = m_RowsToSolve[0];
     QString raString = m_ImageOverlayTable->item(row, RA_COL)->text().toLatin1().data();
     QString decString = m_ImageOverlayTable->item(row, DEC_COL)->text().toLatin1().data();
     QString scaleString = m_ImageOverlayTable->item(row, ARCSEC_PER_PIXEL_COL)->text().toLatin1().data();
@@ -624,12 +708,12 @@ void ImageOverlayComponent::solveImage(const QString &filename)
     {
         auto lowScale = scale * 0.75;
         auto highScale = scale * 1.25;
-        m_Solver->useScale(true, lowScale, highScale);
+        solver->useScale(true, lowScale, highScale);
     }
     if (raOK && decOK)
-        m_Solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
+        solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
 
-    m_Solver->runSolver(filename);
+    solver->runSolver(filename);
 }
 
 void ImageOverlayComponent::tryAgain()
@@ -697,8 +781,15 @@ void ImageOverlayComponent::abortSolving()
 {
     if (!m_Initialized) return;
     m_RowsToSolve.clear();
-    if (m_Solver)
-        m_Solver->abort();
+    m_SolvingRows.clear();
+    for (const auto &solver : m_Solvers)
+        solver->abort();
+    // Queued solves stop right away, running ones are removed when they are done.
+    m_Solvers.erase(std::remove_if(m_Solvers.begin(), m_Solvers.end(), [](const QSharedPointer<SolverUtils> &solver)
+    {
+        return !solver->isRunning();
+    }), m_Solvers.end());
+    SolverService::Instance()->setMaxRunning(1);
     emit updateLog(i18n("Solving aborted."));
     m_SolveButton->setText(i18n("Solve"));
 }
@@ -711,9 +802,10 @@ void ImageOverlayComponent::startSolving()
         abortSolving();
         return;
     }
-    if (m_Solver && m_Solver->isRunning())
+    if (solversRunning())
     {
-        m_Solver->abort();
+        for (const auto &solver : m_Solvers)
+            solver->abort();
         if (m_RowsToSolve.size() > 0)
             m_TryAgainTimer.start(2000);
         return;
@@ -745,25 +837,40 @@ void ImageOverlayComponent::startSolving()
             m_RowsToSolve.push_back(row);
     }
 
-    if (m_RowsToSolve.size() > 0)
+    startWorkers();
+}
+
+void ImageOverlayComponent::startWorkers()
+{
+    const int workers = numWorkers();
+    SolverService::Instance()->setMaxRunning(workers);
+
+    while (m_SolvingRows.size() < workers && m_RowsToSolve.size() > 0)
     {
-        const int row = m_RowsToSolve[0];
+        const int row = m_RowsToSolve.takeFirst();
         const QString filename =
             QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
         if ((m_Overlays[row].m_Status == ImageOverlay::AVAILABLE) &&
                 !shouldSolveAnyway(m_ImageOverlayTable, row))
         {
             emit updateLog(i18n("%1 already solved. Skipping.", filename));
-            m_RowsToSolve.removeFirst();
-            if (m_RowsToSolve.size() > 0)
-                startSolving();
-            return;
+            continue;
         }
 
-        auto img = new QImage(filename);
-        m_Overlays[row].m_Width = img->width();
-        m_Overlays[row].m_Height = img->height();
-        solveImage(filename);
+        // Only the header is read to get the size.
+        QImageReader reader(filename);
+        QSize size = reader.size();
+        if (!size.isValid())
+            size = reader.read().size();
+        m_Overlays[row].m_Width = size.width();
+        m_Overlays[row].m_Height = size.height();
+        solveImage(row);
+    }
+
+    if (m_SolvingRows.isEmpty())
+    {
+        SolverService::Instance()->setMaxRunning(1);
+        m_SolveButton->setText(i18n("Solve"));
     }
 }
 
@@ -776,27 +883,36 @@ void ImageOverlayComponent::reload()
     loadAllImageFiles();
 }
 
-void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSImage::Solution &solution,
-                                       double elapsedSeconds)
+void ImageOverlayComponent::solverDone(SolverUtils *solver, bool timedOut, bool success,
+                                       const FITSImage::Solution &solution, double elapsedSeconds)
 {
-    disconnect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone);
-    m_SolveButton->setText(i18n("Solve"));
-    if (m_RowsToSolve.size() == 0)
+    for (int i = 0; i < m_Solvers.size(); ++i)
+    {
+        if (m_Solvers[i].get() == solver)
+        {
+            m_Solvers.removeAt(i);
+            break;
+        }
+    }
+    // Solves that were aborted have no row anymore.
+    auto solving = m_SolvingRows.find(solver);
+    if (solving == m_SolvingRows.end())
         return;
 
-    const int solverRow = m_RowsToSolve[0];
-    m_RowsToSolve.removeFirst();
+    const int solverRow = solving.value();
+    m_SolvingRows.erase(solving);
+    const QString &filename = m_Overlays[solverRow].m_Filename;
 
     QComboBox *statusItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(solverRow, STATUS_COL));
     if (timedOut)
     {
-        emit updateLog(i18n("Solver timed out in %1s", QString::number(elapsedSeconds, 'f', 1)));
+        emit updateLog(i18n("Solver timed out in %1s: %2", QString::number(elapsedSeconds, 'f', 1), filename));
         m_Overlays[solverRow].m_Status = ImageOverlay::PLATE_SOLVE_FAILURE;
         statusItem->setCurrentIndex(static_cast<int>(m_Overlays[solverRow].m_Status));
     }
     else if (!success)
     {
-        emit updateLog(i18n("Solver failed in %1s", QString::number(elapsedSeconds, 'f', 1)));
+        emit updateLog(i18n("Solver failed in %1s: %2", QString::number(elapsedSeconds, 'f', 1), filename));
         m_Overlays[solverRow].m_Status = ImageOverlay::PLATE_SOLVE_FAILURE;
         statusItem->setCurrentIndex(static_cast<int>(m_Overlays[solverRow].m_Status));
     }
@@ -809,8 +925,8 @@ void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSIm
         m_Overlays[solverRow].m_EastToTheRight = solution.parity;
         m_Overlays[solverRow].m_Status = ImageOverlay::AVAILABLE;
 
-        QString msg = i18n("Solver success in %1s: RA %2 DEC %3 Scale %4 Angle %5",
-                           QString::number(elapsedSeconds, 'f', 1),
+        QString msg = i18n("Solver success in %1s: %2 RA %3 DEC %4 Scale %5 Angle %6",
+                           QString::number(elapsedSeconds, 'f', 1), filename,
                            QString::number(solution.ra, 'f', 2),
                            QString::number(solution.dec, 'f', 2),
                            QString::number(solution.pixscale, 'f', 2),
@@ -833,13 +949,12 @@ void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSIm
         // Load the image.
         QString fullFilename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[solverRow].m_Filename);
         QImage *img = loadImageFile(fullFilename, !m_Overlays[solverRow].m_EastToTheRight);
-        m_Overlays[solverRow].m_Img.reset(img);
+        m_Overlays[solverRow].setImage(img);
     }
-    saveToUserDB();
+    saveToUserDB(solverRow);
 
-    if (m_RowsToSolve.size() > 0)
-        startSolving();
-    else
+    startWorkers();
+    if (m_SolvingRows.isEmpty())
     {
         emit updateLog(i18n("Done solving. %1 available.", numAvailable()));
         m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.", m_Overlays.size(), numAvailable()));
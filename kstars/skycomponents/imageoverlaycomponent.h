@@ -18,6 +18,8 @@
 #include <QGroupBox>
 #include <QComboBox>
 #include <QAbstractItemView>
+#include <QHash>
+#include <QVector>
 #include "fitsviewer/fitsdata.h"
 
 class QTableWidget;
@@ -57,6 +59,27 @@ class ImageOverlay
         int m_Width = 0;
         int m_Height = 0;
         QSharedPointer<QImage> m_Img = nullptr;
+
+        /**
+         * @brief Sets the image and builds its reduced resolution levels.
+         * Each level halves the size of the previous one, m_Img being the first.
+         */
+        void setImage(QImage *img);
+
+        /**
+         * @brief Sets the image and the levels made from it by makeLevels().
+         * Must be called on the GUI thread, which draws the overlays.
+         */
+        void setImage(const QSharedPointer<QImage> &img, const QVector<QImage> &levels);
+
+        /** @return the reduced resolution levels of img, can be called from any thread */
+        static QVector<QImage> makeLevels(const QImage &img);
+
+        /** @return the smallest level at least @p width pixels wide, or m_Img if none is smaller */
+        QImage imageForWidth(double width) const;
+
+    private:
+        QVector<QImage> m_Levels;
 };
 
 /**
@@ -104,8 +127,14 @@ private slots:
 private:
     void loadFromUserDB();
     void saveToUserDB();
-    void solveImage(const QString &filename);
-    void solverDone(bool timedOut, bool success, const FITSImage::Solution &solution, double elapsedSeconds);
+    void saveToUserDB(int row);
+    void solveImage(int row);
+    void solverDone(SolverUtils *solver, bool timedOut, bool success, const FITSImage::Solution &solution,
+                    double elapsedSeconds);
+    // Starts solves of queued rows while there are fewer than the configured number of workers.
+    void startWorkers();
+    int numWorkers() const;
+    bool solversRunning() const;
     void initializeGui();
     int numAvailable();
     void cellChanged(int row, int col);
@@ -115,8 +144,9 @@ private:
 
     // Methods that load the image files in the background.
     void loadAllImageFiles();
-    void loadImageFileLoop();
-    bool loadImageFile();
+    // Runs on a worker thread, loads the images of filenames in directory, each mirrored if its flag
+    // is set. The images are handed to the overlays on the GUI thread.
+    void loadImageFileLoop(const QString &directory, const QVector<QPair<QString, bool>> &filenames);
     QImage *loadImageFile (const QString &fullFilename, bool mirror);
 
 
@@ -131,7 +161,9 @@ private:
 
     QList<ImageOverlay> m_Overlays;
     QMap<QString, int> m_Filenames;
-    QSharedPointer<SolverUtils> m_Solver;
+    // Running solves and the rows they solve.
+    QHash<SolverUtils *, int> m_SolvingRows;
+    QList<QSharedPointer<SolverUtils>> m_Solvers;
     QList<int> m_RowsToSolve;
     QString m_Directory;
     QTimer m_TryAgainTimer;
@@ -81,9 +81,12 @@ void SatellitesComponent::update(KSNumbers *)
     if (!selected())
         return;
 
+    // Time and observer terms are shared by every satellite, compute them once per update
+    const Satellite::Environment env = Satellite::currentEnvironment();
+
     foreach (SatelliteGroup *group, m_groups)
     {
-        group->updateSatellitesPos();
+        group->updateSatellitesPos(env);
     }
 }
 
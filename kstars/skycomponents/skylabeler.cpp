@@ -6,6 +6,8 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 
 #include <QPainter>
@@ -13,20 +15,22 @@
 
 #include "Options.h"
 #include "kstarsdata.h" // MINZOOM
+#include "ksprofiler.h"
 #include "skymap.h"
 #include "projections/projector.h"
 
-//---------------------------------------------------------------------------//
-// A Little data container class
-//---------------------------------------------------------------------------//
-
-typedef struct LabelRun
+namespace
 {
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
-
-} LabelRun;
+// Index of the first run of the row ending at or after x
+inline int firstRunEndingAfter(const LabelRow &row, int x)
+{
+    auto it = std::lower_bound(row.cbegin(), row.cend(), x, [](const LabelRun & run, int value)
+    {
+        return run.end < value;
+    });
+    return static_cast<int>(it - row.cbegin());
+}
+}
 
 //----- Now for the main event ----------------------------------------------//
 
@@ -97,17 +101,7 @@ SkyLabeler::SkyLabeler()
 #endif
 }
 
-SkyLabeler::~SkyLabeler()
-{
-    for (auto &row : screenRows)
-    {
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        delete row;
-    }
-}
+SkyLabeler::~SkyLabeler() = default;
 
 bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
 {
@@ -251,14 +245,12 @@ void SkyLabeler::reset(SkyMap *skyMap)
 {
     // ----- Set up Projector ---
     m_proj = skyMap->projector();
+    // The projector may be drawing an offscreen view of a different size than the sky map
+    const int width  = int(m_proj->viewParams().width);
+    const int height = int(m_proj->viewParams().height);
     // ----- Set up Painter -----
-    if (m_p.isActive())
-        m_p.end();
-    m_picture = QPicture();
-    m_p.begin(&m_picture);
-    //This works around BUG 10496 in Qt
-    m_p.drawPoint(0, 0);
-    m_p.drawPoint(skyMap->width() + 1, skyMap->height() + 1);
+    m_pictures.clear();
+    beginPicture(width, height);
     // ----- Set up Zoom Dependent Font -----
 
     m_stdFont = QFont(m_p.font());
@@ -273,44 +265,36 @@ void SkyLabeler::reset(SkyMap *skyMap)
     // ----- Prepare Virtual Screen -----
     m_yScale = (m_fontMetrics.height() + 1.0);
 
-    int maxY = int(skyMap->height() / m_yScale);
+    int maxY = int(height / m_yScale);
     if (maxY < 1)
         maxY = 1; // prevents a crash below?
 
-    int m_maxX = skyMap->width();
+    int m_maxX = width;
     m_size     = (maxY + 1) * m_maxX;
 
     // Resize if needed:
-    if (maxY > m_maxY)
+    if (maxY >= screenRows.size())
     {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
+        screenRows.resize(maxY + 1);
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
+    // Clear all pre-existing rows as needed, keeping their capacity for the next frame
 
     int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
 
     for (int y = 0; y <= minMaxY; y++)
     {
-        LabelRow *row = screenRows[y];
-
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        row->clear();
+        screenRows[y].resize(0);
     }
 
     // never decrease m_maxY:
     if (m_maxY < maxY)
         m_maxY = maxY;
 
-    // reset the counters
+    // report the counters of the previous frame, then reset them
+    KSProfiler::count("labels/hits", m_hits);
+    KSProfiler::count("labels/misses", m_misses);
     m_marks = m_hits = m_misses = m_elements = 0;
 
     //----- Clear out labelList -----
@@ -346,35 +330,28 @@ void SkyLabeler::reset()
     m_size     = (maxY + 1) * m_maxX;
 
     // Resize if needed:
-    if (maxY > m_maxY)
+    if (maxY >= screenRows.size())
     {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
+        screenRows.resize(maxY + 1);
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
+    // Clear all pre-existing rows as needed, keeping their capacity for the next frame
 
     int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
 
     for (int y = 0; y <= minMaxY; y++)
     {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
+        screenRows[y].resize(0);
     }
 
     // never decrease m_maxY:
     if (m_maxY < maxY)
         m_maxY = maxY;
 
-    // reset the counters
+    // report the counters of the previous frame, then reset them
+    KSProfiler::count("labels/hits", m_hits);
+    KSProfiler::count("labels/misses", m_misses);
     m_marks = m_hits = m_misses = m_elements = 0;
 
     //----- Clear out labelList -----
@@ -395,11 +372,52 @@ void SkyLabeler::draw(QPainter &p)
     {
         m_p.end();
     }
+    for (auto &picture : m_pictures)
+        picture.play(&p);
     m_picture.play(&p); //can't replay while it's being painted on
     //this is also undocumented btw.
     //m_p.begin(&m_picture);
 }
 
+void SkyLabeler::beginPicture(int width, int height)
+{
+    if (m_p.isActive())
+        m_p.end();
+    m_picture = QPicture();
+    m_p.begin(&m_picture);
+    //This works around BUG 10496 in Qt
+    m_p.drawPoint(0, 0);
+    m_p.drawPoint(width + 1, height + 1);
+}
+
+void SkyLabeler::checkpoint(Snapshot *snapshot)
+{
+    const QFont font = m_p.font();
+    const QPen pen   = m_p.pen();
+
+    m_p.end();
+    m_pictures.append(m_picture);
+
+    snapshot->pictures   = m_pictures;
+    snapshot->screenRows = screenRows;
+    snapshot->labelList  = labelList;
+    snapshot->font       = font;
+    snapshot->pen        = pen;
+
+    beginPicture(int(m_proj->viewParams().width), int(m_proj->viewParams().height));
+    m_p.setFont(font);
+    m_p.setPen(pen);
+}
+
+void SkyLabeler::restore(const Snapshot &snapshot)
+{
+    m_pictures = snapshot.pictures;
+    screenRows = snapshot.screenRows;
+    labelList  = snapshot.labelList;
+    setFont(snapshot.font);
+    m_p.setPen(snapshot.pen);
+}
+
 // We use Run Length Encoding to hold the information instead of an array of
 // chars.  This is both faster and smaller but the code is more complicated.
 //
@@ -464,14 +482,10 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
     // We must check all rows before we start marking
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
+        const LabelRow &row = screenRows[y];
+        const int i = firstRunEndingAfter(row, minX);
+        if (i < row.size() && row[i].start <= maxX)
         {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
             m_misses++;
             return false;
         }
@@ -485,52 +499,46 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
 
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
+        LabelRow &row = screenRows[y];
 
         // Simplest case: an empty row
-        if (row->size() < 1)
+        if (row.isEmpty())
         {
-            row->append(new LabelRun(minX, maxX));
+            row.append(LabelRun(minX, maxX));
             m_elements++;
             continue;
         }
 
         // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
+        int i = firstRunEndingAfter(row, minX);
 
         // i now points to first label PAST ours
 
         // if we are first, append or merge at start of list
         if (i == 0)
         {
-            if (row->at(0)->start - maxX < m_minDeltaX)
+            if (row[0].start - maxX < m_minDeltaX)
             {
-                row->at(0)->start = minX;
+                row[0].start = minX;
             }
             else
             {
-                row->insert(0, new LabelRun(minX, maxX));
+                row.insert(0, LabelRun(minX, maxX));
                 m_elements++;
             }
             continue;
         }
 
         // if we are past the last label, merge or append at end
-        else if (i == row->size())
+        else if (i == row.size())
         {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
+            if (minX - row[i - 1].end < m_minDeltaX)
             {
-                row->at(i - 1)->end = maxX;
+                row[i - 1].end = maxX;
             }
             else
             {
-                row->append(new LabelRun(minX, maxX));
+                row.append(LabelRun(minX, maxX));
                 m_elements++;
             }
             continue;
@@ -539,34 +547,33 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         // if we got here, we must insert or merge the new label
         //  between [i-1] and [i]
 
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
+        bool mergeHead = (minX - row[i - 1].end < m_minDeltaX);
+        bool mergeTail = (row[i].start - maxX < m_minDeltaX);
 
         // double merge => combine all 3 into one
         if (mergeHead && mergeTail)
         {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
+            row[i - 1].end = row[i].end;
+            row.remove(i);
             m_elements--;
         }
 
         // Merge label with [i-1]
         else if (mergeHead)
         {
-            row->at(i - 1)->end = maxX;
+            row[i - 1].end = maxX;
         }
 
         // Merge label with [i]
         else if (mergeTail)
         {
-            row->at(i)->start = minX;
+            row[i].start = minX;
         }
 
         // insert between the two
         else
         {
-            row->insert(i, new LabelRun(minX, maxX));
+            row.insert(i, LabelRun(minX, maxX));
             m_elements++;
         }
     }
@@ -632,7 +639,16 @@ void SkyLabeler::drawQueuedLabels()
 
 void SkyLabeler::drawQueuedLabelsType(SkyLabeler::label_t type)
 {
-    LabelList list = labelList[type];
+    LabelList &list = labelList[type];
+
+    // Brightest first, objects without a magnitude keep their queue order at the end
+    std::stable_sort(list.begin(), list.end(), [](const SkyLabel & a, const SkyLabel & b)
+    {
+        const float magA = a.obj->mag(), magB = b.obj->mag();
+        if (std::isnan(magB))
+            return !std::isnan(magA);
+        return magA < magB;
+    });
 
     for (const auto &item : list)
     {
@@ -709,24 +725,24 @@ void SkyLabeler::printInfo()
 //    // Check for errors in the data structure
 //    for (int y = 0; y <= m_maxY; y++)
 //    {
-//        LabelRow *row = screenRows[y];
-//        int size      = row->size();
+//        const LabelRow &row = screenRows[y];
+//        int size            = row.size();
 //        if (size < 2)
 //            continue;
 //
 //        bool error = false;
 //        for (int i = 1; i < size; i++)
 //        {
-//            if (row->at(i - 1)->end > row->at(i)->start)
+//            if (row[i - 1].end > row[i].start)
 //                error = true;
 //        }
 //        if (!error)
 //            continue;
 //
 //        printf("ERROR: %3d: ", y);
-//        for (int i = 0; i < row->size(); i++)
+//        for (int i = 0; i < row.size(); i++)
 //        {
-//            printf("(%d, %d) ", row->at(i)->start, row->at(i)->end);
+//            printf("(%d, %d) ", row[i].start, row[i].end);
 //        }
 //        printf("\n");
 //    }
@@ -18,10 +18,19 @@ class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
 
-typedef QList<LabelRun *> LabelRow;
-typedef QVector<LabelRow *> ScreenRows;
+/** A run of consecutive pixels of a screen strip that are covered by labels */
+struct LabelRun
+{
+    LabelRun() = default;
+    LabelRun(int s, int e) : start(s), end(e) {}
+    int start { 0 };
+    int end { 0 };
+};
+Q_DECLARE_TYPEINFO(LabelRun, Q_PRIMITIVE_TYPE);
+
+typedef QVector<LabelRun> LabelRow;
+typedef QVector<LabelRow> ScreenRows;
 
 /**
  *@class SkyLabeler
@@ -47,9 +56,11 @@ typedef QVector<LabelRow *> ScreenRows;
  * The information in the X-dimension is completed run length encoded. A
  * consecutive run of pixels in one strip that are covered by one or more labels
  * is stored in a LabelRun object that merely stores the start pixel and the end
- * pixel.  A LabelRow is a list of LabelRun's stored in ascending order.  This
- * saves a lot of space over an explicit array and it also makes checking for
- * overlaps faster and even makes inserting new overlaps faster on average.
+ * pixel.  A LabelRow is a contiguous vector of LabelRun's stored in ascending
+ * order.  This saves a lot of space over an explicit array.  Since the runs are
+ * sorted and never overlap, both the overlap check and the insertion point are
+ * found with a binary search, so the cost of marking a label only grows with the
+ * logarithm of the number of labels already on a strip.
  *
  * Synopsis:
  *
@@ -97,6 +108,20 @@ typedef QVector<LabelRow *> ScreenRows;
  */
 class SkyLabeler
 {
+  public:
+    /**
+     * @short Labels drawn and queued up to some point of a draw cycle.
+     * Used by the sky map to replay the labels of cached layers.
+     */
+    struct Snapshot
+    {
+        QVector<QPicture> pictures;
+        ScreenRows screenRows;
+        QVector<LabelList> labelList;
+        QFont font;
+        QPen pen;
+    };
+
   protected:
     SkyLabeler();
     SkyLabeler(SkyLabeler &skyLabler);
@@ -161,6 +186,18 @@ class SkyLabeler
          */
     void draw(QPainter &p);
 
+    /**
+         * @short save the labels drawn, queued and marked so far in @p snapshot.
+         * Labeling goes on normally after the checkpoint.
+         */
+    void checkpoint(Snapshot *snapshot);
+
+    /**
+         * @short replace the labels of the current draw cycle with those of @p snapshot.
+         * The snapshot must have been taken with the same projection and zoom.
+         */
+    void restore(const Snapshot &snapshot);
+
     //----- Font Setting -----//
 
     /**
@@ -262,6 +299,8 @@ class SkyLabeler
     /**
          * @short a convenience routine that draws all the labels from a single
          * buffer. Currently this is only called from within draw() above.
+         * Labels of brighter objects are tried first, so that when the screen
+         * gets crowded it is the fainter objects that lose their labels.
          */
     void drawQueuedLabelsType(SkyLabeler::label_t type);
 
@@ -325,6 +364,9 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
+    /** @short start recording labels into a new m_picture, covering a view of @p width x @p height */
+    void beginPicture(int width, int height);
+
     ScreenRows screenRows;
     int m_maxX { 0 };
     int m_maxY { 0 };
@@ -346,6 +388,8 @@ class SkyLabeler
 #endif
     QPainter m_p;
     QPicture m_picture;
+    /// Pictures completed at checkpoints of the current draw cycle, played before m_picture
+    QVector<QPicture> m_pictures;
     QVector<LabelList> labelList;
     const Projector *m_proj { nullptr };
     static SkyLabeler *pinstance;
@@ -28,6 +28,7 @@
 #include "kstars.h"
 #endif
 #include "kstarsdata.h"
+#include "ksprofiler.h"
 #include "milkyway.h"
 #include "satellitescomponent.h"
 #include "skylabeler.h"
@@ -46,15 +47,20 @@
 #include "observinglist.h"
 #include "skymap.h"
 #include "hipscomponent.h"
+#include "hips/hipsmanager.h"
 #include "terraincomponent.h"
 #include "imageoverlaycomponent.h"
 #include "mosaiccomponent.h"
 #endif
 
 #include <QApplication>
+#include <QDataStream>
+#include <QThread>
 
 #include <kstars_debug.h>
 
+#include <cmath>
+
 SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     : SkyComposite(parent), m_reindexNum(J2000)
 {
@@ -69,6 +75,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
 
     //Add all components
     //Stars must come before constellation lines
+    //The solar system comes first so its asteroids and comets load while the rest is built
 #ifdef KSTARS_LITE
     addComponent(m_MilkyWay = new MilkyWay(this), 50);
     addComponent(m_Stars = StarComponent::Create(this), 10);
@@ -101,13 +108,20 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
     SkyMapLite::Instance()->loadingFinished();
 #else
+    KSProfiler::Stages stages("load");
+    stages.enter("solarsystem");
+    addComponent(m_SolarSystem = new SolarSystemComposite(this), 2);
+    stages.enter("milkyway");
     addComponent(m_MilkyWay = new MilkyWay(this), 50);
+    stages.enter("stars");
     addComponent(m_Stars = StarComponent::Create(this), 10);
+    stages.enter("grids");
     addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
     addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
     addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
 
     // Do add to components.
+    stages.enter("constellations");
     addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
     m_Cultures.reset(new CultureList());
     addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
@@ -116,6 +130,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     addComponent(m_Ecliptic = new Ecliptic(this), 95);
     addComponent(m_Horizon = new HorizonComponent(this), 100);
 
+    stages.enter("catalogs");
     const auto &path = CatalogsDB::dso_db_path();
     try
     {
@@ -149,11 +164,15 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
         }
     }
 
+    stages.enter("constellationart");
     addComponent(
         m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
 
+    stages.enter("overlays");
     // Hips
     addComponent(m_HiPS = new HIPSComponent(this));
+    // Tiles that were missing from the last drawing are now available
+    connect(HIPSManager::Instance(), &HIPSManager::sigRepaint, this, &SkyMapComposite::contentChanged);
 
     addComponent(m_Terrain = new TerrainComponent(this));
 
@@ -164,10 +183,10 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     addComponent(m_Mosaic = new MosaicComponent(this));
 #endif
 
+    stages.enter("horizon");
     addComponent(m_ArtificialHorizon = new ArtificialHorizonComponent(this), 110);
 
-    addComponent(m_SolarSystem = new SolarSystemComposite(this), 2);
-
+    stages.enter("lists");
     addComponent(m_Flags = new FlagComponent(this), 4);
 
     addComponent(m_ObservingList = new TargetListComponent(this, nullptr, QPen(),
@@ -176,20 +195,30 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
                  120);
     addComponent(m_StarHopRouteList = new TargetListComponent(this, nullptr, QPen()),
                  130);
+    stages.enter("satellites");
     addComponent(m_Satellites = new SatellitesComponent(this), 7);
+    stages.enter("supernovae");
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
 #endif
+    {
+        KSProfiler::Scope scope("load/solarsystem-wait");
+        m_SolarSystem->finishLoading();
+    }
+
     connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(),
             SIGNAL(progressText(QString)));
 }
 
 void SkyMapComposite::update(KSNumbers *num)
 {
+    KSProfiler::Stages stages("update");
+
     //printf("updating SkyMapComposite\n");
     //1. Milky Way
     //m_MilkyWay->update( data, num );
     //2. Coordinate grid
     //m_EquatorialCoordinateGrid->update( num );
+    stages.enter("grids");
     m_HorizontalCoordinateGrid->update(num);
 #ifndef KSTARS_LITE
     m_LocalMeridianComponent->update(num);
@@ -199,6 +228,7 @@ void SkyMapComposite::update(KSNumbers *num)
     //4. Constellation lines
     //m_CLines->update( data, num );
     //5. Constellation names
+    stages.enter("constellationnames");
     if (m_CNames)
         m_CNames->update(num);
     //6. Equator
@@ -212,26 +242,33 @@ void SkyMapComposite::update(KSNumbers *num)
     //m_CLines->update( data, num );  // MUST follow stars.
 
     //12. Solar system
+    stages.enter("solarsystem");
     m_SolarSystem->update(num);
     //13. Satellites
+    stages.enter("satellites");
     m_Satellites->update(num);
     //14. Supernovae
+    stages.enter("supernovae");
     m_Supernovae->update(num);
     //15. Horizon
+    stages.enter("horizon");
     m_Horizon->update(num);
 #ifndef KSTARS_LITE
     //16. Flags
+    stages.enter("flags");
     m_Flags->update(num);
 #endif
 }
 
 void SkyMapComposite::updateSolarSystemBodies(KSNumbers *num)
 {
+    KSProfiler::Scope scope("update/solarsystembodies");
     m_SolarSystem->updateSolarSystemBodies(num);
 }
 
 void SkyMapComposite::updateMoons(KSNumbers *num)
 {
+    KSProfiler::Scope scope("update/moons");
     m_SolarSystem->updateMoons(num);
 }
 
@@ -245,6 +282,20 @@ void SkyMapComposite::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
 #ifndef KSTARS_LITE
+    KSProfiler::Scope scope("draw");
+
+    if (!beginDraw())
+        return;
+
+    drawSky(skyp);
+    drawSolarSystem(skyp);
+    drawForeground(skyp);
+#endif
+}
+
+#ifndef KSTARS_LITE
+bool SkyMapComposite::beginDraw()
+{
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
@@ -269,11 +320,15 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     if (m_skyMesh->inDraw())
     {
         printf("Warning: aborting concurrent SkyMapComposite::draw()\n");
-        return;
+        return false;
     }
 
+    KSProfiler::Stages stages("draw");
+    stages.enter("prepare");
+
     m_skyMesh->inDraw(true);
-    SkyPoint *focus = map->focus();
+    // Same as the sky map focus, unless an offscreen view is being drawn
+    SkyPoint *focus = map->projector()->viewParams().focus;
     m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
 
     // create the no-precess aperture if needed
@@ -290,6 +345,13 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     // info boxes have highest label priority
     // FIXME: REGRESSION. Labeler now know nothing about infoboxes
     // map->infoBoxes()->reserveBoxes( psky );
+    return true;
+}
+
+void SkyMapComposite::drawSky(SkyPainter *skyp)
+{
+    KSProfiler::Stages stages("draw");
+    m_SkyDrawCount++;
 
     // JM 2016-12-01: Why is this done this way?!! It's too inefficient
     if (KStars::Instance())
@@ -308,15 +370,19 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
+    stages.enter("milkyway");
     m_MilkyWay->draw(skyp);
 
     // Draw HIPS after milky way but before everything else
+    stages.enter("hips");
     m_HiPS->draw(skyp);
 
+    stages.enter("grids");
     m_EquatorialCoordinateGrid->draw(skyp);
     m_HorizontalCoordinateGrid->draw(skyp);
     m_LocalMeridianComponent->draw(skyp);
 
+    stages.enter("constellations");
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
@@ -334,23 +400,41 @@ void SkyMapComposite::draw(SkyPainter *skyp)
 
     m_Ecliptic->draw(skyp);
 
+    stages.enter("catalogs");
     m_Catalogs->draw(skyp);
 
+    stages.enter("stars");
     m_Stars->draw(skyp);
+}
 
+void SkyMapComposite::drawSolarSystem(SkyPainter *skyp)
+{
+    KSProfiler::Stages stages("draw");
+    stages.enter("solarsystem");
     m_SolarSystem->drawTrails(skyp);
     m_SolarSystem->draw(skyp);
+}
 
+void SkyMapComposite::drawForeground(SkyPainter *skyp)
+{
+    SkyMap *map      = SkyMap::Instance();
+    KStarsData *data = KStarsData::Instance();
+
+    KSProfiler::Stages stages("draw");
+    stages.enter("satellites");
     m_Satellites->draw(skyp);
 
+    stages.enter("supernovae");
     m_Supernovae->draw(skyp);
 
+    stages.enter("labels");
     map->drawObjectLabels(labelObjects());
 
     m_skyLabeler->drawQueuedLabels();
     m_CNames->draw(skyp);
     m_Stars->drawLabels();
 
+    stages.enter("lists");
     m_ObservingList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
@@ -363,12 +447,14 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_StarHopRouteList->draw(skyp);
 
     // Draw fits overlay before mosaic and terrain/horizon, but after most things.
+    stages.enter("imageoverlay");
     m_ImageOverlay->draw(skyp);
 
 #ifdef HAVE_INDI
     m_Mosaic->draw(skyp);
 #endif
 
+    stages.enter("horizon");
     m_ArtificialHorizon->draw(skyp);
 
     m_Horizon->draw(skyp);
@@ -376,6 +462,7 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_skyMesh->inDraw(false);
 
     // Draw terrain at the end.
+    stages.enter("terrain");
     m_Terrain->draw(skyp);
 
     // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
@@ -398,9 +485,73 @@ void SkyMapComposite::draw(SkyPainter *skyp)
                 p->draw( *psky, NO_PRECESS_BUF );
         }
         */
-#endif
 }
 
+QByteArray SkyMapComposite::skyLayerKey() const
+{
+    const Projector *proj = SkyMap::Instance()->projector();
+    const ViewParams view = proj->viewParams();
+    KStarsData *data      = KStarsData::Instance();
+
+    QByteArray key = viewKey(proj->type(), view, data->updateID());
+    QDataStream stream(&key, QIODevice::Append);
+    stream << SkyMap::IsSlewing() << m_ContentRevision << m_SkyDrawCount << m_Cultures->current()
+           << data->updateNumID();
+
+    // The focus is already part of the projection
+    static const QStringList ignored = { "FocusRA", "FocusDec", "FocusObject", "IsTracking" };
+    static const QList<KConfigSkeletonItem *> options = []()
+    {
+        const QStringList groups = { "View", "Catalogs", "Colors", "HIPS" };
+        QList<KConfigSkeletonItem *> items;
+        for (auto *item : Options::self()->items())
+        {
+            if (groups.contains(item->group()) && !ignored.contains(item->key()))
+                items.append(item);
+        }
+        return items;
+    }();
+    for (const auto *item : options)
+        stream << item->property();
+
+    const ColorScheme *colors = data->colorScheme();
+    for (unsigned int i = 0; i < colors->numberOfColors(); i++)
+        stream << colors->colorAt(i);
+    stream << colors->starColorMode() << colors->starColorIntensity();
+
+    return key;
+}
+
+QByteArray SkyMapComposite::viewKey(int type, const ViewParams &view, unsigned int updateID)
+{
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    stream << type << view.width << view.height << view.zoomFactor << view.rotationAngle.Degrees()
+           << view.useAltAz << view.useRefraction << view.fillGround << view.focus->ra().Degrees()
+           << view.focus->dec().Degrees();
+
+    // In equatorial coordinates the focus keeps its RA and Dec, only its altitude and
+    // azimuth follow the clock, and they only matter to what is drawn from the horizon.
+    if (view.useAltAz || view.fillGround)
+        stream << view.focus->alt().Degrees() << view.focus->az().Degrees();
+
+    // Horizontal coordinates are recomputed with each update ID
+    if (view.useAltAz || view.fillGround || Options::showHorizontalGrid() || Options::showLocalMeridian())
+        stream << updateID;
+
+    return key;
+}
+
+QByteArray SkyMapComposite::solarSystemLayerKey() const
+{
+    QByteArray key = skyLayerKey();
+    QDataStream stream(&key, QIODevice::Append);
+    // The Moon, the fastest body, is updated every minute
+    stream << qint64(std::floor(KStarsData::Instance()->ut().djd() * 1440.0));
+    return key;
+}
+#endif
+
 //Select nearest object to the given skypoint, but give preference
 //to certain object types.
 //we multiply each object type's smallest angular distance by the
@@ -628,6 +779,7 @@ void SkyMapComposite::reloadCLines()
     removeComponent(m_CLines);
     delete m_CLines;
     addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()));
+    contentChanged();
     SkyMapDrawAbstract::setDrawLock(false);
 #endif
 }
@@ -657,6 +809,7 @@ void SkyMapComposite::reloadConstellationArt()
     delete m_ConstellationArt;
     addComponent(m_ConstellationArt =
                      new ConstellationArtComponent(this, m_Cultures.get()));
+    contentChanged();
     SkyMapDrawAbstract::setDrawLock(false);
 #endif
 }
@@ -691,6 +844,7 @@ void SkyMapComposite::reloadDeepSky()
     // includes the observing list. Otherwise, expect a bad, bad crash
     // that is hard to debug! -- AS
     m_Catalogs->dropCache();
+    contentChanged();
     SkyMapDrawAbstract::setDrawLock(false);
 #endif
 }
@@ -705,7 +859,9 @@ void SkyMapComposite::emitProgressText(const QString &message)
     emit progressText(message);
 #ifndef Q_OS_ANDROID
     //Can cause crashes on Android, investigate it
-    qApp->processEvents(); // -jbb: this seemed to make it work.
+    //Components loading on the thread pool have no events to process
+    if (QThread::currentThread() == qApp->thread())
+        qApp->processEvents(); // -jbb: this seemed to make it work.
 #endif
     //qCDebug(KSTARS) << QString("PROGRESS TEXT: %1\n").arg( message );
 }
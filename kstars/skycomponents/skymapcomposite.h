@@ -39,6 +39,7 @@ class KSPlanetBase;
 class MilkyWay;
 class SatellitesComponent;
 class SkyMap;
+class ViewParams;
 class SkyObject;
 class SolarSystemComposite;
 class StarComponent;
@@ -112,6 +113,49 @@ class SkyMapComposite : public QObject, public SkyComposite
              */
         void draw(SkyPainter *skyp) override;
 
+#ifndef KSTARS_LITE
+        /**
+             * @short The parts of draw(), for callers that cache some layers of the sky.
+             * A draw cycle calls beginDraw(), then drawSky() and drawSolarSystem() in this
+             * order unless their layer is cached, then drawForeground().
+             * @return false if a draw cycle is already in progress, the cycle must not go on
+             */
+        bool beginDraw();
+
+        /** @short Draw the milky way, HiPS, grids, constellations, deep sky objects and stars */
+        void drawSky(SkyPainter *skyp);
+
+        /** @short Draw the bodies of the solar system and their trails */
+        void drawSolarSystem(SkyPainter *skyp);
+
+        /** @short Draw what changes on every frame, and the queued labels. Ends the draw cycle. */
+        void drawForeground(SkyPainter *skyp);
+
+        /**
+             * @return the inputs of drawSky() for the current projection. Two cycles with the
+             * same key draw the same sky layer, with the same labels. Only valid after beginDraw().
+             * Each call to drawSky() changes the key, as the stars keep the labels of the last one.
+             */
+        QByteArray skyLayerKey() const;
+
+        /** @return the inputs of drawSky() and drawSolarSystem(), see skyLayerKey() */
+        QByteArray solarSystemLayerKey() const;
+
+        /**
+             * @return the part of skyLayerKey() that depends on the view of projection @p type and on time.
+             * The horizontal coordinates of the focus and @p updateID are only part of the key when the
+             * sky layer moves with them: with horizontal coordinates, the ground, the horizontal grid
+             * or the local meridian. Otherwise the clock ticks do not change the key.
+             */
+        static QByteArray viewKey(int type, const ViewParams &view, unsigned int updateID);
+#endif
+
+        /** @short Invalidate the cached layers, after objects are reloaded or HiPS tiles are received */
+        void contentChanged()
+        {
+            m_ContentRevision++;
+        }
+
         /**
              * @return the object nearest a given point in the sky.
              * @param p The point to find an object near
@@ -310,6 +354,10 @@ class SkyMapComposite : public QObject, public SkyComposite
         std::unique_ptr<SkyLabeler> m_skyLabeler;
 
         KSNumbers m_reindexNum;
+        quint32 m_ContentRevision { 0 };
+#ifndef KSTARS_LITE
+        quint32 m_SkyDrawCount { 0 };
+#endif
 
         QList<DeepStarComponent *> m_DeepStars;
 
@@ -97,6 +97,12 @@ SolarSystemComposite::~SolarSystemComposite()
     delete (m_EarthShadow);
 }
 
+void SolarSystemComposite::finishLoading()
+{
+    m_AsteroidsComponent->finishLoading();
+    m_CometsComponent->finishLoading();
+}
+
 bool SolarSystemComposite::selected()
 {
 #ifndef KSTARS_LITE
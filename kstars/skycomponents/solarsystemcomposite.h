@@ -44,6 +44,12 @@ class SolarSystemComposite : public SkyComposite
     const QList<SkyObject *> &planetObjects() const;
     const QList<SkyObject *> &moons() const;
 
+    /**
+     * @short Wait for the asteroid and comet lists, which are loaded on the thread pool
+     * while the rest of the sky is built. Must be called before the lists are used.
+     */
+    void finishLoading();
+
     bool selected() override;
 
     void update(KSNumbers *num) override;
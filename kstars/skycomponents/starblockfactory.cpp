@@ -8,6 +8,7 @@
 
 #include "starblock.h"
 #include "starobject.h"
+#include "ksprofiler.h"
 
 #include <kstars_debug.h>
 
@@ -49,11 +50,13 @@ std::shared_ptr<StarBlock> StarBlockFactory::getBlock()
         if (freeBlock.get())
         {
             ++nBlocks;
+            KSProfiler::count("starblocks/allocated");
             return freeBlock;
         }
     }
     if (last && (last->drawID != drawID || last->drawID == 0))
     {
+        KSProfiler::count("starblocks/recycled");
         //        qCDebug(KSTARS) << "Recycling block with drawID =" << last->drawID << "and current drawID =" << drawID;
         if (last->parent->block(last->parent->getBlockCount() - 1) != last)
             qCDebug(KSTARS) << "ERROR: Goof up here!";
@@ -75,6 +78,7 @@ std::shared_ptr<StarBlock> StarBlockFactory::getBlock()
     freeBlock.reset(new StarBlock);
     if (freeBlock.get())
         ++nBlocks;
+    KSProfiler::count("starblocks/overflow");
 
     return freeBlock;
 }
@@ -251,13 +251,16 @@ float StarComponent::zoomMagnitudeLimit()
 void StarComponent::draw(SkyPainter *skyp)
 {
 #ifndef KSTARS_LITE
+    // Labels are kept until the next draw, so that they can be drawn again over a cached image of the stars
+    for (auto &list : m_labelList)
+        list->clear();
+
     if (!selected())
         return;
 
-    SkyMap *map           = SkyMap::Instance();
-    const Projector *proj = map->projector();
-    KStarsData *data      = KStarsData::Instance();
-    UpdateID updateID     = data->updateID();
+    SkyMap *map       = SkyMap::Instance();
+    KStarsData *data  = KStarsData::Instance();
+    UpdateID updateID = data->updateID();
 
     bool checkSlewing = (map->isSlewing() && Options::hideOnSlew());
     m_hideLabels      = checkSlewing || !(Options::showStarMagnitudes() || Options::showStarNames());
@@ -308,6 +311,8 @@ void StarComponent::draw(SkyPainter *skyp)
 
     int nTrixels = 0;
 
+    skyp->beginPointSources();
+
     while (region.hasNext())
     {
         ++nTrixels;
@@ -328,14 +333,17 @@ void StarComponent::draw(SkyPainter *skyp)
             if (star->updateID != updateID)
                 star->JITupdate();
 
-            bool drawn = skyp->drawPointSource(star, mag, star->spchar());
+            QPointF pos;
+            bool drawn = skyp->addPointSource(star, mag, star->spchar(), &pos);
 
             //FIXME_SKYPAINTER: find a better way to do this.
             if (drawn && !(m_hideLabels || mag > labelMagLim))
-                addLabel(proj->toScreen(star), star);
+                addLabel(pos, star);
         }
     }
 
+    skyp->flushPointSources();
+
     // Draw focusStar if not null
     if (focusStar)
     {
@@ -387,7 +395,6 @@ void StarComponent::drawLabels()
         {
             labeler->drawNameLabel(item.obj, item.o);
         }
-        list->clear();
     }
 }
 
@@ -26,15 +26,33 @@
 #include "projections/projector.h"
 #include "auxiliary/kspaths.h"
 
+#include "ksrowcursor.h"
+
 #include <QtConcurrent>
 #include <QJsonDocument>
 #include <QJsonValue>
+#include <QThread>
 
 #include <zlib.h>
 #include <fstream>
 #include <stdio.h>
+#include <vector>
 
-#include <csv.h>
+namespace
+{
+/** Columns of the TNS file that are read */
+enum TNSColumn
+{
+    TNS_NAME           = 1,
+    TNS_RA             = 2,
+    TNS_DEC            = 3,
+    TNS_TYPE           = 4,
+    TNS_REDSHIFT       = 5,
+    TNS_HOST_NAME      = 6,
+    TNS_DISCOVERY_MAG  = 18,
+    TNS_DISCOVERY_DATE = 20
+};
+}
 
 const QString SupernovaeComponent::tnsDataFilename("tns_public_objects.csv");
 const QString SupernovaeComponent::tnsDataFilenameZip("tns-daily.csv.gz");
@@ -80,67 +98,60 @@ void SupernovaeComponent::loadData()
 
     auto sFileName = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString(tnsDataFilename));
 
-    try
+    KSRowCursor cursor(sFileName, '#');
+    if (!cursor.IsOpen())
+    {
+        qCCritical(KSTARS) << "could not open file " << sFileName.toLocal8Bit() << "\n";
+        return;
+    }
+    // skip header
+    if (!cursor.ReadHeader())
+    {
+        qCritical() << "file is empty\n";
+        return;
+    }
+
+    // Parts of the file are parsed concurrently, and the supernovae added in file order
+    struct Part
     {
-        io::CSVReader<26, io::trim_chars<' '>, io::double_quote_escape<',', '\"'>,
-        io::ignore_overflow>
-        in(sFileName.toLocal8Bit());
-        // skip header
-        const char *line = in.next_line();
-        if (line == nullptr)
+        KSRowCursor rows;
+        QList<Supernova *> supernovae;
+    };
+    std::vector<Part> parts;
+    for (const auto &rows : cursor.Split(QThread::idealThreadCount()))
+        parts.push_back({ rows, {} });
+
+    QtConcurrent::blockingMap(parts, [](Part & part)
+    {
+        KSRowCursor &rows = part.rows;
+        while (rows.Next())
         {
-            qCritical() << "file is empty\n";
-            return;
+            if (rows.FieldCount() <= TNS_DISCOVERY_DATE)
+                continue;
+
+            const QString discovery_date_s = rows.ToString(TNS_DISCOVERY_DATE);
+            part.supernovae.append(new Supernova(
+                                       rows.ToString(TNS_NAME), dms(rows.ToString(TNS_RA), false),
+                                       dms(rows.ToString(TNS_DEC), true), rows.ToString(TNS_TYPE),
+                                       rows.ToString(TNS_HOST_NAME), discovery_date_s, rows.ToDouble(TNS_REDSHIFT),
+                                       rows.ToDouble(TNS_DISCOVERY_MAG), QDateTime::fromString(discovery_date_s, Qt::ISODate)));
         }
+    });
 
-        std::string id, name, ra_s, dec_s, type;
-        double redshift;
-        std::string host_name;
-        double host_redshift;
-        std::string reporting_group, disc_datasource, classifying_group, assoc_group,
-            disc_internal_name, disc_instrument, classifying_instrument;
-        int tns_at, is_public;
-        std::string end_prop_period;
-        double discovery_mag;
-        std::string discovery_filter, discovery_date_s, sender, remarks,
-            discovery_bibcode, classification_bibcode, ext_catalog;
-
-        while (in.read_row(
-                    id, name, ra_s, dec_s, type, redshift, host_name, host_redshift,
-                    reporting_group, disc_datasource, classifying_group, assoc_group,
-                    disc_internal_name, disc_instrument, classifying_instrument, tns_at,
-                    is_public, end_prop_period, discovery_mag, discovery_filter, discovery_date_s,
-                    sender, remarks, discovery_bibcode, classification_bibcode, ext_catalog))
+    for (const auto &part : parts)
+    {
+        for (Supernova *sup : part.supernovae)
         {
-            auto discovery_date =
-                QDateTime::fromString(discovery_date_s.c_str(), Qt::ISODate);
-            QString qname = QString(name.c_str());
-            dms ra(QString(ra_s.c_str()), false);
-            dms dec(QString(dec_s.c_str()), true);
-
-            Supernova *sup = new Supernova(
-                qname, ra, dec, QString(type.c_str()), QString(host_name.c_str()),
-                QString(discovery_date_s.c_str()), redshift, discovery_mag, discovery_date);
-
-            objectNames(SkyObject::SUPERNOVA).append(QString(name.c_str()));
+            objectNames(SkyObject::SUPERNOVA).append(sup->name());
 
             appendListObject(sup);
             objectLists(SkyObject::SUPERNOVA)
-            .append(QPair<QString, const SkyObject *>(qname, sup));
+            .append(QPair<QString, const SkyObject *>(sup->name(), sup));
         }
-
-        m_DataLoading = false;
-        m_DataLoaded  = true;
-    }
-    catch (io::error::can_not_open_file &ex)
-    {
-        qCCritical(KSTARS) << "could not open file " << sFileName.toLocal8Bit() << "\n";
-        return;
-    }
-    catch (std::exception &ex)
-    {
-        qCCritical(KSTARS) << "unknown exception happened:" << ex.what() << "\n";
     }
+
+    m_DataLoading = false;
+    m_DataLoaded  = true;
 }
 
 SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
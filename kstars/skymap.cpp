@@ -1165,7 +1165,11 @@ void SkyMap::slotZoomDefault()
 
 void SkyMap::setZoomFactor(double factor)
 {
+    const bool zoomIn = factor > Options::zoomFactor();
     Options::setZoomFactor(KSUtils::clamp(factor, MINZOOM, MAXZOOM));
+    // Positions are kept longer at low zoom, bring them within the tolerance of the new zoom
+    if (zoomIn)
+        data->updateTime(data->geo(), false);
     forceUpdate();
     emit zoomChanged();
 }
@@ -302,6 +302,18 @@ class SkyMap : public QGraphicsView
             return m_proj;
         }
 
+        /**
+         * @short Draw the sky components with @p proj instead of the projector of the sky map.
+         * Used to render offscreen views with their own focus, zoom and size. The previous
+         * projector must be swapped back before the sky map is painted or resized again.
+         * @return the projector previously in use
+         */
+        Projector *swapProjector(Projector *proj)
+        {
+            qSwap(m_proj, proj);
+            return proj;
+        }
+
         // NOTE: These dynamic casts must not segfault. If they do, it's good because we know that there is a problem.
         /**
              *@short Proxy method for SkyMapDrawAbstract::exportSkyImage()
@@ -10,6 +10,7 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "ksprofiler.h"
 #include "kstars_debug.h"
 #include <QPainterPath>
 
@@ -60,24 +61,9 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     m_SkyMap->updateInfoBoxes();
     m_SkyMap->setupProjector();
 
-    m_SkyPixmap->fill(Qt::black);
-    m_SkyPainter->setPaintDevice(m_SkyPixmap);
-
-    //FIXME: we may want to move this into the components.
-    m_SkyPainter->begin();
-
-    //Draw all sky elements
-    m_SkyPainter->drawSkyBackground();
-
-    // Set Clipping
     QPainterPath path;
     path.addPolygon(m_SkyMap->projector()->clipPoly());
-    m_SkyPainter->setClipPath(path);
-    m_SkyPainter->setClipping(true);
-
-    m_KStarsData->skyComposite()->draw(m_SkyPainter.data());
-    //Finish up
-    m_SkyPainter->end();
+    drawLayers(path);
 
     QPainter psky2;
     psky2.begin(this);
@@ -96,6 +82,67 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     setDrawLock(false);
 }
 
+void SkyMapQDraw::drawLayers(const QPainterPath &clip)
+{
+    SkyMapComposite *composite = m_KStarsData->skyComposite();
+    SkyLabeler *labeler        = SkyLabeler::Instance();
+
+    KSProfiler::Scope scope("draw");
+    if (!composite->beginDraw())
+        return;
+
+    // The sky layer does not move with time in equatorial coordinates, and the solar
+    // system only moves every minute, so a frame usually redraws the foreground only.
+    // Keys are taken after drawing, as drawing a layer is part of its key.
+    if (composite->skyLayerKey() != m_SkyLayer.key || m_SkyLayer.image.size() != size())
+    {
+        beginLayer(m_SkyLayer, Qt::black);
+        m_SkyPainter->drawSkyBackground();
+        m_SkyPainter->setClipPath(clip);
+        m_SkyPainter->setClipping(true);
+        composite->drawSky(m_SkyPainter.data());
+        m_SkyPainter->end();
+        labeler->checkpoint(&m_SkyLayer.labels);
+        m_SkyLayer.key = composite->skyLayerKey();
+        m_SolarSystemLayer.key.clear();
+    }
+    else
+        labeler->restore(m_SkyLayer.labels);
+
+    if (composite->solarSystemLayerKey() != m_SolarSystemLayer.key || m_SolarSystemLayer.image.size() != size())
+    {
+        beginLayer(m_SolarSystemLayer, Qt::transparent);
+        m_SkyPainter->setClipPath(clip);
+        m_SkyPainter->setClipping(true);
+        composite->drawSolarSystem(m_SkyPainter.data());
+        m_SkyPainter->end();
+        labeler->checkpoint(&m_SolarSystemLayer.labels);
+        m_SolarSystemLayer.key = composite->solarSystemLayerKey();
+    }
+    else
+        labeler->restore(m_SolarSystemLayer.labels);
+
+    m_SkyPainter->setPaintDevice(m_SkyPixmap);
+    m_SkyPainter->begin();
+    m_SkyPainter->drawImage(0, 0, m_SkyLayer.image);
+    m_SkyPainter->drawImage(0, 0, m_SolarSystemLayer.image);
+    m_SkyPainter->setClipPath(clip);
+    m_SkyPainter->setClipping(true);
+    composite->drawForeground(m_SkyPainter.data());
+    m_SkyPainter->end();
+}
+
+void SkyMapQDraw::beginLayer(Layer &layer, const QColor &fill)
+{
+    if (layer.image.size() != size())
+        layer.image = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+    layer.image.fill(fill);
+
+    m_SkyPainter->setPaintDevice(&layer.image);
+    //FIXME: we may want to move this into the components.
+    m_SkyPainter->begin();
+}
+
 void SkyMapQDraw::resizeEvent(QResizeEvent *e)
 {
     Q_UNUSED(e)
@@ -8,7 +8,10 @@
 #define SKYMAPQDRAW_H_
 
 #include "skymapdrawabstract.h"
+#include "skylabeler.h"
 
+#include <QImage>
+#include <QPainterPath>
 #include <QWidget>
 
 /**
@@ -41,6 +44,30 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract
     QPixmap *m_SkyPixmap;
 
     QScopedPointer<SkyQPainter> m_SkyPainter;
+
+  private:
+    /**
+         *@short Retained image of some layers of the sky, with the labels
+         * that were drawn and queued while drawing them.
+         */
+    struct Layer
+    {
+        QImage image;
+        QByteArray key;
+        SkyLabeler::Snapshot labels;
+    };
+
+    /**
+         *@short Draw the sky into m_SkyPixmap, redrawing the cached layers
+         * only when their key changed.
+         */
+    void drawLayers(const QPainterPath &clip);
+
+    /** @short Clear @p layer to @p fill and start painting on it */
+    void beginLayer(Layer &layer, const QColor &fill);
+
+    Layer m_SkyLayer;
+    Layer m_SolarSystemLayer;
 };
 
 #endif
@@ -0,0 +1,229 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ephemeristable.h"
+
+#include "ksnumbers.h"
+#include "ksplanet.h"
+#include "ksutils.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <kstars_debug.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr double MoonStep   = 1.0 / 24.0;
+constexpr double PlanetStep = 0.5;
+/// About 90 MB per body, longer ranges are computed normally
+constexpr int MaxSamples = 1 << 20;
+/// Smallest number of samples computed by one task
+constexpr int MinChunk = 16;
+
+std::shared_ptr<const EphemerisTable> s_Active;
+
+using State = KSPlanetBase::GeocentricState;
+
+struct Field
+{
+    double State::*member;
+    bool angle;
+};
+
+const std::array<Field, 11> fields = { {
+        { &State::ra, true }, { &State::dec, false }, { &State::ra0, true }, { &State::dec0, false },
+        { &State::ecLong, true }, { &State::ecLat, false }, { &State::rsun, false }, { &State::rearth, false },
+        { &State::helEcLong, true }, { &State::helEcLat, false }, { &State::helRsun, false }
+    }
+};
+
+/** @return @p angle shifted by a multiple of 360 degrees to be closest to @p reference */
+double unwrap(double angle, double reference)
+{
+    return reference + KSUtils::reduceAngle(angle - reference, -180.0, 180.0);
+}
+}
+
+std::shared_ptr<const EphemerisTable> EphemerisTable::build(const QList<KSPlanetBase *> &bodies, KSPlanet *earth,
+        long double startJD, long double endJD, double step)
+{
+    auto table = std::make_shared<EphemerisTable>();
+    if (earth == nullptr || step <= 0 || endJD < startJD)
+        return table;
+
+    // The Earth comes first, the geocentric positions of the other bodies are found from it
+    table->tabulate({ earth }, nullptr, nullptr, startJD, endJD, step);
+    const Series earthSeries = table->m_Series.value(earth);
+    if (earthSeries.states.isEmpty())
+        return table;
+
+    QList<KSPlanetBase *> others = bodies;
+    others.removeAll(earth);
+    table->tabulate(others, earth, &earthSeries, startJD, endJD, step);
+    return table;
+}
+
+void EphemerisTable::tabulate(const QList<KSPlanetBase *> &bodies, const KSPlanet *earth, const Series *earthSeries,
+                              long double startJD, long double endJD, double step)
+{
+    // Each task works on its own copies of the bodies, created and deleted here since
+    // some bodies count their instances
+    struct Task
+    {
+        std::unique_ptr<KSPlanetBase> body;
+        std::unique_ptr<KSPlanet> earth;
+        State *states { nullptr };
+        long double startJD { 0 };
+        double step { 0 };
+        int first { 0 };
+        int count { 0 };
+    };
+
+    std::vector<Task> tasks;
+    const int maxTasks = 4 * QThreadPool::globalInstance()->maxThreadCount();
+
+    for (KSPlanetBase *body : bodies)
+    {
+        if (body == nullptr)
+            continue;
+
+        const double bodyStep  = qMin(step, body->type() == SkyObject::MOON ? MoonStep : PlanetStep);
+        const long double size = std::ceil((endJD - startJD) / bodyStep) + 1;
+        if (size > MaxSamples)
+        {
+            qCWarning(KSTARS) << "Time range is too long to tabulate" << body->name();
+            continue;
+        }
+
+        Series &series = m_Series[body];
+        series.startJD = startJD;
+        series.step    = bodyStep;
+        series.states.resize(static_cast<int>(size));
+
+        const int count     = series.states.size();
+        const int chunks    = qBound(1, count / MinChunk, maxTasks);
+        const int chunkSize = (count + chunks - 1) / chunks;
+        for (int first = 0; first < count; first += chunkSize)
+        {
+            Task task;
+            task.body.reset(static_cast<KSPlanetBase *>(body->clone()));
+            if (earth)
+                task.earth.reset(earth->clone());
+            task.states  = series.states.data() + first;
+            task.startJD = startJD;
+            task.step    = bodyStep;
+            task.first   = first;
+            task.count   = qMin(chunkSize, count - first);
+            tasks.push_back(std::move(task));
+        }
+    }
+
+    QtConcurrent::blockingMap(tasks, [earthSeries](Task & task)
+    {
+        for (int i = 0; i < task.count; i++)
+        {
+            const long double jd = task.startJD + static_cast<long double>(task.first + i) * task.step;
+            KSNumbers num(jd);
+
+            if (task.earth)
+            {
+                State earthState;
+                if (earthSeries && interpolate(*earthSeries, jd, &earthState))
+                    task.earth->setGeocentricState(&num, earthState);
+                else
+                    task.earth->findGeocentricState(&num);
+            }
+
+            task.states[i] = task.body->findGeocentricState(&num, task.earth.get());
+        }
+    });
+}
+
+void EphemerisTable::setActive(std::shared_ptr<const EphemerisTable> table)
+{
+    std::atomic_store(&s_Active, std::move(table));
+}
+
+std::shared_ptr<const EphemerisTable> EphemerisTable::active()
+{
+    return std::atomic_load(&s_Active);
+}
+
+bool EphemerisTable::interpolateActive(const KSPlanetBase *body, long double jd, KSPlanetBase::GeocentricState *state)
+{
+    const std::shared_ptr<const EphemerisTable> table = active();
+    return table && table->interpolate(body, jd, state);
+}
+
+bool EphemerisTable::interpolate(const KSPlanetBase *body, long double jd, KSPlanetBase::GeocentricState *state) const
+{
+    auto it = m_Series.constFind(body);
+    return it != m_Series.constEnd() && interpolate(it.value(), jd, state);
+}
+
+bool EphemerisTable::interpolate(const Series &series, long double jd, KSPlanetBase::GeocentricState *state)
+{
+    const int n = series.states.size();
+    if (n == 0 || series.step <= 0)
+        return false;
+
+    // Position of jd in the table, in steps
+    const double t = static_cast<double>((jd - series.startJD) / series.step);
+    if (t < -1e-9 || t > n - 1 + 1e-9)
+        return false;
+    if (n == 1)
+    {
+        *state = series.states[0];
+        return true;
+    }
+
+    const int i  = qBound(0, static_cast<int>(std::floor(t)), n - 2);
+    const int i0 = qMax(i - 1, 0);
+    const int i3 = qMin(i + 2, n - 1);
+    const double u = qBound(0.0, t - i, 1.0);
+
+    // Cubic Hermite basis, with Catmull-Rom tangents clamped at the ends of the table
+    const double u2  = u * u;
+    const double u3  = u2 * u;
+    const double h00 = 2 * u3 - 3 * u2 + 1;
+    const double h10 = u3 - 2 * u2 + u;
+    const double h01 = -2 * u3 + 3 * u2;
+    const double h11 = u3 - u2;
+
+    const State &s0 = series.states[i0];
+    const State &s1 = series.states[i];
+    const State &s2 = series.states[i + 1];
+    const State &s3 = series.states[i3];
+
+    for (const Field &field : fields)
+    {
+        double p0 = s0.*field.member;
+        double p1 = s1.*field.member;
+        double p2 = s2.*field.member;
+        double p3 = s3.*field.member;
+        if (field.angle)
+        {
+            p0 = unwrap(p0, p1);
+            p2 = unwrap(p2, p1);
+            p3 = unwrap(p3, p2);
+        }
+
+        const double m1 = (p2 - p0) / (i + 1 - i0);
+        const double m2 = (p3 - p1) / (i3 - i);
+        double value    = h00 * p1 + h10 * m1 + h01 * p2 + h11 * m2;
+        if (field.angle)
+            value = KSUtils::reduceAngle(value, 0.0, 360.0);
+
+        state->*field.member = value;
+    }
+
+    return true;
+}
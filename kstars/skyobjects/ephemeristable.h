@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "ksplanetbase.h"
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include <memory>
+
+class KSPlanet;
+
+/**
+ * @class EphemerisTable
+ * @short Positions of solar system bodies tabulated over a time range.
+ *
+ * The geocentric state of each body is computed at regular steps on the global thread pool,
+ * and interpolated with cubic Hermite splines in between. While a table is active,
+ * KSPlanetBase::findPosition() interpolates the bodies of the table instead of computing
+ * their position from VSOP87 or the lunar theory, for times within the range of the table.
+ *
+ * Steps are at most an hour for the Moon and half a day for the other bodies, which keeps
+ * the interpolation error under an arcsecond.
+ */
+class EphemerisTable
+{
+    public:
+        /**
+         * @short Tabulate @p bodies between @p startJD and @p endJD.
+         * Returns when all positions are computed. Must be called from the GUI thread.
+         * @param bodies the bodies to tabulate, the Earth is always tabulated
+         * @param earth the Earth of the solar system the bodies belong to
+         * @param startJD first Julian Day of the table
+         * @param endJD last Julian Day of the table
+         * @param step time between the frames that will be drawn, in days. Bodies are never
+         * sampled more often than this.
+         */
+        static std::shared_ptr<const EphemerisTable> build(const QList<KSPlanetBase *> &bodies, KSPlanet *earth,
+                long double startJD, long double endJD, double step);
+
+        /**
+         * @short Make @p table the table used by KSPlanetBase::findPosition().
+         * Pass nullptr to compute positions normally again.
+         */
+        static void setActive(std::shared_ptr<const EphemerisTable> table);
+
+        /** @return the table used by KSPlanetBase::findPosition(), if any */
+        static std::shared_ptr<const EphemerisTable> active();
+
+        /**
+         * @short Interpolate @p body at @p jd in the active table.
+         * @return false if there is no active table, or it does not cover @p body at @p jd
+         */
+        static bool interpolateActive(const KSPlanetBase *body, long double jd, KSPlanetBase::GeocentricState *state);
+
+        /**
+         * @short Interpolate the state of @p body at @p jd.
+         * @return false if the table does not cover @p body at @p jd
+         */
+        bool interpolate(const KSPlanetBase *body, long double jd, KSPlanetBase::GeocentricState *state) const;
+
+        /** @return the number of bodies in the table */
+        int size() const
+        {
+            return m_Series.size();
+        }
+
+    private:
+        struct Series
+        {
+            long double startJD { 0 };
+            double step { 0 };
+            QVector<KSPlanetBase::GeocentricState> states;
+        };
+
+        /**
+         * @short Add the series of @p bodies to the table, computed on the global thread pool.
+         * Positions are geocentric if @p earth is set, using the Earth positions of @p earthSeries.
+         */
+        void tabulate(const QList<KSPlanetBase *> &bodies, const KSPlanet *earth, const Series *earthSeries,
+                      long double startJD, long double endJD, double step);
+
+        static bool interpolate(const Series &series, long double jd, KSPlanetBase::GeocentricState *state);
+
+        /// Indexed by the bodies of the sky composite, copies of the bodies are never interpolated
+        QHash<const KSPlanetBase *, Series> m_Series;
+};
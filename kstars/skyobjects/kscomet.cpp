@@ -349,6 +349,30 @@ bool KSComet::loadData()
     return false;
 }
 
+QDataStream &operator<<(QDataStream &out, const KSComet &comet)
+{
+    out << comet.name() << comet.OrbitClass << comet.q << comet.e << comet.i << comet.w
+        << comet.N << static_cast<double>(comet.JDp) << comet.M1 << comet.M2
+        << comet.K1 << comet.K2;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, KSComet *&comet)
+{
+    QString name, orbit_class;
+    double q, e, JDp;
+    dms i, w, N;
+    float M1, M2, K1, K2;
+
+    in >> name >> orbit_class >> q >> e >> i >> w >> N >> JDp >> M1 >> M2 >> K1 >> K2;
+
+    comet = new KSComet(name, QString(), q, e, i, w, N, JDp, M1, M2, K1, K2);
+    comet->setOrbitClass(orbit_class);
+    comet->setAngularSize(0.005);
+
+    return in;
+}
+
 SkyObject::UID KSComet::getUID() const
 {
     return solarsysUID(UID_SOL_COMET) | uidPart;
@@ -118,7 +118,7 @@ class KSEarthShadow : public KSPlanetBase
         {
             return true;
         }
-        void findPhase() override {}
+        void findPhase(const KSPlanetBase *) override {}
 
     private:
         double m_umbra_ang { 0 }; // Radius!
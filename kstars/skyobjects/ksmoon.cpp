@@ -17,8 +17,10 @@
 #include "skycomponents/solarsystemcomposite.h"
 #include "texturemanager.h"
 
+#include <QCoreApplication>
 #include <QFile>
 #include <QTextStream>
+#include <QThread>
 
 #include <cstdlib>
 #include <cmath>
@@ -246,7 +248,7 @@ void KSMoon::findMagnitude(const KSNumbers *)
 
     if (std::isnan(phd)) // Avoid nanny phases.
     {
-        findPhase(nullptr);
+        findPhase();
         phd = phase().Degrees();
         if (std::isnan(phd))
             return;
@@ -276,13 +278,32 @@ void KSMoon::findPhase(const KSSun *Sun)
 
     Q_ASSERT(Sun != nullptr);
 
+    setPhaseFromSun(Sun->ecLong());
+}
+
+void KSMoon::findPhase(const KSPlanetBase *Earth)
+{
+    if (Earth == nullptr)
+    {
+        KSPlanetBase::findPhase(Earth);
+        return;
+    }
+
+    // The light time of the Sun, about 20 arcseconds, is negligible for the phase
+    setPhaseFromSun((Earth->ecLong() + dms(180.0)).reduce());
+}
+
+void KSMoon::setPhaseFromSun(const dms &sunLongitude)
+{
     // This is an approximation justified by the small Earth-Moon distance in relation
     // to the great Earth-Sun distance
-    Phase           = (ecLong() - Sun->ecLong()).Degrees(); // Phase is obviously in degrees
+    Phase           = (ecLong() - sunLongitude).Degrees(); // Phase is obviously in degrees
     double DegPhase = dms(Phase).reduce().Degrees();
     iPhase          = int(0.1 * DegPhase + 0.5) % 36; // iPhase must be in [0,36) range
 
-    m_image = TextureManager::getImage(QString("moon%1").arg(iPhase, 2, 10, QChar('0')));
+    // The texture cache is not thread safe, copies of the Moon used on worker threads are not drawn
+    if (QThread::currentThread() == qApp->thread())
+        m_image = TextureManager::getImage(QString("moon%1").arg(iPhase, 2, 10, QChar('0')));
 }
 
 QString KSMoon::phaseName() const
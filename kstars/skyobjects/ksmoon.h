@@ -25,8 +25,6 @@ class KSSun;
 class KSMoon : public KSPlanetBase
 {
   public:
-    using KSPlanetBase::findPhase;
-
     /** Default constructor. Set name="Moon". */
     KSMoon();
     /** Copy constructor */
@@ -41,10 +39,17 @@ class KSMoon : public KSPlanetBase
      * Determine the phase angle of the moon, and assign the appropriate moon image
      * @param Sun a KSSun pointer with coordinates updated to the time of computation.
      * If not supplied, the sun is retrieved via KStarsData
-     * @note Overrides KSPlanetBase::findPhase()
      */
     void findPhase(const KSSun *Sun = nullptr);
 
+    /**
+     * Determine the phase angle of the moon from the Earth, as findPosition() does.
+     * @param Earth the Earth at the time of computation, the Sun is seen opposite to its heliocentric
+     * longitude. If nullptr, the phase is left to KSPlanetBase::findPhase().
+     * @note Call findPhase() without argument for the Sun of KStarsData, a null pointer is ambiguous
+     */
+    void findPhase(const KSPlanetBase *Earth) override;
+
     /** @return the illuminated fraction of the Moon as seen from Earth */
     double illum() const { return 0.5 * (1.0 - cos(Phase * dms::PI / 180.0)); }
 
@@ -119,6 +124,9 @@ class KSMoon : public KSPlanetBase
         double Bi { 0 };
     };
 
+    /** Set the phase from the geocentric ecliptic longitude of the Sun, and the matching image */
+    void setPhaseFromSun(const dms &sunLongitude);
+
     static QList<MoonBData> BData;
     unsigned int iPhase { 0 };
     KSSun *defaultSun=nullptr;
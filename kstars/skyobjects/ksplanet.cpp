@@ -9,6 +9,7 @@
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "ksfilereader.h"
+#include "vsopcache.h"
 
 #include <cmath>
 #include <typeinfo>
@@ -60,9 +61,13 @@ bool KSPlanet::OrbitDataManager::loadData(KSPlanet::OrbitDataColl &odc, const QS
     int nCount = 0;
     QString nl = n.toLower();
 
-    if (hash.contains(nl))
+    // Planets may be computed from several threads
+    QMutexLocker locker(&mutex);
+
+    auto it = hash.constFind(nl);
+    if (it != hash.constEnd())
     {
-        odc = hash[nl];
+        odc = it.value();
         return true; //orbit data already loaded
     }
 
@@ -189,7 +194,7 @@ bool KSPlanet::loadData()
     return odm.loadData(odc, untranslatedName());
 }
 
-void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+bool KSPlanet::calcVSOP(double Tau, double *lbr) const
 {
     double sum[6];
     OrbitDataColl odc;
@@ -202,13 +207,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
     }
 
     if (!odm.loadData(odc, untranslatedName()))
-    {
-        epret.longitude = dms(0.0);
-        epret.latitude  = dms(0.0);
-        epret.radius    = 0.0;
-        qCWarning(KSTARS) << "Could not get data for name:" << name() << "(" << untranslatedName() << ")";
-        return;
-    }
+        return false;
 
     //Ecliptic Longitude
     for (int i = 0; i < 6; ++i)
@@ -227,8 +226,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         //qDebug() << Q_FUNC_INFO << name() << " : sum[" << i << "] = " << sum[i];
     }
 
-    epret.longitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
-    epret.longitude.setD(epret.longitude.reduce().Degrees());
+    lbr[0] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
 
     //Compute Ecliptic Latitude
     for (uint i = 0; i < 6; ++i)
@@ -241,7 +239,7 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         sum[i] *= Tpow[i];
     }
 
-    epret.latitude.setRadians(sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5]);
+    lbr[1] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
 
     //Compute Heliocentric Distance
     for (uint i = 0; i < 6; ++i)
@@ -254,7 +252,26 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         sum[i] *= Tpow[i];
     }
 
-    epret.radius = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
+    lbr[2] = sum[0] + sum[1] + sum[2] + sum[3] + sum[4] + sum[5];
+    return true;
+}
+
+void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+{
+    double lbr[3];
+    if (!VSOPCache::Instance()->evaluate(this, Tau, lbr) && !calcVSOP(Tau, lbr))
+    {
+        epret.longitude = dms(0.0);
+        epret.latitude  = dms(0.0);
+        epret.radius    = 0.0;
+        qCWarning(KSTARS) << "Could not get data for name:" << name() << "(" << untranslatedName() << ")";
+        return;
+    }
+
+    epret.longitude.setRadians(lbr[0]);
+    epret.longitude.setD(epret.longitude.reduce().Degrees());
+    epret.latitude.setRadians(lbr[1]);
+    epret.radius = lbr[2];
 
     /*
     qDebug() << Q_FUNC_INFO << name() << " pre: Lat = " << epret.latitude.toDMSString() << " Long = " <<
@@ -9,6 +9,7 @@
 #include "ksplanetbase.h"
 
 #include <QHash>
+#include <QMutex>
 #include <QString>
 #include <QVector>
 
@@ -68,11 +69,21 @@ class KSPlanet : public KSPlanetBase
      * Calculate the ecliptic longitude and latitude of the planet for
      * the given date (expressed in Julian Millenia since J2000).  A reference
      * to the ecliptic coordinates is returned as the second object.
+     * Served from the Chebyshev approximations of VSOPCache when available.
      * @param jm Julian Millenia (=jd/1000)
      * @param ret The ecliptic coordinates are returned by reference through this argument.
      */
     virtual void calcEcliptic(double jm, EclipticPosition &ret) const;
 
+    /**
+     * Sum the VSOP87 series of the planet for the given date.
+     * @param jm Julian Millenia since J2000
+     * @param lbr set to the heliocentric ecliptic longitude (not reduced) and latitude
+     * in radians, and the distance in AU
+     * @return false if the series of the planet could not be loaded
+     */
+    bool calcVSOP(double jm, double *lbr) const;
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Planet.
@@ -164,6 +175,7 @@ class KSPlanet : public KSPlanetBase
         bool readOrbitData(const QString &fname, QVector<KSPlanet::OrbitData> *vector);
 
         QHash<QString, OrbitDataColl> hash;
+        QMutex mutex;
     };
 
   private:
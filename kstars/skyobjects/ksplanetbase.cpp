@@ -6,6 +6,7 @@
 
 #include "ksplanetbase.h"
 
+#include "ephemeristable.h"
 #include "ksnumbers.h"
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -102,7 +103,7 @@ void KSPlanetBase::updateCoords(const KSNumbers *num, bool includePlanets, const
     }
     else
     {
-        findGeocentricPosition(num, kd->skyComposite()->earth());
+        updateGeocentricPosition(num, kd->skyComposite()->earth());
     }
 }
 
@@ -112,8 +113,9 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
 
     lastPrecessJD = num->julianDay();
 
-    findGeocentricPosition(num, Earth); //private function, reimplemented in each subclass
-    findPhase();
+    updateGeocentricPosition(num, Earth);
+    // Positions may be computed off the main thread, so do not read the shared Earth when given one
+    findPhase(Earth);
     setAngularSize(findAngularSize()); //angular size in arcmin
 
     if (lat && LST)
@@ -141,6 +143,52 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
     }
 }
 
+void KSPlanetBase::updateGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
+{
+    GeocentricState state;
+    if (EphemerisTable::interpolateActive(this, num->julianDay(), &state))
+        setGeocentricState(num, state);
+    else
+        findGeocentricPosition(num, Earth); //private function, reimplemented in each subclass
+}
+
+KSPlanetBase::GeocentricState KSPlanetBase::findGeocentricState(const KSNumbers *num, const KSPlanetBase *Earth)
+{
+    lastPrecessJD = num->julianDay();
+    findGeocentricPosition(num, Earth);
+
+    GeocentricState state;
+    state.ra        = ra().Degrees();
+    state.dec       = dec().Degrees();
+    state.ra0       = ra0().Degrees();
+    state.dec0      = dec0().Degrees();
+    state.ecLong    = ep.longitude.Degrees();
+    state.ecLat     = ep.latitude.Degrees();
+    state.rsun      = ep.radius;
+    state.rearth    = Rearth;
+    state.helEcLong = helEcPos.longitude.Degrees();
+    state.helEcLat  = helEcPos.latitude.Degrees();
+    state.helRsun   = helEcPos.radius;
+    return state;
+}
+
+void KSPlanetBase::setGeocentricState(const KSNumbers *num, const GeocentricState &state)
+{
+    setRA(CachingDms(state.ra));
+    setDec(dms(state.dec));
+    setRA0(dms(state.ra0));
+    setDec0(dms(state.dec0));
+    ep.longitude.setD(state.ecLong);
+    ep.latitude.setD(state.ecLat);
+    ep.radius = state.rsun;
+    Rearth    = state.rearth;
+    helEcPos.longitude.setD(state.helEcLong);
+    helEcPos.latitude.setD(state.helEcLat);
+    helEcPos.radius = state.helRsun;
+
+    findPA(num);
+}
+
 bool KSPlanetBase::isMajorPlanet() const
 {
     if (name() == i18n("Mercury") || name() == i18n("Venus") || name() == i18n("Mars") || name() == i18n("Jupiter") ||
@@ -279,15 +327,18 @@ double KSPlanetBase::labelOffset() const
     return 0.5 * size + 4.;
 }
 
-void KSPlanetBase::findPhase()
+void KSPlanetBase::findPhase(const KSPlanetBase *Earth)
 {
-    if (2 * rsun()*rearth() == 0)
+    // Bodies without distances have no phase, such as the Earth whose distance from the Earth is NaN
+    if (!(rsun() * rearth() > 0))
     {
         Phase = std::numeric_limits<double>::quiet_NaN();
         return;
     }
     /* Compute the phase of the planet in degrees */
-    double earthSun = KStarsData::Instance()->skyComposite()->earth()->rsun();
+    if (Earth == nullptr)
+        Earth = KStarsData::Instance()->skyComposite()->earth();
+    double earthSun = Earth->rsun();
     double cosPhase = (rsun() * rsun() + rearth() * rearth() - earthSun * earthSun) / (2 * rsun() * rearth());
 
     Phase           = acos(cosPhase) * 180.0 / dms::PI;
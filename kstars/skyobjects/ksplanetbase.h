@@ -171,6 +171,43 @@ class KSPlanetBase : public TrailObject
     void findPosition(const KSNumbers *num, const CachingDms *lat = nullptr, const CachingDms *LST = nullptr,
                       const KSPlanetBase *Earth = nullptr);
 
+    /**
+     * @struct GeocentricState
+     * @short The coordinates set by findGeocentricPosition(), angles in degrees.
+     * Used to tabulate and interpolate positions, see EphemerisTable.
+     */
+    struct GeocentricState
+    {
+        double ra { 0 };
+        double dec { 0 };
+        double ra0 { 0 };
+        double dec0 { 0 };
+        double ecLong { 0 };
+        double ecLat { 0 };
+        double rsun { 0 };
+        double rearth { 0 };
+        double helEcLong { 0 };
+        double helEcLat { 0 };
+        double helRsun { 0 };
+    };
+
+    /**
+     * @short Compute the geocentric position of the body for @p num.
+     * Unlike findPosition(), this never uses a tabulated position. It may be called from
+     * a worker thread on a clone of the body.
+     * @param num KSNumbers pointer for the target date/time
+     * @param Earth pointer to the Earth (not used for the Moon)
+     * @return the geocentric coordinates of the body
+     */
+    GeocentricState findGeocentricState(const KSNumbers *num, const KSPlanetBase *Earth = nullptr);
+
+    /**
+     * @short Set the geocentric position of the body, as computed by findGeocentricState().
+     * @param num KSNumbers pointer for the date/time of @p state
+     * @param state the geocentric coordinates of the body
+     */
+    void setGeocentricState(const KSNumbers *num, const GeocentricState &state);
+
     /** @return the Planet's position angle. */
     double pa() const override { return PositionAngle; }
 
@@ -246,8 +283,11 @@ class KSPlanetBase : public TrailObject
      */
     void findPA(const KSNumbers *num);
 
-    /** Determine the phase of the planet. */
-    virtual void findPhase();
+    /**
+     * Determine the phase of the planet.
+     * @param Earth Earth at the same time, or nullptr to use the Earth of the sky composite
+     */
+    virtual void findPhase(const KSPlanetBase *Earth = nullptr);
 
     virtual double findAngularSize() { return  asin(physicalSize() / Rearth / AU_KM) * 60. * 180. / dms::PI; }
     // Geocentric ecliptic position, but distance to the Sun
@@ -261,6 +301,12 @@ class KSPlanetBase : public TrailObject
     QImage m_image;
 
   private:
+    /**
+     * @short find the geocentric coordinates, from the active EphemerisTable if it has this body,
+     * otherwise with findGeocentricPosition().
+     */
+    void updateGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth);
+
     /**
      * @short correct the position for the fact that the location is not at the center of the Earth,
      * but a position on its surface.  This causes a small parallactic shift in a solar system
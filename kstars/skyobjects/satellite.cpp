@@ -6,6 +6,7 @@
 
 #include "satellite.h"
 
+#include "geolocation.h"
 #include "ksplanetbase.h"
 #ifndef KSTARS_LITE
 #include "kspopupmenu.h"
@@ -703,30 +704,98 @@ void Satellite::init()
     }
 }
 
-int Satellite::updatePos()
+Satellite::Environment Satellite::environment(double jd, GeoLocation *geo)
 {
-    KStarsData *data = KStarsData::Instance();
-    return sgp4((data->clock()->utc().djd() - m_tle_jd) * MINPD);
+    Environment env;
+    double thetageo, c, sq, achcp;
+
+    env.jd  = jd;
+    env.lat = *geo->lat();
+
+    // Observer ECI position
+    thetageo     = geo->LMST(jd);
+    env.lst      = dms(thetageo / DEG2RAD);
+    env.sinlat   = sin(geo->lat()->radians());
+    env.coslat   = cos(geo->lat()->radians());
+    env.sintheta = sin(thetageo);
+    env.costheta = cos(thetageo);
+    c            = 1.0 / sqrt(1.0 + F * (F - 2.0) * env.sinlat * env.sinlat);
+    sq           = (1.0 - F) * (1.0 - F) * c;
+    achcp        = (RADIUSEARTHKM * c + MEANALT) * env.coslat;
+    env.obs_posx = achcp * env.costheta;
+    env.obs_posy = achcp * env.sintheta;
+    env.obs_posz = (RADIUSEARTHKM * sq + MEANALT) * env.sinlat;
+    env.obs_posw = sqrt(env.obs_posx * env.obs_posx + env.obs_posy * env.obs_posy + env.obs_posz * env.obs_posz);
+
+    // Find ECI coordinates of the sun
+    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+
+    mjd  = jd - 2415020.0;
+    year = 1900.0 + mjd / 365.25;
+    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
+    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
+    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
+    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
+    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
+                      0.000293 * sin(3 * M));
+    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
+    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
+    nu   = Modulus(M + C, TWOPI);
+    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
+    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
+    R    = AU * R;
+
+    env.sun_posx = R * cos(Lsa);
+    env.sun_posy = R * sin(Lsa) * cos(eps);
+    env.sun_posz = R * sin(Lsa) * sin(eps);
+    env.sun_posw = R;
+
+    // Topocentric sun elevation, the observer offset is negligible at solar distance
+    double sun_top_z = env.coslat * env.costheta * env.sun_posx + env.coslat * env.sintheta * env.sun_posy +
+                       env.sinlat * env.sun_posz;
+    env.sun_alt = arcSin(sun_top_z / env.sun_posw) / DEG2RAD;
+
+    return env;
 }
 
-int Satellite::sgp4(double tsince)
+Satellite::Environment Satellite::currentEnvironment()
 {
     KStarsData *data = KStarsData::Instance();
 
+    Environment env = environment(data->clock()->utc().djd(), data->geo());
+
+    // Keep the same sidereal time and sun position as the rest of the sky map
+    env.lst = *data->lst();
+    KSSun *sun = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
+    if (sun)
+        env.sun_alt = sun->alt().Degrees();
+
+    return env;
+}
+
+int Satellite::updatePos()
+{
+    return updatePos(currentEnvironment());
+}
+
+int Satellite::updatePos(const Environment &env)
+{
+    return sgp4((env.jd - m_tle_jd) * MINPD, env);
+}
+
+int Satellite::sgp4(double tsince, const Environment &env)
+{
     int ktr;
     double am, axnl, aynl, betal, cosim, cnod, cos2u, coseo1 = 0, cosi, cosip, cosisq, cossu, cosu, delm, delomg, em,
                                                       ecose, el2, eo1, ep, esine, argpm, argpp, argpdf, pl,
                                                       mrt = 0.0, mvt, rdotl, rl, rvdot, rvdotl, sinim, dndt, sin2u, sineo1 = 0, sini, sinip, sinsu, sinu, snod, su, t2,
                                                       t3, t4, tem5, temp, temp1, temp2, tempa, tempe, templ, u, ux, uy, uz, vx, vy, vz, inclm, mm, nm, nodem, xinc,
                                                       xincp, xl, xlm, mp, xmdf, xmx, xmy, nodedf, xnode, nodep, tc, sat_posx, sat_posy, sat_posz, sat_posw, sat_velx,
-                                                      sat_vely, sat_velz, sinlat, obs_posx, obs_posy, obs_posz, obs_posw, /*obs_velx, obs_vely, obs_velz,*/
-                                                      coslat, thetageo, sintheta, costheta, c, sq, achcp, vkmpersec;
+                                                      sat_vely, sat_velz, /*obs_velx, obs_vely, obs_velz,*/ vkmpersec;
     //    double emsq;
 
     const double temp4 = 1.5e-12;
 
-    double jul_utc = data->clock()->utc().djd();
-
     vkmpersec = RADIUSEARTHKM * XKE / 60.0;
 
     // Update for secular gravity and atmospheric drag
@@ -1135,37 +1204,25 @@ int Satellite::sgp4(double tsince)
         return (6);
     }
 
-    // Observer ECI position and velocity
-    sinlat   = sin(data->geo()->lat()->radians());
-    coslat   = cos(data->geo()->lat()->radians());
-    thetageo = data->geo()->LMST(jul_utc);
-    sintheta = sin(thetageo);
-    costheta = cos(thetageo);
-    c        = 1.0 / sqrt(1.0 + F * (F - 2.0) * sinlat * sinlat);
-    sq       = (1.0 - F) * (1.0 - F) * c;
-    achcp    = (RADIUSEARTHKM * c + MEANALT) * coslat;
-    obs_posx = achcp * costheta;
-    obs_posy = achcp * sintheta;
-    obs_posz = (RADIUSEARTHKM * sq + MEANALT) * sinlat;
-    obs_posw = sqrt(obs_posx * obs_posx + obs_posy * sat_posy + obs_posz * obs_posz);
-    /*obs_velx = -MFACTOR * obs_posy;
-    obs_vely = MFACTOR * obs_posx;
+    // Observer ECI position and velocity are shared by all satellites, see environment()
+    /*obs_velx = -MFACTOR * env.obs_posy;
+    obs_vely = MFACTOR * env.obs_posx;
     obs_velz = 0.;*/
 
-    m_altitude = sat_posw - obs_posw + MEANALT;
+    m_altitude = sat_posw - env.obs_posw + MEANALT;
 
     // Az and Dec
-    double range_posx = sat_posx - obs_posx;
-    double range_posy = sat_posy - obs_posy;
-    double range_posz = sat_posz - obs_posz;
+    double range_posx = sat_posx - env.obs_posx;
+    double range_posy = sat_posy - env.obs_posy;
+    double range_posz = sat_posz - env.obs_posz;
     m_range           = sqrt(range_posx * range_posx + range_posy * range_posy + range_posz * range_posz);
     //     double range_velx = sat_velx - obs_velx;
     //     double range_vely = sat_velx - obs_vely;
     //     double range_velz = sat_velx - obs_velz;
 
-    double top_s = sinlat * costheta * range_posx + sinlat * sintheta * range_posy - coslat * range_posz;
-    double top_e = -sintheta * range_posx + costheta * range_posy;
-    double top_z = coslat * costheta * range_posx + coslat * sintheta * range_posy + sinlat * range_posz;
+    double top_s = env.sinlat * env.costheta * range_posx + env.sinlat * env.sintheta * range_posy - env.coslat * range_posz;
+    double top_e = -env.sintheta * range_posx + env.costheta * range_posy;
+    double top_z = env.coslat * env.costheta * range_posx + env.coslat * env.sintheta * range_posy + env.sinlat * range_posz;
 
     double azimuth = atan(-top_e / top_s);
     if (top_s > 0.)
@@ -1179,52 +1236,28 @@ int Satellite::sgp4(double tsince)
 
     setAz(azimuth / DEG2RAD);
     setAlt(elevation / DEG2RAD);
-    HorizontalToEquatorial(data->lst(), data->geo()->lat());
+    HorizontalToEquatorial(&env.lst, &env.lat);
 
     // is the satellite visible ?
-    // Find ECI coordinates of the sun
-    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
-
-    mjd  = jul_utc - 2415020.0;
-    year = 1900.0 + mjd / 365.25;
-    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
-    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
-    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
-    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
-    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
-                      0.000293 * sin(3 * M));
-    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
-    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
-    nu   = Modulus(M + C, TWOPI);
-    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
-    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
-    R    = AU * R;
-
-    double sun_posx = R * cos(Lsa);
-    double sun_posy = R * sin(Lsa) * cos(eps);
-    double sun_posz = R * sin(Lsa) * sin(eps);
-    double sun_posw = R;
-
     // Calculates satellite's eclipse status and depth
     double sd_sun, sd_earth, delta, depth;
 
     // Determine partial eclipse
     sd_earth       = arcSin(RADIUSEARTHKM / sat_posw);
-    double rho_x   = sun_posx - sat_posx;
-    double rho_y   = sun_posy - sat_posy;
-    double rho_z   = sun_posz - sat_posz;
+    double rho_x   = env.sun_posx - sat_posx;
+    double rho_y   = env.sun_posy - sat_posy;
+    double rho_z   = env.sun_posz - sat_posz;
     double rho_w   = sqrt(rho_x * rho_x + rho_y * rho_y + rho_z * rho_z);
     sd_sun         = arcSin(SR / rho_w);
     double earth_x = -1.0 * sat_posx;
     double earth_y = -1.0 * sat_posy;
     double earth_z = -1.0 * sat_posz;
     double earth_w = sat_posw;
-    delta      = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
+    delta      = PIO2 - arcSin((env.sun_posx * earth_x + env.sun_posy * earth_y + env.sun_posz * earth_z) / (env.sun_posw * earth_w));
     depth      = sd_earth - sd_sun - delta;
-    KSSun *sun = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
 
     m_is_eclipsed = sd_earth >= sd_sun && depth >= 0;
-    m_is_visible  = !m_is_eclipsed && sun->alt().Degrees() <= -12.0 && elevation >= 0.0;
+    m_is_visible  = !m_is_eclipsed && env.sun_alt <= -12.0 && elevation >= 0.0;
 
     return (0);
 }
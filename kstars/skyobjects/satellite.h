@@ -10,6 +10,7 @@
 
 #include <QString>
 
+class GeoLocation;
 class KSPopupMenu;
 
 /**
@@ -34,9 +35,48 @@ class Satellite : public SkyObject
         /** @short Destructor */
         virtual ~Satellite() override = default;
 
+        /**
+         * @struct Satellite::Environment
+         * Observer and time dependent terms needed by the SGP4 propagation.
+         * They are the same for every satellite at a given instant, so a group
+         * computes them once and shares them with all its satellites.
+         */
+        struct Environment
+        {
+            /// Julian date (UTC)
+            double jd { 0 };
+            /// Local sidereal time
+            dms lst;
+            /// Observer latitude
+            dms lat;
+            double sinlat { 0 }, coslat { 0 }, sintheta { 0 }, costheta { 0 };
+            /// Observer ECI position [km]
+            double obs_posx { 0 }, obs_posy { 0 }, obs_posz { 0 }, obs_posw { 0 };
+            /// Sun ECI position [km]
+            double sun_posx { 0 }, sun_posy { 0 }, sun_posz { 0 }, sun_posw { 0 };
+            /// Sun altitude [degrees]
+            double sun_alt { 0 };
+        };
+
+        /**
+         * @short Compute the shared propagation terms for an arbitrary instant and observer.
+         * @param jd Julian date (UTC)
+         * @param geo observer location
+         */
+        static Environment environment(double jd, GeoLocation *geo);
+
+        /** @return the shared propagation terms for the current simulation time and location */
+        static Environment currentEnvironment();
+
         /** @short Update satellite position */
         int updatePos();
 
+        /**
+         * @short Update satellite position using precomputed shared terms
+         * @note Only touches this satellite, so different satellites can be updated concurrently.
+         */
+        int updatePos(const Environment &env);
+
         /**
          * @return True if the satellite is visible (above horizon, in the sunlight and sun at least 12° under horizon)
          */
@@ -77,10 +117,10 @@ class Satellite : public SkyObject
         void init();
 
         /** @short Compute satellite position */
-        int sgp4(double tsince);
+        int sgp4(double tsince, const Environment &env);
 
         /** @return Arcsine of the argument */
-        double arcSin(double arg);
+        static double arcSin(double arg);
 
         /**
          * Provides the difference between UT (approximately the same as UTC)
@@ -88,10 +128,10 @@ class Satellite : public SkyObject
          * This function is based on a least squares fit of data from 1950
          * to 1991 and will need to be updated periodically.
          */
-        double deltaET(double year);
+        static double deltaET(double year);
 
         /** @return arg1 mod arg2 */
-        double Modulus(double arg1, double arg2);
+        static double Modulus(double arg1, double arg2);
 
         // TLE
         /// Satellite Number
@@ -11,6 +11,9 @@
 #include "skyobjects/satellite.h"
 
 #include <QTextStream>
+#include <QtConcurrent>
+
+#include <numeric>
 
 SatelliteGroup::SatelliteGroup(const QString& name, const QString& tle_filename, const QUrl& update_url)
 {
@@ -51,19 +54,48 @@ void SatelliteGroup::readTLE()
 
 void SatelliteGroup::updateSatellitesPos()
 {
-    QMutableListIterator<Satellite *> sats(*this);
+    updateSatellitesPos(Satellite::currentEnvironment());
+}
 
-    while (sats.hasNext())
+void SatelliteGroup::updateSatellitesPos(const Satellite::Environment &env)
+{
+    QVector<Satellite *> selectedSats;
+    for (Satellite *sat : *this)
     {
-        Satellite *sat = sats.next();
-
         if (sat->selected())
-        {
-            int rc = sat->updatePos();
-            // If position cannot be calculated, remove it from list
-            if (rc != 0)
-                sats.remove();
-        }
+            selectedSats.append(sat);
+    }
+
+    if (selectedSats.isEmpty())
+        return;
+
+    // Each satellite only touches its own state, so propagate them concurrently.
+    // Small groups are not worth the thread pool overhead.
+    QVector<int> rc(selectedSats.size(), 0);
+    int *results           = rc.data();
+    Satellite *const *sats = selectedSats.constData();
+    auto propagate = [results, sats, &env](int i)
+    {
+        results[i] = sats[i]->updatePos(env);
+    };
+
+    if (selectedSats.size() < PARALLEL_THRESHOLD)
+    {
+        for (int i = 0; i < selectedSats.size(); i++)
+            propagate(i);
+    }
+    else
+    {
+        QVector<int> indexes(selectedSats.size());
+        std::iota(indexes.begin(), indexes.end(), 0);
+        QtConcurrent::blockingMap(indexes, propagate);
+    }
+
+    // If position cannot be calculated, remove it from list
+    for (int i = 0; i < selectedSats.size(); i++)
+    {
+        if (rc[i] != 0)
+            removeOne(selectedSats[i]);
     }
 }
 
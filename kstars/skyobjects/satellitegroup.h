@@ -6,11 +6,11 @@
 
 #pragma once
 
+#include "satellite.h"
+
 #include <QString>
 #include <QUrl>
 
-class Satellite;
-
 /**
  * @class SatelliteGroup
  * Represents a group of artificial satellites.
@@ -37,6 +37,12 @@ class SatelliteGroup : public QList<Satellite *>
      */
     void updateSatellitesPos();
 
+    /**
+     * Compute the position of each selected satellite in the group for the instant described by @p env.
+     * Large groups are propagated on the global thread pool.
+     */
+    void updateSatellitesPos(const Satellite::Environment &env);
+
     /**
      * @return TLE filename
      */
@@ -53,6 +59,9 @@ class SatelliteGroup : public QList<Satellite *>
     QString name();
 
   private:
+    /// Minimum number of selected satellites before propagation is spread over threads
+    static constexpr int PARALLEL_THRESHOLD = 64;
+
     /// Group name
     QString m_name;
     /// TLE filename
@@ -0,0 +1,277 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "vsopcache.h"
+
+#include "ksplanet.h"
+#include "kspaths.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <kstars_debug.h>
+
+#include <cmath>
+
+namespace
+{
+constexpr double BlockDays        = 4096;
+constexpr double DaysPerMillenium = 365250.0;
+/// Number of coefficients of each polynomial
+constexpr int Degree = 14;
+constexpr double Tolerance = 1e-9;
+/// Blocks kept in memory, about 10 MB at most
+constexpr int MaxBlocks = 256;
+
+constexpr quint32 Magic   = 0x4b534356; // KSCV
+constexpr quint32 Version = 1;
+
+/** @return the initial segment length for @p planet, in days */
+double segmentDays(const QString &planet)
+{
+    if (planet == "mercury" || planet == "earth")
+        return 16;
+    if (planet == "venus" || planet == "neptune")
+        return 32;
+    return 64;
+}
+
+/** Evaluate the Chebyshev series @p c at @p x in [-1, 1] */
+double clenshaw(const double *c, double x)
+{
+    double b1 = 0, b2 = 0;
+    for (int j = Degree - 1; j >= 1; j--)
+    {
+        const double b = 2 * x * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b;
+    }
+    return x * b1 - b2 + c[0];
+}
+}
+
+VSOPCache *VSOPCache::Instance()
+{
+    static VSOPCache instance;
+    return &instance;
+}
+
+QString VSOPCache::directory()
+{
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("vsop87");
+}
+
+bool VSOPCache::evaluate(const KSPlanet *planet, double jm, double *lbr)
+{
+    if (!m_Enabled)
+        return false;
+
+    const double days  = jm * DaysPerMillenium;
+    const qint64 index = static_cast<qint64>(std::floor(days / BlockDays));
+
+    std::shared_ptr<const Block> b = block(planet, index);
+    if (!b)
+        return false;
+
+    const int segments = qRound(BlockDays / b->segmentDays);
+    const double t     = days - b->start;
+    const int s        = qBound(0, static_cast<int>(t / b->segmentDays), segments - 1);
+    const double x     = 2 * (t - s * b->segmentDays) / b->segmentDays - 1;
+
+    const double *c = b->coefficients.constData() + s * 3 * Degree;
+    for (int k = 0; k < 3; k++)
+        lbr[k] = clenshaw(c + k * Degree, x);
+    return true;
+}
+
+void VSOPCache::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Blocks.clear();
+}
+
+std::shared_ptr<const VSOPCache::Block> VSOPCache::block(const KSPlanet *planet, qint64 index)
+{
+    // Translations may change at runtime, the untranslated name identifies the series
+    const QString name = planet->untranslatedName().toLower();
+    const Key key(name, index);
+    {
+        QMutexLocker locker(&m_Mutex);
+        auto it = m_Blocks.constFind(key);
+        if (it != m_Blocks.constEnd())
+            return it.value();
+    }
+
+    // Reading or fitting a block takes a while, other blocks stay available meanwhile.
+    // Two threads may fit the same block, the first one to finish publishes it.
+    const quint32 sig = signature(planet, name);
+    if (sig == 0)
+        return nullptr;
+
+    const QString fileName = QDir(directory()).filePath(QString("%1_%2.cheb").arg(name).arg(index));
+
+    std::shared_ptr<const Block> b = read(fileName, sig, index);
+    if (!b)
+    {
+        b = fit(planet, index);
+        if (b)
+            write(fileName, sig, index, *b);
+    }
+
+    QMutexLocker locker(&m_Mutex);
+    auto it = m_Blocks.constFind(key);
+    if (it != m_Blocks.constEnd())
+        return it.value();
+
+    if (m_Blocks.size() >= MaxBlocks)
+        m_Blocks.clear();
+
+    m_Blocks.insert(key, b);
+    return b;
+}
+
+quint32 VSOPCache::signature(const KSPlanet *planet, const QString &name)
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+        auto it = m_Signatures.constFind(name);
+        if (it != m_Signatures.constEnd())
+            return it.value();
+    }
+
+    // Values of the series at a few times, enough to notice any change of their terms
+    const double times[3] = { -0.1, 0, 0.1 };
+    double values[9];
+    bool ok = true;
+    for (int i = 0; i < 3 && ok; i++)
+        ok = planet->calcVSOP(times[i], values + 3 * i);
+
+    quint32 sig = ok ? qHashBits(values, sizeof(values)) : 0;
+    if (ok && sig == 0)
+        sig = 1;
+
+    QMutexLocker locker(&m_Mutex);
+    m_Signatures.insert(name, sig);
+    return sig;
+}
+
+std::shared_ptr<const VSOPCache::Block> VSOPCache::fit(const KSPlanet *planet, qint64 index) const
+{
+    // cos(pi * j * (i + 1/2) / Degree), the nodes are the values for j = 1
+    double cosines[Degree][Degree];
+    for (int j = 0; j < Degree; j++)
+        for (int i = 0; i < Degree; i++)
+            cosines[j][i] = std::cos(M_PI * j * (i + 0.5) / Degree);
+
+    // The ends of the segment, and points halfway between two nodes across the segment
+    const double checks[] = { -1, std::cos(M_PI * (Degree - 1) / Degree), std::cos(M_PI * (3 * Degree / 4) / Degree), 0,
+                              std::cos(M_PI * (Degree / 4) / Degree), std::cos(M_PI / Degree), 1
+                            };
+
+    const QString name = planet->untranslatedName().toLower();
+    double length      = segmentDays(name);
+
+    for (int attempt = 0; attempt < 4; attempt++, length /= 2)
+    {
+        auto b         = std::make_shared<Block>();
+        b->start       = index * BlockDays;
+        b->segmentDays = length;
+
+        const int segments = qRound(BlockDays / length);
+        b->coefficients.resize(segments * 3 * Degree);
+
+        bool accurate = true;
+        for (int s = 0; s < segments && accurate; s++)
+        {
+            const double start = b->start + s * length;
+            double values[3][Degree];
+            double lbr[3];
+
+            for (int i = 0; i < Degree; i++)
+            {
+                const double days = start + (cosines[1][i] + 1) / 2 * length;
+                if (!planet->calcVSOP(days / DaysPerMillenium, lbr))
+                    return nullptr;
+                for (int k = 0; k < 3; k++)
+                    values[k][i] = lbr[k];
+            }
+
+            double *c = b->coefficients.data() + s * 3 * Degree;
+            for (int k = 0; k < 3; k++)
+            {
+                for (int j = 0; j < Degree; j++)
+                {
+                    double sum = 0;
+                    for (int i = 0; i < Degree; i++)
+                        sum += values[k][i] * cosines[j][i];
+                    c[k * Degree + j] = 2 * sum / Degree;
+                }
+                c[k * Degree] /= 2;
+            }
+
+            // The error is largest between the nodes and towards the ends of the segment
+            for (double x : checks)
+            {
+                if (!planet->calcVSOP((start + (x + 1) / 2 * length) / DaysPerMillenium, lbr))
+                    return nullptr;
+                for (int k = 0; k < 3 && accurate; k++)
+                    accurate = std::fabs(clenshaw(c + k * Degree, x) - lbr[k]) < Tolerance;
+                if (!accurate)
+                    break;
+            }
+        }
+
+        if (accurate)
+            return b;
+    }
+
+    qCWarning(KSTARS) << "Unable to approximate the VSOP87 series of" << name << "for block" << index;
+    return nullptr;
+}
+
+std::shared_ptr<const VSOPCache::Block> VSOPCache::read(const QString &fileName, quint32 signature, qint64 index) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0, fileSignature = 0;
+    qint64 fileIndex = 0;
+    auto b = std::make_shared<Block>();
+    in >> magic >> version >> fileSignature >> fileIndex >> b->segmentDays >> b->coefficients;
+
+    if (in.status() != QDataStream::Ok || magic != Magic || version != Version || fileSignature != signature ||
+            fileIndex != index || b->segmentDays <= 0 ||
+            b->coefficients.size() != qRound(BlockDays / b->segmentDays) * 3 * Degree)
+        return nullptr;
+
+    b->start = index * BlockDays;
+    return b;
+}
+
+void VSOPCache::write(const QString &fileName, quint32 signature, qint64 index, const Block &block) const
+{
+    if (!QDir().mkpath(directory()))
+        return;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS) << "Unable to write VSOP87 cache" << fileName << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << Magic << Version << signature << index << block.segmentDays << block.coefficients;
+    file.commit();
+}
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+class KSPlanet;
+
+/**
+ * @class VSOPCache
+ * @short Chebyshev approximations of the VSOP87 series of the planets.
+ *
+ * Time is split into blocks of 4096 days, and each block into segments of 16 to 64 days
+ * depending on the planet. In each segment, the heliocentric longitude, latitude and distance
+ * are approximated by Chebyshev polynomials fitted at the Chebyshev nodes of the full series.
+ * The fit of each segment is checked against the series at several points, and segments are
+ * halved until the error is below 1e-9 radians or AU, far below the precision of the series themselves.
+ *
+ * Blocks are fitted on first use and saved in the cache directory of KStars, so an evaluation
+ * usually costs three Clenshaw recurrences instead of thousands of cosines. Saved blocks are
+ * discarded when the series of the planet change. The cache is safe to use from several threads,
+ * blocks are fitted without holding the lock so other threads are not held up meanwhile.
+ */
+class VSOPCache
+{
+    public:
+        static VSOPCache *Instance();
+
+        /**
+         * @short Evaluate the VSOP87 series of @p planet.
+         * @param planet the planet, its series must be loaded from disk on demand
+         * @param jm time in Julian millenia since J2000
+         * @param lbr set to the heliocentric ecliptic longitude and latitude in radians, the longitude
+         * not reduced to [0, 2pi[, and the distance in AU
+         * @return false if the series of @p planet are not available, or the cache is disabled
+         */
+        bool evaluate(const KSPlanet *planet, double jm, double *lbr);
+
+        /**
+         * @short Enable or disable the cache, when disabled the series are always summed.
+         * The cache is enabled by default.
+         */
+        void setEnabled(bool enabled)
+        {
+            m_Enabled = enabled;
+        }
+
+        /** @short Forget the blocks held in memory, saved blocks are kept */
+        void clear();
+
+        /** @return the directory where blocks are saved */
+        static QString directory();
+
+    private:
+        struct Block
+        {
+            /// Days since J2000
+            double start { 0 };
+            double segmentDays { 0 };
+            /// For each segment, the coefficients of the longitude, latitude and distance
+            QVector<double> coefficients;
+        };
+
+        /// Untranslated name of the planet in lower case, and index of the block
+        using Key = QPair<QString, qint64>;
+
+        VSOPCache() = default;
+
+        std::shared_ptr<const Block> block(const KSPlanet *planet, qint64 index);
+        std::shared_ptr<const Block> fit(const KSPlanet *planet, qint64 index) const;
+        std::shared_ptr<const Block> read(const QString &fileName, quint32 signature, qint64 index) const;
+        void write(const QString &fileName, quint32 signature, qint64 index, const Block &block) const;
+
+        /** @return a value identifying the series of @p planet, 0 if they are not available */
+        quint32 signature(const KSPlanet *planet, const QString &name);
+
+        std::atomic<bool> m_Enabled { true };
+        /// Guards m_Blocks and m_Signatures, never held while summing the series
+        QMutex m_Mutex;
+        QHash<Key, std::shared_ptr<const Block>> m_Blocks;
+        QHash<QString, quint32> m_Signatures;
+};
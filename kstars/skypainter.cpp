@@ -10,6 +10,7 @@
 #include "skymap.h"
 #include "Options.h"
 #include "kstarsdata.h"
+#include "projections/projector.h"
 #include "skycomponents/skiphashlist.h"
 #include "skycomponents/linelistlabel.h"
 #include "skyobjects/kscomet.h"
@@ -27,6 +28,16 @@ void SkyPainter::setSizeMagLimit(float sizeMagLim)
     m_sizeMagLim = sizeMagLim;
 }
 
+bool SkyPainter::addPointSource(const SkyPoint *loc, float mag, char sp, QPointF *pos)
+{
+    if (!drawPointSource(loc, mag, sp))
+        return false;
+
+    if (pos)
+        *pos = SkyMap::Instance()->projector()->toScreen(loc);
+    return true;
+}
+
 float SkyPainter::starWidth(float mag) const
 {
     //adjust maglimit for ZoomLevel
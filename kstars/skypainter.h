@@ -128,6 +128,31 @@ class SkyPainter
          */
         virtual bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') = 0;
 
+        /**
+         * @short Start collecting point sources into a batch.
+         * Until flushPointSources() is called, addPointSource() may defer the actual drawing, so that
+         * the backend can draw a whole star field with a few calls instead of one call per star.
+         * The default implementation does nothing.
+         */
+        virtual void beginPointSources() {}
+
+        /**
+         * @short Add a point source (e.g., a star) to the current batch.
+         * The default implementation draws the source immediately with drawPointSource().
+         * @param loc the location of the source in the sky
+         * @param mag the magnitude of the source
+         * @param sp the spectral class of the source
+         * @param pos if not null, receives the screen position of the source when it is drawn
+         * @return true if the source is drawn
+         */
+        virtual bool addPointSource(const SkyPoint *loc, float mag, char sp = 'A', QPointF *pos = nullptr);
+
+        /**
+         * @short Draw the point sources added since beginPointSources().
+         * The default implementation does nothing.
+         */
+        virtual void flushPointSources() {}
+
         /**
         * @short Draw a deep sky object (loaded from the new implementation)
         * @param obj the object to draw
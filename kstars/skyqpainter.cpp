@@ -149,6 +149,7 @@ void SkyQPainter::begin()
 
 void SkyQPainter::end()
 {
+    flushPointSources();
     QPainter::end();
 }
 
@@ -298,6 +299,27 @@ void SkyQPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
     //    } //FIXME: what if both are offscreen but the line isn't?
 }
 
+void SkyQPainter::projectPoints(const SkyList *points, bool refract)
+{
+    const int count = points->size();
+    m_projectedLon.resize(count);
+    m_projectedLat.resize(count);
+    m_projectedX.resize(count);
+    m_projectedY.resize(count);
+    m_projectedVisible.resize(count);
+
+    const bool altAz = m_proj->viewParams().useAltAz;
+    for (int i = 0; i < count; i++)
+    {
+        const SkyPoint *point = points->at(i).get();
+        m_projectedLon[i] = altAz ? point->az().radians() : point->ra().radians();
+        m_projectedLat[i] = altAz ? point->alt().radians() : point->dec().radians();
+    }
+
+    m_proj->toScreenBatch(m_projectedLon.constData(), m_projectedLat.constData(), count, m_projectedX.data(),
+                          m_projectedY.data(), m_projectedVisible.data(), refract);
+}
+
 void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
                                   LineListLabel *label)
 {
@@ -306,7 +328,9 @@ void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
 
     if (points->size() == 0)
         return;
-    QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
+    projectPoints(points, true);
+    QPointF oLast(m_projectedX[0], m_projectedY[0]);
+    isVisibleLast = m_projectedVisible[0];
     // & with the result of checkVisibility to clip away things below horizon
     isVisibleLast &= m_proj->checkVisibility(points->first().get());
     QPointF oThis, oThis2;
@@ -315,7 +339,8 @@ void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
     {
         SkyPoint *pThis = points->at(j).get();
 
-        oThis2 = oThis = m_proj->toScreen(pThis, true, &isVisible);
+        oThis2 = oThis = QPointF(m_projectedX[j], m_projectedY[j]);
+        isVisible = m_projectedVisible[j];
         // & with the result of checkVisibility to clip away things below horizon
         isVisible &= m_proj->checkVisibility(pThis);
         bool doSkip = false;
@@ -360,10 +385,12 @@ void SkyQPainter::drawSkyPolygon(LineList *list, bool forceClip)
 
     if (forceClip == false)
     {
-        for (const auto &point : *points)
+        projectPoints(points, false);
+        polygon.reserve(points->size());
+        for (int i = 0; i < points->size(); i++)
         {
-            polygon << m_proj->toScreen(point.get(), false, &isVisibleLast);
-            isVisible |= isVisibleLast;
+            polygon << QPointF(m_projectedX[i], m_projectedY[i]);
+            isVisible |= bool(m_projectedVisible[i]);
         }
 
         // If 1+ points are visible, draw it
@@ -597,23 +624,80 @@ bool SkyQPainter::drawAsteroid(KSAsteroid *ast)
     return false;
 }
 
-bool SkyQPainter::drawPointSource(const SkyPoint *loc, float mag, char sp)
+bool SkyQPainter::projectPointSource(const SkyPoint *loc, QPointF &pos) const
 {
     //Check if it's even visible before doing anything
     if (!m_proj->checkVisibility(loc))
         return false;
 
     bool visible = false;
-    QPointF pos  = m_proj->toScreen(loc, true, &visible);
+    pos = m_proj->toScreen(loc, true, &visible);
     // FIXME: onScreen here should use canvas size rather than SkyMap size, especially while printing in portrait mode!
-    if (visible && m_proj->onScreen(pos))
+    return visible && m_proj->onScreen(pos);
+}
+
+bool SkyQPainter::drawPointSource(const SkyPoint *loc, float mag, char sp)
+{
+    QPointF pos;
+    if (!projectPointSource(loc, pos))
+        return false;
+
+    drawPointSource(pos, starWidth(mag), sp);
+    return true;
+}
+
+void SkyQPainter::beginPointSources()
+{
+    // Vector stars are only used for printing and SVG export, they are drawn one by one
+    m_batchPointSources = !m_vectorStars || starColorMode == 0;
+    if (m_batchPointSources)
+        m_pointSourceBatch.resize(nSPclasses * nStarSizes);
+}
+
+bool SkyQPainter::addPointSource(const SkyPoint *loc, float mag, char sp, QPointF *pos)
+{
+    QPointF screenPos;
+    if (!projectPointSource(loc, screenPos))
+        return false;
+
+    if (pos)
+        *pos = screenPos;
+
+    const float size = starWidth(mag);
+    if (!m_batchPointSources)
     {
-        drawPointSource(pos, starWidth(mag), sp);
+        drawPointSource(screenPos, size, sp);
         return true;
     }
-    else
+
+    // Same sprite as drawPointSource(), fragments are positioned by their center
+    const int isize = qBound(1, static_cast<int>(size), nStarSizes - 1);
+    const QPixmap *im = imageCache[harvardToIndex(sp)][isize];
+    m_pointSourceBatch[harvardToIndex(sp) * nStarSizes + isize].append(
+        QPainter::PixmapFragment::create(screenPos, QRectF(im->rect())));
+    return true;
+}
+
+void SkyQPainter::flushPointSources()
+{
+    if (!m_batchPointSources)
+        return;
+    m_batchPointSources = false;
+
+    // Stars are added brightest first, so draw the biggest sprites first to keep fainter
+    // stars on top like the unbatched path does
+    for (int isize = nStarSizes - 1; isize > 0; isize--)
     {
-        return false;
+        for (int sp = 0; sp < nSPclasses; sp++)
+        {
+            QVector<QPainter::PixmapFragment> &fragments = m_pointSourceBatch[sp * nStarSizes + isize];
+            if (fragments.isEmpty())
+                continue;
+
+            drawPixmapFragments(fragments.constData(), fragments.size(), *imageCache[sp][isize]);
+            // Keep the capacity for the next frame
+            fragments.resize(0);
+        }
     }
 }
 
@@ -811,8 +895,18 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
         save();
         translate(pos);
         rotate(finalPA);
-        drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), *(o.m_Img.get()));
-        numDrawn++;
+        // Draw the resolution level matching the size on screen, and only its part inside the viewport.
+        const QImage img = o.imageForWidth(w);
+        const QRectF target(-0.5 * w, -0.5 * h, w, h);
+        const QRectF visibleTarget = transform().inverted().mapRect(QRectF(0, 0, vw, vh)).intersected(target);
+        if (!visibleTarget.isEmpty())
+        {
+            const double sx = img.width() / w, sy = img.height() / h;
+            const QRectF source((visibleTarget.x() - target.x()) * sx, (visibleTarget.y() - target.y()) * sy,
+                                visibleTarget.width() * sx, visibleTarget.height() * sy);
+            drawImage(visibleTarget, img, source);
+            numDrawn++;
+        }
         restore();
     }
     // fprintf(stderr, "DrawTimer: %lldms for %d images\n", drawTimer.elapsed(), numDrawn);
@@ -12,6 +12,7 @@
 
 #include <QColor>
 #include <QMap>
+#include <QVector>
 
 class Projector;
 class QWidget;
@@ -57,7 +58,8 @@ class SkyQPainter : public SkyPainter, public QPainter
 
         void setPaintDevice(QPaintDevice *pd)
         {
-            m_pd = pd;
+            m_pd   = pd;
+            m_size = QSize(pd->width(), pd->height());
         }
         void setPen(const QPen &pen) override;
         void setBrush(const QBrush &brush) override;
@@ -88,6 +90,9 @@ class SkyQPainter : public SkyPainter, public QPainter
                              LineListLabel *label = nullptr) override;
         void drawSkyPolygon(LineList *list, bool forceClip = true) override;
         bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') override;
+        void beginPointSources() override;
+        bool addPointSource(const SkyPoint *loc, float mag, char sp = 'A', QPointF *pos = nullptr) override;
+        void flushPointSources() override;
         bool drawCatalogObject(const CatalogObject &obj) override;
         void drawCatalogObjectImage(const QPointF &pos, const CatalogObject &obj,
                                     float positionAngle);
@@ -114,9 +119,21 @@ class SkyQPainter : public SkyPainter, public QPainter
         bool drawImageOverlay(const QList<ImageOverlay> *imageOverlays, bool useCache = false) override;
 
     private:
+        /** @short Project @p loc to @p pos, @return true if the point is visible on the screen */
+        bool projectPointSource(const SkyPoint *loc, QPointF &pos) const;
+        /** @short Project all @p points in one batch into m_projectedX, m_projectedY and m_projectedVisible */
+        void projectPoints(const SkyList *points, bool refract);
+
         QPaintDevice *m_pd{ nullptr };
         const Projector *m_proj{ nullptr };
         bool m_vectorStars{ false };
+        bool m_batchPointSources{ false };
+        /// Queued star sprites, one list per cached star image
+        QVector<QVector<QPainter::PixmapFragment>> m_pointSourceBatch;
+        /// Scratch arrays of projectPoints(), kept to avoid reallocating them for each line
+        QVector<double> m_projectedLon, m_projectedLat;
+        QVector<float> m_projectedX, m_projectedY;
+        QVector<uchar> m_projectedVisible;
         HIPSRenderer *m_hipsRender{ nullptr };
         TerrainRenderer *m_terrainRender{ nullptr };
         QSize m_size;
@@ -8,9 +8,27 @@
 #include "approachsolver.h"
 #include <kstars_debug.h>
 
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+/// Smallest number of initial steps searched by a chunk of a concurrent search
+const int MIN_CHUNK_STEPS = 32;
+/// Approaches refined by two chunks to times closer than this are the same approach, in days.
+/// findPrecise() refines the time to about a minute.
+const double SAME_APPROACH = 5.0 / (24.0 * 60.0);
+}
+
 ApproachSolver::ApproachSolver(QObject *parent) : QObject(parent)
 {
-    m_geoPlace = KStarsData::Instance()->geo();
+    // KStarsData is not available in unit tests, a location is then set with setGeoLocation()
+    if (KStarsData::Instance())
+        m_geoPlace = KStarsData::Instance()->geo();
     m_Earth = KSPlanet(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
 }
 
@@ -22,16 +40,104 @@ void ApproachSolver::setGeoLocation(GeoLocation *geo)
         m_geoPlace = KStarsData::Instance()->geo();
 }
 
-// FIXME: We need a better algo for finding approaches!
+void ApproachSolver::copySettingsTo(ApproachSolver *copy) const
+{
+    copy->m_geoPlace      = m_geoPlace;
+    copy->m_maxSeparation = m_maxSeparation;
+}
+
 QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
         long double stopJD, std::function<void (long double, dms)> const &callback)
+{
+    const double step0 = findInitialStep(startJD, stopJD);
+    const int maxChunks = 4 * QThreadPool::globalInstance()->maxThreadCount();
+    const int chunks = qBound(1, static_cast<int>((stopJD - startJD) / (step0 * MIN_CHUNK_STEPS)), maxChunks);
+
+    // Copies are created and deleted on this thread, some objects count their instances
+    std::vector<std::unique_ptr<ApproachSolver>> workers;
+    for (int i = 0; chunks > 1 && i < chunks; i++)
+    {
+        std::unique_ptr<ApproachSolver> worker(clone());
+        if (!worker)
+        {
+            workers.clear();
+            break;
+        }
+        workers.push_back(std::move(worker));
+    }
+
+    QMap<long double, dms> Separations;
+    if (workers.empty())
+    {
+        Separations = scan(startJD, stopJD, step0, true);
+    }
+    else
+    {
+        // Chunks overlap so that approaches close to their ends are bracketed,
+        // each approach is kept by the chunk it falls in
+        const long double length  = (stopJD - startJD) / chunks;
+        const long double overlap = 2 * step0;
+
+        QVector<QMap<long double, dms>> results(chunks);
+        QVector<QFuture<void>> futures;
+        for (int i = 0; i < chunks; i++)
+        {
+            const long double from = startJD + i * length;
+            const long double to   = (i == chunks - 1) ? stopJD : from + length;
+            ApproachSolver *worker = workers[i].get();
+            QMap<long double, dms> *result = &results[i];
+
+            futures.append(QtConcurrent::run([ = ]()
+            {
+                const QMap<long double, dms> found =
+                    worker->scan(qMax(startJD, from - overlap), qMin(stopJD, to + overlap), step0, false);
+                for (auto it = found.constBegin(); it != found.constEnd(); ++it)
+                {
+                    if (it.key() >= from && (it.key() < to || to == stopJD))
+                        result->insert(it.key(), it.value());
+                }
+            }));
+        }
+
+        for (int i = 0; i < chunks; i++)
+        {
+            futures[i].waitForFinished();
+            emit solverMadeProgress(100 * (i + 1) / chunks);
+
+            addApproaches(&Separations, results[i]);
+        }
+    }
+
+    if (callback)
+    {
+        for (auto it = Separations.constBegin(); it != Separations.constEnd(); ++it)
+            callback(it.key(), it.value());
+    }
+
+    return Separations;
+}
+
+void ApproachSolver::addApproaches(QMap<long double, dms> *approaches, const QMap<long double, dms> &found)
+{
+    // An approach refined across the end of a chunk may be found by both chunks, at almost the same time
+    for (auto it = found.constBegin(); it != found.constEnd(); ++it)
+    {
+        if (!approaches->isEmpty() && std::fabs(it.key() - approaches->lastKey()) < SAME_APPROACH)
+            continue;
+        approaches->insert(it.key(), it.value());
+    }
+}
+
+// FIXME: We need a better algo for finding approaches!
+QMap<long double, dms> ApproachSolver::scan(long double startJD, long double stopJD, double step0,
+        bool reportProgress)
 {
     QMap<long double, dms> Separations;
     QPair<long double, dms> extremum;
     dms Dist;
     dms prevDist;
 
-    double step, step0;
+    double step;
     int Sign, prevSign;
 
     //  qCDebug(KSTARS) << "Entered KSConjunct::findClosestApproach() with startJD = " << (double)startJD;
@@ -40,7 +146,6 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
     //  qCDebug(KSTARS) << m_object2->name() << ": RA = " << m_object2->ra() -> toHMSString() << "; Dec = " << m_object2->dec() -> toDMSString() << "\n";
     prevSign = 0;
 
-    step0 = findInitialStep(startJD, stopJD);
     step = step0;
     //	qCDebug(KSTARS) << "Initial Separation between " << m_object1->name() << " and " << m_object2->name() << " = " << (prevDist.toDMSString());
 
@@ -49,8 +154,11 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
     jd += step;
     while (jd <= stopJD)
     {
-        int progress = int(100.0 * (jd - startJD) / (stopJD - startJD));
-        emit solverMadeProgress(progress);
+        if (reportProgress)
+        {
+            int progress = int(100.0 * (jd - startJD) / (stopJD - startJD));
+            emit solverMadeProgress(progress);
+        }
 
         Dist = updateAndFindDistance(jd);
         Sign = sgn(Dist - prevDist);
@@ -93,12 +201,7 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
             if (findPrecise(&extremum, jd, step, Sign))
             {
                 if (extremum.second.radians() < getMaxSeparation())
-                {
                     Separations.insert(extremum.first, extremum.second);
-
-                    if(callback)
-                        callback(extremum.first, extremum.second);
-                }
             }
         }
 
@@ -42,6 +42,9 @@ public:
     /**
      * @short Compute the closest approach of two planets in the given range
      *
+     * Long ranges are split into chunks searched concurrently, each on a copy of the solver
+     * made by clone(). The callback is called on the calling thread, in time order.
+     *
      * @param startJD  Julian Day corresponding to start of the calculation period
      * @param stopJD   Julian Day corresponding to end of the calculation period
      * @param callback A callback function
@@ -55,7 +58,7 @@ public:
      * @brief getGeoLocation
      * @return the currently set GeoLocation
      */
-    GeoLocation * getGeoLocation() { return m_geoPlace; }
+    GeoLocation * getGeoLocation() const { return m_geoPlace; }
 
 
     /**
@@ -73,6 +76,37 @@ signals:
     void solverMadeProgress(int progress);
 
 protected:
+    /**
+     * @short Create a copy of the solver with its own copies of the objects, used to search
+     * part of a range on another thread. Implementations should call copySettingsTo().
+     * @return nullptr if the solver cannot be copied, searches are then serial
+     */
+    virtual ApproachSolver *clone() const { return nullptr; }
+
+    /**
+     * @brief copySettingsTo
+     * @short Copy the location and the maximum separation of this solver to @p copy
+     */
+    void copySettingsTo(ApproachSolver *copy) const;
+
+    /**
+     * @short Search the closest approaches in the given range on the calling thread
+     *
+     * @param startJD  Julian Day corresponding to start of the calculation period
+     * @param stopJD   Julian Day corresponding to end of the calculation period
+     * @param step0    initial step, see findInitialStep()
+     * @param reportProgress whether solverMadeProgress() is emitted
+     * @return Hash containing julian days of close conjunctions against separation
+     */
+    QMap<long double, dms> scan(long double startJD, long double stopJD, double step0, bool reportProgress);
+
+    /**
+     * @short Add the approaches @p found by a chunk of a concurrent search to @p approaches
+     * Chunks are added in time order. An approach found by the previous chunk too, refined to
+     * the same time within a few minutes, is only added once.
+     */
+    static void addApproaches(QMap<long double, dms> *approaches, const QMap<long double, dms> &found);
+
     // TODO: This one may be moved to KSConjunct
 
     /**
@@ -147,5 +181,5 @@ private:
     int sgn(dms a);
 
     GeoLocation * m_geoPlace { nullptr };
-    double m_maxSeparation;
+    double m_maxSeparation { 0 };
 };
@@ -241,7 +241,6 @@ void ConjunctionsTool::slotCompute(void)
         opposition = true;
     QStringList objects; // List of sky object used as Object1
     KStarsData *data = KStarsData::Instance();
-    int progress     = 0;
 
     // Check if we have a valid angle in maxSeparationBox
     dms maxSeparation(0.0);
@@ -350,26 +349,28 @@ void ConjunctionsTool::slotCompute(void)
         QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, objects.count(), this);
         progressDlg.setWindowTitle(i18nc("@title:window", "Conjunction"));
         progressDlg.setWindowModality(Qt::WindowModal);
+        progressDlg.setLabelText(i18n("Compute conjunctions with %1", Object2->name()));
         progressDlg.setValue(0);
 
+        // All pairs are searched in one pass
+        QList<SkyObject_s> objects1;
         for (auto &object : objects)
         {
-            // If the user click on the 'cancel' button
-            if (progressDlg.wasCanceled())
-                break;
-
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
-
-            // Compute conjuction
-            Object1 = std::shared_ptr<SkyObject>(data->skyComposite()->findByName(object)->clone());
-            ksc.setObject1(Object1);
-            showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                             object, Object2->name());
+            SkyObject *found = data->skyComposite()->findByName(object);
+            if (found)
+                objects1.append(SkyObject_s(found->clone()));
         }
 
+        const QVector<QMap<long double, dms>> results =
+            ksc.findClosestApproaches(objects1, startJD, stopJD, [&progressDlg](int done)
+        {
+            progressDlg.setValue(done);
+            return !progressDlg.wasCanceled();
+        });
+
+        for (int i = 0; i < objects1.size(); i++)
+            showConjunctions(results[i], objects1[i]->name(), Object2->name());
+
         progressDlg.setValue(objects.count());
     }
     else
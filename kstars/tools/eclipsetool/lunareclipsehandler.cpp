@@ -9,6 +9,12 @@
 #include "solarsystemcomposite.h"
 #include "dms.h"
 
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <vector>
+
 LunarEclipseHandler::LunarEclipseHandler(QObject * parent) : EclipseHandler(parent),
     m_sun(), m_moon(), m_shadow(&m_moon, &m_sun, &m_Earth)
 {
@@ -18,8 +24,6 @@ EclipseHandler::EclipseVector LunarEclipseHandler::computeEclipses(long double s
 {
     m_mode = CLOSEST_APPROACH;
 
-    const long double SEARCH_INTERVAL = 5.l; // Days
-
     QVector<EclipseEvent_s> eclipses;
     QVector<long double> fullMoons = getFullMoons(startJD, endJD);
 
@@ -27,47 +31,45 @@ EclipseHandler::EclipseVector LunarEclipseHandler::computeEclipses(long double s
     if (total == 0)
         return eclipses;
 
-    float step = 1 / total;
-    float progress = 0;
+    // Full moons are searched in groups, each on its own copy of the handler. Copies are
+    // created and deleted here, the moon counts its instances.
+    const int groups = qMin(total, 4 * QThreadPool::globalInstance()->maxThreadCount());
+    std::vector<std::unique_ptr<LunarEclipseHandler>> workers;
+    QVector<QVector<QPair<long double, KSEarthShadow::ECLIPSE_TYPE>>> found(groups);
+    QVector<QFuture<void>> futures;
 
-    connect(this, &ApproachSolver::solverMadeProgress, this, [ &, this] (int dProgress)
+    for (int i = 0; i < groups; i++)
     {
-        float tmpProgress = roundf(progress + step * dProgress);
-        if (tmpProgress > progress)
+        const int first = i * total / groups;
+        const int last  = (i + 1) * total / groups;
+
+        workers.emplace_back(static_cast<LunarEclipseHandler *>(clone()));
+        LunarEclipseHandler *worker = workers.back().get();
+        const QVector<long double> dates = fullMoons.mid(first, last - first);
+        QVector<QPair<long double, KSEarthShadow::ECLIPSE_TYPE>> *result = &found[i];
+
+        futures.append(QtConcurrent::run([worker, dates, result]()
         {
-            progress = tmpProgress;
-            emit signalProgress(static_cast<int>(progress));
-        }
-    });
+            *result = worker->findEclipses(dates);
+        }));
+    }
 
-    for(auto date : fullMoons)
+    for (int i = 0; i < groups; i++)
     {
-        findClosestApproach(date, date + SEARCH_INTERVAL, [&eclipses, this] (long double JD, dms)
+        futures[i].waitForFinished();
+
+        for (const auto &eclipse : found[i])
         {
-            EclipseEvent::ECLIPSE_TYPE type;
-            updatePositions(JD);
+            EclipseEvent::ECLIPSE_TYPE type = EclipseEvent::PARTIAL;
+            if (eclipse.second == KSEarthShadow::FULL_PENUMBRA || eclipse.second == KSEarthShadow::FULL_UMBRA)
+                type = EclipseEvent::FULL;
 
-            KSEarthShadow::ECLIPSE_TYPE extended_type = m_shadow.getEclipseType();
-            switch (extended_type)
-            {
-                case KSEarthShadow::FULL_PENUMBRA:
-                case KSEarthShadow::FULL_UMBRA:
-                    type = EclipseEvent::FULL;
-                    break;
-                case KSEarthShadow::NONE:
-                    return;
-                default:
-                    type = EclipseEvent::PARTIAL;
-                    break;
-            }
-
-            EclipseEvent_s event = std::make_shared<LunarEclipseEvent>(JD, *getGeoLocation(), type, extended_type);
+            EclipseEvent_s event = std::make_shared<LunarEclipseEvent>(eclipse.first, *getGeoLocation(), type, eclipse.second);
             emit signalEventFound(event);
             eclipses.append(event);
-        });
+        }
 
-        progress++;
-        emit signalProgress(static_cast<int>(roundf(100 * (progress / total))));
+        emit signalProgress(100 * (i + 1) / groups);
     }
 
     emit signalProgress(100);
@@ -75,6 +77,37 @@ EclipseHandler::EclipseVector LunarEclipseHandler::computeEclipses(long double s
     return eclipses;
 }
 
+QVector<QPair<long double, KSEarthShadow::ECLIPSE_TYPE>> LunarEclipseHandler::findEclipses(const QVector<long double> &fullMoons)
+{
+    const long double SEARCH_INTERVAL = 5.l; // Days
+
+    QVector<QPair<long double, KSEarthShadow::ECLIPSE_TYPE>> eclipses;
+    for (auto date : fullMoons)
+    {
+        const QMap<long double, dms> approaches = scan(date, date + SEARCH_INTERVAL,
+                findInitialStep(date, date + SEARCH_INTERVAL), false);
+
+        for (auto it = approaches.constBegin(); it != approaches.constEnd(); ++it)
+        {
+            updatePositions(it.key());
+
+            KSEarthShadow::ECLIPSE_TYPE extended_type = m_shadow.getEclipseType();
+            if (extended_type != KSEarthShadow::NONE)
+                eclipses.append(qMakePair(it.key(), extended_type));
+        }
+    }
+
+    return eclipses;
+}
+
+ApproachSolver *LunarEclipseHandler::clone() const
+{
+    LunarEclipseHandler *copy = new LunarEclipseHandler();
+    copySettingsTo(copy);
+    copy->m_mode = m_mode;
+    return copy;
+}
+
 // FIXME: (Valentin) This doesn't work for now. We need another method.
 LunarEclipseDetails LunarEclipseHandler::findEclipseDetails(LunarEclipseEvent *event)
 {
@@ -190,8 +223,9 @@ QVector<long double> LunarEclipseHandler::getFullMoons(long double startJD, long
         KSNumbers num(currentJD);
         CachingDms LST = getGeoLocation()->GSTtoLST(t.gst());
 
-        m_sun.updateCoords(&num, true, getGeoLocation()->lat(), &LST, true);
-        m_moon.updateCoords(&num, true, getGeoLocation()->lat(), &LST, true);
+        m_Earth.findPosition(&num);
+        m_sun.findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
+        m_moon.findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
         m_moon.findPhase(&m_sun);
 
         if(m_moon.illum() > 0.9)
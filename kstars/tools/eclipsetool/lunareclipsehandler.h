@@ -90,6 +90,8 @@ public:
     LunarEclipseDetails findEclipseDetails(LunarEclipseEvent *event);
 
 protected:
+    ApproachSolver *clone() const override;
+
     double findInitialStep(long double, long double) override
         { return (m_mode == CLOSEST_APPROACH) ? INITIAL_STEP : DETAIL_STEP; }
 
@@ -110,6 +112,13 @@ private:
      */
     QVector<long double> getFullMoons(long double startJD, long double endJD);
 
+    /**
+     * @brief findEclipses
+     * @short Search eclipses close to each of @p fullMoons, on the calling thread
+     * @return the julian days and types of the eclipses found
+     */
+    QVector<QPair<long double, KSEarthShadow::ECLIPSE_TYPE>> findEclipses(const QVector<long double> &fullMoons);
+
     // Objects for the Calculations
     KSSun m_sun;
     KSMoon m_moon;
@@ -11,13 +11,74 @@
 #include "skyobjects/skyobject.h"
 #include "skyobjects/ksplanetbase.h"
 
+#include <QFuture>
+#include <QtConcurrent>
+
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 KSConjunct::KSConjunct() : ApproachSolver ()
 {
     connect(this, &ApproachSolver::solverMadeProgress, this, &KSConjunct::madeProgress);
 }
 
+ApproachSolver *KSConjunct::clone() const
+{
+    return createWorker(m_object1);
+}
+
+KSConjunct *KSConjunct::createWorker(const SkyObject_s &object1) const
+{
+    KSConjunct *copy = new KSConjunct();
+    copySettingsTo(copy);
+
+    copy->m_object1.reset(object1->clone());
+    copy->m_object2.reset(static_cast<KSPlanetBase *>(m_object2->clone()));
+    copy->m_opposition = m_opposition;
+
+    // Trails of the copies would only grow at each step
+    if (auto trail = dynamic_cast<TrailObject *>(copy->m_object1.get()))
+        trail->clearTrail();
+    copy->m_object2->clearTrail();
+
+    return copy;
+}
+
+QVector<QMap<long double, dms>> KSConjunct::findClosestApproaches(const QList<SkyObject_s> &objects,
+        long double startJD, long double stopJD,
+        const std::function<bool (int)> &progress)
+{
+    QVector<QMap<long double, dms>> results(objects.size());
+    std::vector<std::unique_ptr<KSConjunct>> workers;
+    QVector<QFuture<void>> futures;
+    std::atomic<bool> aborted { false };
+
+    for (int i = 0; i < objects.size(); i++)
+    {
+        workers.emplace_back(createWorker(objects[i]));
+
+        KSConjunct *worker = workers.back().get();
+        const double step0 = worker->findInitialStep(startJD, stopJD);
+        QMap<long double, dms> *result = &results[i];
+
+        futures.append(QtConcurrent::run([ =, &aborted]()
+        {
+            if (!aborted)
+                *result = worker->scan(startJD, stopJD, step0, false);
+        }));
+    }
+
+    for (int i = 0; i < futures.size(); i++)
+    {
+        futures[i].waitForFinished();
+        if (progress && !aborted && !progress(i + 1))
+            aborted = true;
+    }
+
+    return results;
+}
+
 dms KSConjunct::findDistance()
 {
     dms dist = findSkyPointDistance(m_object1.get(), m_object2.get());
@@ -32,16 +32,36 @@ public:
     void setObject2(KSPlanetBase_s &obj) { m_object2 = obj; }
     void setOpposition(bool opposition) { m_opposition = opposition; }
 
+    /**
+     * @short Compute the closest approaches of each of @p objects with the second object
+     *
+     * The pairs are searched concurrently, each on its own copies of the objects.
+     *
+     * @param objects  the objects used in turn as first object
+     * @param startJD  Julian Day corresponding to start of the calculation period
+     * @param stopJD   Julian Day corresponding to end of the calculation period
+     * @param progress called on the calling thread with the number of pairs searched so far,
+     * the remaining pairs are skipped if it returns false
+     * @return for each object, julian days of close conjunctions against separation
+     */
+    QVector<QMap<long double, dms>> findClosestApproaches(const QList<SkyObject_s> &objects,
+            long double startJD, long double stopJD,
+            const std::function<bool (int)> &progress = {});
+
 signals:
     void madeProgress(int);
 
 protected:
+    ApproachSolver *clone() const override;
     double findInitialStep(long double startJD, long double stopJD) override;
     void updatePositions(long double jd) override;
 
 private:
     dms findDistance() override;
 
+    /** @short Create a copy of this solver using a copy of @p object1 as first object */
+    KSConjunct *createWorker(const SkyObject_s &object1) const;
+
 
     SkyObject_s m_object1;
     KSPlanetBase_s m_object2;
@@ -203,7 +203,7 @@ void modCalcDayLength::updateAlmanac(const QDate &d, GeoLocation *geo)
 
     //after calling riseSetTime Phase needs to reset, setting it before causes Phase to set nan
     Moon.findPosition(&num);
-    Moon.findPhase(nullptr);
+    Moon.findPhase();
     lunarphaseString = Moon.phaseName() + " (" + QString::number(int(100 * Moon.illum())) + "%)";
 
     //Fix length of Az strings
@@ -0,0 +1,335 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "satellitepasspredictor.h"
+
+#include "geolocation.h"
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "skycomponents/satellitescomponent.h"
+#include "skycomponents/skymapcomposite.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+constexpr double SECONDS_PER_DAY = 86400.0;
+// Events are refined down to this resolution
+constexpr double TIME_RESOLUTION = 0.1 / SECONDS_PER_DAY;
+}
+
+SatellitePassPredictor::SatellitePassPredictor(GeoLocation *geo)
+    : m_Geo(geo ? geo : KStarsData::Instance()->geo())
+{
+}
+
+SatellitePassPredictor::~SatellitePassPredictor() = default;
+
+void SatellitePassPredictor::setSatellites(const QList<Satellite *> &satellites)
+{
+    m_Satellites.clear();
+    m_Satellites.reserve(satellites.size());
+    for (const auto sat : satellites)
+        m_Satellites.emplace_back(sat->clone());
+}
+
+QList<Satellite *> SatellitePassPredictor::selectedSatellites()
+{
+    QList<Satellite *> selected;
+
+    auto composite = KStarsData::Instance()->skyComposite();
+    if (composite == nullptr || composite->satellites() == nullptr)
+        return selected;
+
+    for (const auto group : composite->satellites()->groups())
+    {
+        for (const auto sat : *group)
+        {
+            if (sat->selected())
+                selected.append(sat);
+        }
+    }
+
+    return selected;
+}
+
+double SatellitePassPredictor::altitudeAt(Satellite *sat, double jd) const
+{
+    if (sat->updatePos(Satellite::environment(jd, m_Geo)) != 0)
+        return std::nan("");
+    return sat->alt().Degrees();
+}
+
+double SatellitePassPredictor::separationAt(Satellite *sat, const SkyPoint &target, double jd) const
+{
+    if (sat->updatePos(Satellite::environment(jd, m_Geo)) != 0)
+        return std::nan("");
+    return sat->angularDistanceTo(&target).Degrees();
+}
+
+template <typename Function>
+double SatellitePassPredictor::bisect(const Function &f, double t0, double t1, double level) const
+{
+    const bool above0 = f(t0) > level;
+
+    while (t1 - t0 > TIME_RESOLUTION)
+    {
+        const double mid = 0.5 * (t0 + t1);
+        const double value = f(mid);
+        if (std::isnan(value))
+            break;
+        if ((value > level) == above0)
+            t0 = mid;
+        else
+            t1 = mid;
+    }
+
+    return 0.5 * (t0 + t1);
+}
+
+template <typename Function>
+double SatellitePassPredictor::minimize(const Function &f, double t0, double t1) const
+{
+    const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+
+    double a = t1 - ratio * (t1 - t0);
+    double b = t0 + ratio * (t1 - t0);
+    double fa = f(a), fb = f(b);
+
+    while (t1 - t0 > TIME_RESOLUTION)
+    {
+        if (fa < fb)
+        {
+            t1 = b;
+            b  = a;
+            fb = fa;
+            a  = t1 - ratio * (t1 - t0);
+            fa = f(a);
+        }
+        else
+        {
+            t0 = a;
+            a  = b;
+            fa = fb;
+            b  = t0 + ratio * (t1 - t0);
+            fb = f(b);
+        }
+    }
+
+    return 0.5 * (t0 + t1);
+}
+
+QVector<Satellite::Environment> SatellitePassPredictor::coarseGrid(double startJD, double stopJD) const
+{
+    QVector<Satellite::Environment> grid;
+
+    const double step = m_CoarseStep / SECONDS_PER_DAY;
+    const int count = static_cast<int>(std::ceil((stopJD - startJD) / step)) + 1;
+
+    grid.reserve(count);
+    for (int i = 0; i < count; i++)
+        grid.append(Satellite::environment(std::min(startJD + i * step, stopJD), m_Geo));
+
+    return grid;
+}
+
+QVector<SatellitePassPredictor::Pass> SatellitePassPredictor::passesOf(Satellite *sat,
+        const QVector<Satellite::Environment> &grid, double minAltitude) const
+{
+    QVector<Pass> passes;
+    Pass pass;
+    bool inPass = false;
+
+    auto negAltitude = [&](double jd)
+    {
+        return -altitudeAt(sat, jd);
+    };
+    auto altitude = [&](double jd)
+    {
+        return altitudeAt(sat, jd);
+    };
+
+    auto closePass = [&](double setJD)
+    {
+        pass.setJD         = setJD;
+        pass.culminationJD = minimize(negAltitude, pass.riseJD, pass.setJD);
+        pass.maxAltitude   = altitudeAt(sat, pass.culminationJD);
+        pass.visible       = pass.visible || sat->isVisible();
+        passes.append(pass);
+        inPass = false;
+    };
+
+    for (int k = 0; k < grid.size(); k++)
+    {
+        // Decayed or invalid elements, nothing more to predict
+        if (sat->updatePos(grid[k]) != 0)
+            break;
+
+        const bool above = sat->alt().Degrees() > minAltitude;
+
+        if (above && !inPass)
+        {
+            pass         = Pass();
+            pass.name    = sat->name();
+            pass.riseJD  = (k == 0) ? grid[k].jd : bisect(altitude, grid[k - 1].jd, grid[k].jd, minAltitude);
+            inPass       = true;
+            // Bisection moved the satellite, bring it back to the grid instant
+            sat->updatePos(grid[k]);
+        }
+        else if (!above && inPass)
+        {
+            closePass(bisect(altitude, grid[k - 1].jd, grid[k].jd, minAltitude));
+            continue;
+        }
+
+        if (inPass && sat->isVisible())
+            pass.visible = true;
+    }
+
+    if (inPass)
+        closePass(grid.last().jd);
+
+    return passes;
+}
+
+QVector<SatellitePassPredictor::Crossing> SatellitePassPredictor::crossingsOf(Satellite *sat,
+        const QVector<Satellite::Environment> &grid, const SkyPoint &target, double radius) const
+{
+    QVector<Crossing> crossings;
+
+    auto separation = [&](double jd)
+    {
+        return separationAt(sat, target, jd);
+    };
+
+    // Satellites cannot cross a field that is below the horizon
+    const QVector<Pass> passes = passesOf(sat, grid, 0);
+    const double fineStep = m_FineStep / SECONDS_PER_DAY;
+
+    for (const auto &pass : passes)
+    {
+        double prevJD = pass.riseJD, prevSep = separation(prevJD);
+        // The rise is a candidate minimum, the satellite may already be in the field when it rises
+        bool decreasing = true;
+
+        for (double jd = pass.riseJD + fineStep; ; jd += fineStep)
+        {
+            jd = std::min(jd, pass.setJD);
+            const double sep = separation(jd);
+            if (std::isnan(sep))
+                break;
+
+            // Closest approach is behind us, or at the end of the pass
+            const bool atEnd = jd >= pass.setJD;
+            if ((decreasing && sep > prevSep) || (atEnd && sep <= prevSep))
+            {
+                const double lo = std::max(pass.riseJD, prevJD - fineStep);
+                const double closestJD = sep > prevSep ? minimize(separation, lo, jd) : jd;
+                const double closestSep = separation(closestJD);
+
+                if (closestSep < radius)
+                {
+                    Crossing crossing;
+                    crossing.name       = sat->name();
+                    crossing.closestJD  = closestJD;
+                    crossing.separation = closestSep;
+                    crossing.visible    = sat->isVisible();
+
+                    // Walk out of the field on both sides, then refine the boundaries
+                    double t = closestJD;
+                    while (t > pass.riseJD && separation(t) < radius)
+                        t = std::max(pass.riseJD, t - fineStep);
+                    crossing.ingressJD = separation(t) < radius ? t : bisect(separation, t, t + fineStep, radius);
+
+                    t = closestJD;
+                    while (t < pass.setJD && separation(t) < radius)
+                        t = std::min(pass.setJD, t + fineStep);
+                    crossing.egressJD = separation(t) < radius ? t : bisect(separation, t - fineStep, t, radius);
+
+                    crossings.append(crossing);
+                }
+            }
+
+            if (atEnd)
+                break;
+
+            decreasing = sep < prevSep;
+            prevSep    = sep;
+            prevJD     = jd;
+        }
+    }
+
+    return crossings;
+}
+
+QVector<SatellitePassPredictor::Pass> SatellitePassPredictor::findPasses(double startJD, double stopJD,
+        double minAltitude)
+{
+    if (stopJD <= startJD || m_Satellites.empty())
+        return QVector<Pass>();
+
+    const QVector<Satellite::Environment> grid = coarseGrid(startJD, stopJD);
+
+    // Each task only touches its own satellite clone and result slot
+    QVector<QVector<Pass>> results(count());
+    QVector<int> indexes(count());
+    std::iota(indexes.begin(), indexes.end(), 0);
+
+    QVector<Pass> *out = results.data();
+    QtConcurrent::blockingMap(indexes, [this, out, &grid, minAltitude](int i)
+    {
+        out[i] = passesOf(m_Satellites[i].get(), grid, minAltitude);
+    });
+
+    QVector<Pass> passes;
+    for (const auto &some : results)
+        passes += some;
+
+    std::sort(passes.begin(), passes.end(), [](const Pass & a, const Pass & b)
+    {
+        return a.riseJD < b.riseJD;
+    });
+
+    return passes;
+}
+
+QVector<SatellitePassPredictor::Crossing> SatellitePassPredictor::findCrossings(const SkyPoint &target, double radius,
+        double startJD, double stopJD)
+{
+    if (stopJD <= startJD || m_Satellites.empty())
+        return QVector<Crossing>();
+
+    // Satellite coordinates are topocentric coordinates of date
+    SkyPoint center = target;
+    center.apparentCoord(static_cast<long double>(J2000), static_cast<long double>(startJD));
+
+    const QVector<Satellite::Environment> grid = coarseGrid(startJD, stopJD);
+
+    QVector<QVector<Crossing>> results(count());
+    QVector<int> indexes(count());
+    std::iota(indexes.begin(), indexes.end(), 0);
+
+    QVector<Crossing> *out = results.data();
+    QtConcurrent::blockingMap(indexes, [this, out, &grid, &center, radius](int i)
+    {
+        out[i] = crossingsOf(m_Satellites[i].get(), grid, center, radius);
+    });
+
+    QVector<Crossing> crossings;
+    for (const auto &some : results)
+        crossings += some;
+
+    std::sort(crossings.begin(), crossings.end(), [](const Crossing & a, const Crossing & b)
+    {
+        return a.ingressJD < b.ingressJD;
+    });
+
+    return crossings;
+}
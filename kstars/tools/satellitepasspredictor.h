@@ -0,0 +1,136 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "skyobjects/satellite.h"
+#include "skyobjects/skypoint.h"
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+class GeoLocation;
+
+/**
+ * @class SatellitePassPredictor
+ * @short Predicts satellite passes and field of view crossings over a range of time.
+ *
+ * The predictor works on private clones of the satellites, so it can run off the GUI
+ * thread without disturbing the satellites drawn on the sky map. Each satellite is first
+ * stepped through the range on a coarse grid, sharing the Satellite::Environment terms of
+ * each grid instant. Rise and set times are then refined by bisection and the culmination
+ * by golden section search. Field of view crossings are searched with a finer step inside
+ * each pass only, and refined the same way.
+ *
+ * Satellites are processed concurrently on the global thread pool. A predictor instance
+ * must not be used from several threads at the same time.
+ *
+ * All times are Julian days (UTC). All angles are in degrees.
+ */
+class SatellitePassPredictor
+{
+    public:
+        /** A pass of a satellite above the minimum altitude */
+        struct Pass
+        {
+            QString name;
+            double riseJD { 0 };
+            double culminationJD { 0 };
+            double setJD { 0 };
+            /// Altitude at culmination
+            double maxAltitude { 0 };
+            /// True if the satellite is sunlit against a dark sky during the pass
+            bool visible { false };
+        };
+
+        /** A crossing of a circular field of view by a satellite */
+        struct Crossing
+        {
+            QString name;
+            double ingressJD { 0 };
+            double closestJD { 0 };
+            double egressJD { 0 };
+            /// Smallest separation from the field center
+            double separation { 0 };
+            /// True if the satellite is sunlit against a dark sky during the crossing
+            bool visible { false };
+        };
+
+        /**
+         * @param geo observer location, the current KStars location if null
+         */
+        explicit SatellitePassPredictor(GeoLocation *geo = nullptr);
+        ~SatellitePassPredictor();
+
+        /** @short Set the satellites to predict for. They are cloned, the originals are not modified. */
+        void setSatellites(const QList<Satellite *> &satellites);
+
+        /** @return the satellites currently selected for display on the sky map */
+        static QList<Satellite *> selectedSatellites();
+
+        /** @return number of satellites the predictor works on */
+        int count() const
+        {
+            return static_cast<int>(m_Satellites.size());
+        }
+
+        /** @short Set the step of the coarse search grid in seconds. Passes shorter than this may be missed. */
+        void setCoarseStep(double seconds)
+        {
+            m_CoarseStep = seconds;
+        }
+
+        /** @short Set the step used to search for crossings inside a pass, in seconds. */
+        void setFineStep(double seconds)
+        {
+            m_FineStep = seconds;
+        }
+
+        /**
+         * @short Find all passes above @p minAltitude between @p startJD and @p stopJD.
+         * Passes in progress at the range boundaries are clipped to the range.
+         * @return passes of all satellites, sorted by rise time
+         */
+        QVector<Pass> findPasses(double startJD, double stopJD, double minAltitude = 0);
+
+        /**
+         * @short Find all crossings of the circular field of radius @p radius centered on @p target.
+         * @param target field center, J2000 coordinates
+         * @return crossings of all satellites, sorted by ingress time
+         */
+        QVector<Crossing> findCrossings(const SkyPoint &target, double radius, double startJD, double stopJD);
+
+    private:
+        /** @return the altitude of @p sat at @p jd, or NaN if it cannot be propagated */
+        double altitudeAt(Satellite *sat, double jd) const;
+
+        /** @return the separation between @p sat and @p target at @p jd, or NaN if it cannot be propagated */
+        double separationAt(Satellite *sat, const SkyPoint &target, double jd) const;
+
+        /** @short Bisect the time in [t0, t1] where @p f crosses @p level, f(t0) and f(t1) being on either side */
+        template <typename Function>
+        double bisect(const Function &f, double t0, double t1, double level) const;
+
+        /** @short Golden section search of the minimum of @p f in [t0, t1] */
+        template <typename Function>
+        double minimize(const Function &f, double t0, double t1) const;
+
+        /** @short Coarse grid of shared environments between @p startJD and @p stopJD */
+        QVector<Satellite::Environment> coarseGrid(double startJD, double stopJD) const;
+
+        QVector<Pass> passesOf(Satellite *sat, const QVector<Satellite::Environment> &grid, double minAltitude) const;
+        QVector<Crossing> crossingsOf(Satellite *sat, const QVector<Satellite::Environment> &grid,
+                                      const SkyPoint &target, double radius) const;
+
+        std::vector<std::unique_ptr<Satellite>> m_Satellites;
+        GeoLocation *m_Geo { nullptr };
+        double m_CoarseStep { 30 };
+        double m_FineStep { 1 };
+};
@@ -233,14 +233,14 @@ void WUTDialog::init()
         WUT->MoonSetLabel->setText(
             i18n("Moon sets at: %1 on %2", sSet,
                  QLocale().toString(Tomorrow.date(), QLocale::LongFormat)));
-    oMoon->findPhase(nullptr);
+    oMoon->findPhase();
     WUT->MoonIllumLabel->setText(oMoon->phaseName() +
                                  QString(" (%1%)").arg(int(100.0 * oMoon->illum())));
 
     //Restore Sun's and Moon's coordinates, and recompute Moon's original Phase
     oMoon->updateCoords(oldNum, true, geo->lat(), data->lst(), true);
     oSun->updateCoords(oldNum, true, geo->lat(), data->lst(), true);
-    oMoon->findPhase(nullptr);
+    oMoon->findPhase();
 
     if (WUT->CategoryListWidget->currentItem())
         slotLoadList(WUT->CategoryListWidget->currentItem()->text());